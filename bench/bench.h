@@ -0,0 +1,90 @@
+#ifndef __SOLC_BENCH_H__
+#define __SOLC_BENCH_H__
+
+#include "solc/defs.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Keeps the compiler from dropping a benchmarked result.
+#define BENCH_KEEP(_x) __asm__ volatile("" : : "g"(_x) : "memory")
+
+static inline u64 bench_now_ns(void)
+{
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+// Deterministic keys that do not depend on libc's `rand()'.
+static inline u64 bench_rand(u64 *state)
+{
+  u64 x = (*state += 0x9e3779b97f4a7c15ULL);
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// With `--json', e.g. `meson test --benchmark --test-args=--json', results
+// are printed as one JSON object per line instead of a table, tagged with the
+// title of the last header.
+static b8 bench_json = false;
+static const char *bench_title = "";
+
+static inline void bench_init(s32 argc, char **argv)
+{
+  for (s32 i = 1; i < argc; i++)
+    if (strcmp(argv[i], "--json") == 0)
+      bench_json = true;
+}
+
+static inline void bench_json_string(const char *str)
+{
+  putchar('"');
+  for (; *str != '\0'; str++) {
+    if (*str == '"' || *str == '\\')
+      putchar('\\');
+    putchar(*str);
+  }
+  putchar('"');
+}
+
+static inline void bench_json_begin(const char *name)
+{
+  printf("{\"suite\": ");
+  bench_json_string(bench_title);
+  printf(", \"name\": ");
+  bench_json_string(name);
+}
+
+static inline void bench_header(const char *title)
+{
+  bench_title = title;
+  if (!bench_json)
+    printf("%-40s %12s %12s %12s\n", title, "n", "ns/op", "Mops/s");
+}
+
+static inline void bench_report(const char *name, sz n, u64 elapsed_ns)
+{
+  const f64 ns_per_op = (f64)elapsed_ns / (f64)n;
+  if (bench_json) {
+    bench_json_begin(name);
+    printf(", \"n\": %zu, \"ns_per_op\": %.3f, \"mops_per_s\": %.3f}\n", n,
+           ns_per_op, 1000.0 / ns_per_op);
+  } else {
+    printf("%-40s %12zu %12.2f %12.2f\n", name, n, ns_per_op,
+           1000.0 / ns_per_op);
+  }
+}
+
+static inline void bench_report_bytes(const char *name, sz bytes)
+{
+  if (bench_json) {
+    bench_json_begin(name);
+    printf(", \"bytes\": %zu}\n", bytes);
+  } else {
+    printf("%-40s %12zu bytes\n", name, bytes);
+  }
+}
+
+#endif // __SOLC_BENCH_H__
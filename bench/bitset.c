@@ -0,0 +1,94 @@
+#include "bench.h"
+#include "containers/bitset.h"
+#include <stdlib.h>
+
+// Dataflow sets over a function's variables or blocks, next to the same sets
+// kept as one `b8' per element.
+#define SET_OPS (1 << 24)
+
+static void bench_bitset(sz bits_num)
+{
+  alloc_arena_t arena = alloc_arena_create();
+  bitset_t a = bitset_create(&arena, bits_num);
+  bitset_t b = bitset_create(&arena, bits_num);
+  u64 state = bits_num;
+  for (sz i = 0; i < bits_num / 4; i++) {
+    bitset_set(&a, bench_rand(&state) % bits_num);
+    bitset_set(&b, bench_rand(&state) % bits_num);
+  }
+
+  const sz rounds = SET_OPS / bits_num;
+  char name[64];
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < rounds; i++) {
+    BENCH_KEEP(bitset_union(&a, &b));
+    BENCH_KEEP(bitset_difference(&a, &b));
+  }
+  snprintf(name, sizeof(name), "bitset union+difference %zu", bits_num);
+  bench_report(name, rounds, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < rounds; i++)
+    BENCH_KEEP(bitset_count(&a));
+  snprintf(name, sizeof(name), "bitset count %zu", bits_num);
+  bench_report(name, rounds, bench_now_ns() - start);
+
+  alloc_arena_destroy(&arena);
+}
+
+static void bench_bools(sz bits_num)
+{
+  b8 *a = calloc(bits_num, sizeof(b8));
+  b8 *b = calloc(bits_num, sizeof(b8));
+  u64 state = bits_num;
+  for (sz i = 0; i < bits_num / 4; i++) {
+    a[bench_rand(&state) % bits_num] = true;
+    b[bench_rand(&state) % bits_num] = true;
+  }
+
+  const sz rounds = SET_OPS / bits_num;
+  char name[64];
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < rounds; i++) {
+    b8 changed = false;
+    for (sz j = 0; j < bits_num; j++) {
+      changed |= !a[j] && b[j];
+      a[j] |= b[j];
+    }
+    for (sz j = 0; j < bits_num; j++) {
+      changed |= a[j] && b[j];
+      a[j] &= !b[j];
+    }
+    BENCH_KEEP(changed);
+  }
+  snprintf(name, sizeof(name), "b8 array union+difference %zu", bits_num);
+  bench_report(name, rounds, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < rounds; i++) {
+    sz count = 0;
+    for (sz j = 0; j < bits_num; j++)
+      count += a[j];
+    BENCH_KEEP(count);
+  }
+  snprintf(name, sizeof(name), "b8 array count %zu", bits_num);
+  bench_report(name, rounds, bench_now_ns() - start);
+
+  free(b);
+  free(a);
+}
+
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+  static const sz sizes[] = { 256, 4096, 65536 };
+
+  bench_header("bitsets");
+  for (sz i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    bench_bitset(sizes[i]);
+    bench_bools(sizes[i]);
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include "bench.h"
+#include "containers/concurrent_map.h"
+#include "containers/hashtable.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Threads intern identifiers drawn from a shared pool, half of which are
+// already in the map, so most operations are hits and the rest race to insert
+// the same keys. The total work is the same for every thread count.
+#define POOL_SIZE (1 << 16)
+#define TOTAL_OPS (1 << 22)
+#define MAX_THREADS 64
+#define ID_LEN 16
+
+typedef struct {
+  const char *ids;
+  concurrent_map_t *map;
+  // The baseline: one table behind one lock.
+  hashtable_t *table;
+  pthread_mutex_t *table_lock;
+  sz ops;
+  u64 seed;
+} worker_t;
+
+static void *run_striped(void *arg)
+{
+  worker_t *worker = arg;
+  u64 state = worker->seed;
+  for (sz i = 0; i < worker->ops; i++) {
+    const char *id = &worker->ids[(bench_rand(&state) % POOL_SIZE) * ID_LEN];
+    u32 value = (u32)i;
+    BENCH_KEEP(concurrent_map_get_or_insert(worker->map, id, value, nullptr));
+  }
+  return nullptr;
+}
+
+static void *run_global_lock(void *arg)
+{
+  worker_t *worker = arg;
+  u64 state = worker->seed;
+  for (sz i = 0; i < worker->ops; i++) {
+    const char *id = &worker->ids[(bench_rand(&state) % POOL_SIZE) * ID_LEN];
+    u32 value = (u32)i;
+    pthread_mutex_lock(worker->table_lock);
+    const void *found = hashtable_get(worker->table, id);
+    if (found == nullptr)
+      hashtable_put(worker->table, id, value);
+    pthread_mutex_unlock(worker->table_lock);
+    BENCH_KEEP(found);
+  }
+  return nullptr;
+}
+
+static void bench_threads(const char *ids, sz threads_num, b8 striped)
+{
+  concurrent_map_t *map = nullptr;
+  hashtable_t *table = nullptr;
+  pthread_mutex_t table_lock = PTHREAD_MUTEX_INITIALIZER;
+  if (striped) {
+    concurrent_map_create(map, const char *, u32);
+  } else {
+    hashtable_create(table, const char *, u32);
+  }
+
+  for (sz i = 0; i < POOL_SIZE; i += 2) {
+    const char *id = &ids[i * ID_LEN];
+    u32 value = (u32)i;
+    if (striped) {
+      concurrent_map_get_or_insert(map, id, value, nullptr);
+    } else {
+      hashtable_put(table, id, value);
+    }
+  }
+
+  pthread_t threads[MAX_THREADS];
+  worker_t workers[MAX_THREADS];
+  const u64 start = bench_now_ns();
+  for (sz i = 0; i < threads_num; i++) {
+    workers[i] = (worker_t){
+      .ids = ids,
+      .map = map,
+      .table = table,
+      .table_lock = &table_lock,
+      .ops = TOTAL_OPS / threads_num,
+      .seed = i,
+    };
+    pthread_create(&threads[i], nullptr,
+                   striped ? run_striped : run_global_lock, &workers[i]);
+  }
+  for (sz i = 0; i < threads_num; i++)
+    pthread_join(threads[i], nullptr);
+  const u64 elapsed = bench_now_ns() - start;
+
+  char name[64];
+  snprintf(name, sizeof(name), "%s threads=%zu",
+           striped ? "concurrent_map" : "hashtable+mutex", threads_num);
+  bench_report(name, TOTAL_OPS / threads_num * threads_num, elapsed);
+
+  if (striped)
+    concurrent_map_destroy(map);
+  else
+    hashtable_destroy(table);
+}
+
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+  char *ids = malloc(POOL_SIZE * ID_LEN);
+  u64 state = 0;
+  for (sz i = 0; i < POOL_SIZE; i++)
+    snprintf(&ids[i * ID_LEN], ID_LEN, "id_%012llx",
+             (unsigned long long)(bench_rand(&state) & 0xFFFFFFFFFFFFULL));
+
+  bench_header("concurrent_map get_or_insert");
+  for (sz threads_num = 1; threads_num <= MAX_THREADS; threads_num *= 2) {
+    bench_threads(ids, threads_num, true);
+    bench_threads(ids, threads_num, false);
+  }
+
+  free(ids);
+  return 0;
+}
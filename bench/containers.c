@@ -0,0 +1,510 @@
+#include "bench.h"
+#include "allocs/alloc_arena.h"
+#include "containers/hashset.h"
+#include "containers/hashtable.h"
+#include "containers/string.h"
+#include "containers/trie.h"
+#include "containers/vector.h"
+#include "solc/init.h"
+#include "solc/lexer/lexer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Every container runs at sizes from `MIN_SIZE' up to `--max-size', ten times
+// apart. Small sizes are repeated until they add up to `MIN_OPS' operations so
+// each result is timed over a comparable span. String keys stop at
+// `MAX_STRING_SIZE', past it the key copies alone need gigabytes.
+#define MIN_SIZE 10
+#define DEFAULT_MAX_SIZE 10000000
+#define MAX_STRING_SIZE 1000000
+#define MIN_OPS (1 << 20)
+#define ID_LEN 16
+
+typedef struct {
+  // Identifier tokens of the corpora in source order, and their distinct
+  // spellings.
+  char **tokens;
+  sz tokens_num;
+  char **names;
+  sz names_num;
+} corpus_t;
+
+static sz rounds_for(sz n)
+{
+  return SOLC_MAX(MIN_OPS / n, (sz)1);
+}
+
+static void report(const char *what, sz n, sz ops, u64 elapsed_ns)
+{
+  char name[64];
+  snprintf(name, sizeof(name), "%s n=%zu", what, n);
+  bench_report(name, ops, elapsed_ns);
+}
+
+static char *make_ids(const u64 *keys, sz n)
+{
+  char *ids = malloc(n * ID_LEN);
+  for (sz i = 0; i < n; i++)
+    snprintf(&ids[i * ID_LEN], ID_LEN, "id_%012llx",
+             (unsigned long long)(keys[i] & 0xFFFFFFFFFFFFULL));
+  return ids;
+}
+
+static void bench_vector(sz n)
+{
+  const sz rounds = rounds_for(n);
+  u64 push_ns = 0, iterate_ns = 0, resize_ns = 0, churn_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    u64 *v = vector_create(u64);
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      vector_push(v, i);
+    push_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    u64 sum = 0;
+    for (sz i = 0; i < vector_get_length(v); i++)
+      sum += v[i];
+    BENCH_KEEP(sum);
+    iterate_ns += bench_now_ns() - start;
+
+    // Pops and pushes back the tail, the way a work list is used.
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      u64 last;
+      vector_pop(v, &last);
+      vector_push(v, last + 1);
+    }
+    churn_ns += bench_now_ns() - start;
+    vector_destroy(v);
+
+    v = vector_create(u64);
+    start = bench_now_ns();
+    vector_resize(v, n);
+    resize_ns += bench_now_ns() - start;
+    vector_destroy(v);
+  }
+  report("vector u64 push", n, n * rounds, push_ns);
+  report("vector u64 iterate", n, n * rounds, iterate_ns);
+  report("vector u64 pop+push", n, n * rounds, churn_ns);
+  report("vector u64 resize", n, n * rounds, resize_ns);
+}
+
+static void bench_string(sz n)
+{
+  const sz rounds = rounds_for(n);
+  u64 append_ns = 0, reserved_ns = 0, iterate_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    string_t str = string_create();
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      string_append_char(&str, (char)('a' + i % 26));
+    append_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    sz sum = 0;
+    for (sz i = 0; i < n; i++)
+      sum += (sz)string_at(&str, i);
+    BENCH_KEEP(sum);
+    iterate_ns += bench_now_ns() - start;
+    string_destroy(&str);
+
+    str = string_create();
+    start = bench_now_ns();
+    string_reserve(&str, n);
+    for (sz i = 0; i < n; i++)
+      string_append_char(&str, (char)('a' + i % 26));
+    reserved_ns += bench_now_ns() - start;
+    string_destroy(&str);
+  }
+  report("string append_char", n, n * rounds, append_ns);
+  report("string append_char reserved", n, n * rounds, reserved_ns);
+  report("string at", n, n * rounds, iterate_ns);
+}
+
+static void bench_hashtable_u64(const u64 *keys, const u64 *missing, sz n)
+{
+  const sz rounds = rounds_for(n);
+  u64 insert_ns = 0, reserved_ns = 0, hit_ns = 0, miss_ns = 0, churn_ns = 0,
+      iterate_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    hashtable_t *table;
+    hashtable_create(table, u64, u64);
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      hashtable_put(table, keys[i], i);
+    insert_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(hashtable_get(table, keys[i]));
+    hit_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(hashtable_get(table, missing[i]));
+    miss_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    hashtable_cursor_t cursor = hashtable_cursor_create(table);
+    u64 sum = 0;
+    while (hashtable_cursor_next(&cursor))
+      sum += *(const u64 *)cursor.value;
+    BENCH_KEEP(sum);
+    iterate_ns += bench_now_ns() - start;
+
+    // Every key is removed and one that was missing takes its place.
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      hashtable_remove(table, keys[i]);
+      hashtable_put(table, missing[i], i);
+    }
+    churn_ns += bench_now_ns() - start;
+    hashtable_destroy(table);
+
+    hashtable_create(table, u64, u64);
+    start = bench_now_ns();
+    hashtable_reserve(table, n);
+    for (sz i = 0; i < n; i++)
+      hashtable_put(table, keys[i], i);
+    reserved_ns += bench_now_ns() - start;
+    hashtable_destroy(table);
+  }
+  report("hashtable u64 insert", n, n * rounds, insert_ns);
+  report("hashtable u64 insert reserved", n, n * rounds, reserved_ns);
+  report("hashtable u64 hit", n, n * rounds, hit_ns);
+  report("hashtable u64 miss", n, n * rounds, miss_ns);
+  report("hashtable u64 iterate", n, n * rounds, iterate_ns);
+  report("hashtable u64 remove+insert", n, n * rounds, churn_ns);
+}
+
+static void bench_hashset_u64(const u64 *keys, const u64 *missing, sz n)
+{
+  const sz rounds = rounds_for(n);
+  u64 insert_ns = 0, hit_ns = 0, miss_ns = 0, churn_ns = 0, iterate_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    hashset_t *set;
+    hashset_create(set, u64);
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      hashset_set(set, keys[i]);
+    insert_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(hashset_is_set(set, keys[i]));
+    hit_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(hashset_is_set(set, missing[i]));
+    miss_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    hashset_cursor_t cursor = hashset_cursor_create(set);
+    u64 sum = 0;
+    while (hashset_cursor_next(&cursor))
+      sum += *(const u64 *)cursor.key;
+    BENCH_KEEP(sum);
+    iterate_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      hashset_unset(set, keys[i]);
+      hashset_set(set, missing[i]);
+    }
+    churn_ns += bench_now_ns() - start;
+    hashset_destroy(set);
+  }
+  report("hashset u64 insert", n, n * rounds, insert_ns);
+  report("hashset u64 hit", n, n * rounds, hit_ns);
+  report("hashset u64 miss", n, n * rounds, miss_ns);
+  report("hashset u64 iterate", n, n * rounds, iterate_ns);
+  report("hashset u64 remove+insert", n, n * rounds, churn_ns);
+}
+
+static void bench_hashtable_cstr(const char *ids, const char *missing_ids,
+                                 sz n)
+{
+  const sz rounds = rounds_for(n);
+  u64 insert_ns = 0, hit_ns = 0, miss_ns = 0, churn_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    hashtable_t *table;
+    hashtable_create(table, const char *, u64);
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      const char *id = &ids[i * ID_LEN];
+      hashtable_put(table, id, i);
+    }
+    insert_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      const char *id = &ids[i * ID_LEN];
+      BENCH_KEEP(hashtable_get(table, id));
+    }
+    hit_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      const char *id = &missing_ids[i * ID_LEN];
+      BENCH_KEEP(hashtable_get(table, id));
+    }
+    miss_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++) {
+      const char *id = &ids[i * ID_LEN];
+      const char *missing_id = &missing_ids[i * ID_LEN];
+      hashtable_remove(table, id);
+      hashtable_put(table, missing_id, i);
+    }
+    churn_ns += bench_now_ns() - start;
+    hashtable_destroy(table);
+  }
+  report("hashtable cstr insert", n, n * rounds, insert_ns);
+  report("hashtable cstr hit", n, n * rounds, hit_ns);
+  report("hashtable cstr miss", n, n * rounds, miss_ns);
+  report("hashtable cstr remove+insert", n, n * rounds, churn_ns);
+}
+
+// Tries have no destroy, their nodes go with the global arena, so every
+// round gets a fresh one.
+static void bench_trie(const char *ids, const char *missing_ids, sz n)
+{
+  const sz rounds = rounds_for(n);
+  u64 insert_ns = 0, hit_ns = 0, miss_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    solc_init();
+    trie_t *trie = trie_create();
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      trie_insert(trie, &ids[i * ID_LEN], (void *)(i + 1));
+    insert_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(trie_get(trie, &ids[i * ID_LEN]));
+    hit_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(trie_get(trie, &missing_ids[i * ID_LEN]));
+    miss_ns += bench_now_ns() - start;
+    solc_deinit();
+  }
+  report("trie cstr insert", n, n * rounds, insert_ns);
+  report("trie cstr hit", n, n * rounds, hit_ns);
+  report("trie cstr miss", n, n * rounds, miss_ns);
+}
+
+// Node-sized allocations of 8 to 64 bytes, then a clear for the next round.
+static void bench_arena(sz n, alloc_arena_backend_t backend)
+{
+  const sz rounds = rounds_for(n);
+  alloc_arena_t arena = alloc_arena_create_with_policy(
+    (alloc_arena_policy_t){ .backend = backend });
+  u64 state = n;
+  u64 allocate_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    const u64 start = bench_now_ns();
+    for (sz i = 0; i < n; i++)
+      BENCH_KEEP(alloc_arena_allocate(&arena, 8 + bench_rand(&state) % 57));
+    allocate_ns += bench_now_ns() - start;
+    alloc_arena_clear(&arena);
+  }
+  alloc_arena_destroy(&arena);
+  report(backend == ALLOC_ARENA_BACKEND_VM ? "alloc_arena vm allocate" :
+                                             "alloc_arena heap allocate",
+         n, n * rounds, allocate_ns);
+}
+
+static char *read_file(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (f == nullptr)
+    return nullptr;
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  char *src = malloc((sz)size + 1);
+  src[fread(src, 1, (sz)size, f)] = '\0';
+  fclose(f);
+  return src;
+}
+
+// Identifiers as the lexer sees them, repeats included, so lookups follow
+// the distribution of real code.
+static corpus_t corpus_load(char **paths, sz paths_num)
+{
+  hashset_t *seen;
+  hashset_create(seen, const char *);
+  char **tokens = vector_create(char *);
+  char **names = vector_create(char *);
+
+  solc_init();
+  for (sz i = 0; i < paths_num; i++) {
+    char *src = read_file(paths[i]);
+    if (src == nullptr) {
+      fprintf(stderr, "cannot read `%s'\n", paths[i]);
+      continue;
+    }
+
+    solc_lexer_t *lexer = solc_lexer_create(src);
+    sz tokens_num;
+    solc_token_t *lexed = solc_lexer_tokenize(lexer, &tokens_num);
+    for (sz j = 0; j < tokens_num; j++) {
+      if (lexed[j].type != SOLC_TOKENTYPE_ID)
+        continue;
+
+      char *token = malloc(lexed[j].len + 1);
+      memcpy(token, lexed[j].value, lexed[j].len);
+      token[lexed[j].len] = '\0';
+      vector_push(tokens, token);
+      if (!hashset_is_set(seen, token)) {
+        hashset_set(seen, token);
+        vector_push(names, token);
+      }
+    }
+    solc_lexer_destroy(lexer);
+    free(src);
+  }
+  solc_deinit();
+  hashset_destroy(seen);
+
+  return (corpus_t){
+    .tokens = tokens,
+    .tokens_num = vector_get_length(tokens),
+    .names = names,
+    .names_num = vector_get_length(names),
+  };
+}
+
+static void corpus_destroy(corpus_t *corpus)
+{
+  for (sz i = 0; i < corpus->tokens_num; i++)
+    free(corpus->tokens[i]);
+  vector_destroy(corpus->names);
+  vector_destroy(corpus->tokens);
+}
+
+// Declares every distinct name once, then resolves each use in source order.
+// Misses are the same uses with a suffix no name in the corpus has.
+static void bench_corpus(const corpus_t *corpus)
+{
+  const sz rounds = SOLC_MAX(MIN_OPS / corpus->tokens_num, (sz)1);
+  char **missing = malloc(corpus->tokens_num * sizeof(char *));
+  for (sz i = 0; i < corpus->tokens_num; i++) {
+    const sz len = strlen(corpus->tokens[i]);
+    missing[i] = malloc(len + 3);
+    memcpy(missing[i], corpus->tokens[i], len);
+    memcpy(missing[i] + len, "'0", 3);
+  }
+
+  u64 insert_ns = 0, hit_ns = 0, miss_ns = 0, string_ns = 0;
+  for (sz round = 0; round < rounds; round++) {
+    hashtable_t *table;
+    hashtable_create(table, const char *, u64);
+    u64 start = bench_now_ns();
+    for (sz i = 0; i < corpus->names_num; i++) {
+      const char *name = corpus->names[i];
+      hashtable_put(table, name, i);
+    }
+    insert_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < corpus->tokens_num; i++) {
+      const char *token = corpus->tokens[i];
+      BENCH_KEEP(hashtable_get(table, token));
+    }
+    hit_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (sz i = 0; i < corpus->tokens_num; i++) {
+      const char *token = missing[i];
+      BENCH_KEEP(hashtable_get(table, token));
+    }
+    miss_ns += bench_now_ns() - start;
+    hashtable_destroy(table);
+
+    start = bench_now_ns();
+    for (sz i = 0; i < corpus->tokens_num; i++) {
+      string_t str = string_create_from(corpus->tokens[i]);
+      BENCH_KEEP(string_cstr(&str));
+      string_destroy(&str);
+    }
+    string_ns += bench_now_ns() - start;
+  }
+
+  for (sz i = 0; i < corpus->tokens_num; i++)
+    free(missing[i]);
+  free(missing);
+
+  report("corpus hashtable cstr insert", corpus->names_num,
+         corpus->names_num * rounds, insert_ns);
+  report("corpus hashtable cstr hit", corpus->tokens_num,
+         corpus->tokens_num * rounds, hit_ns);
+  report("corpus hashtable cstr miss", corpus->tokens_num,
+         corpus->tokens_num * rounds, miss_ns);
+  report("corpus string create_from", corpus->tokens_num,
+         corpus->tokens_num * rounds, string_ns);
+}
+
+// bench_containers [--json] [--max-size <n>] [corpus.slr...]
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+
+  sz max_size = DEFAULT_MAX_SIZE;
+  char **paths = malloc((sz)argc * sizeof(char *));
+  sz paths_num = 0;
+  for (s32 i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0)
+      continue;
+    if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc)
+      max_size = strtoull(argv[++i], nullptr, 10);
+    else
+      paths[paths_num++] = argv[i];
+  }
+
+  // Odd keys are inserted and even keys miss.
+  u64 *keys = malloc(max_size * sizeof(u64));
+  u64 *missing = malloc(max_size * sizeof(u64));
+  u64 state = 0;
+  for (sz i = 0; i < max_size; i++) {
+    keys[i] = bench_rand(&state) | 1;
+    missing[i] = bench_rand(&state) & ~1ULL;
+  }
+  const sz max_string_size = SOLC_MIN(max_size, (sz)MAX_STRING_SIZE);
+  char *ids = make_ids(keys, max_string_size);
+  char *missing_ids = make_ids(missing, max_string_size);
+
+  bench_header("containers");
+  for (sz n = MIN_SIZE; n <= max_size; n *= 10) {
+    bench_vector(n);
+    bench_string(n);
+    bench_hashtable_u64(keys, missing, n);
+    bench_hashset_u64(keys, missing, n);
+    if (n <= max_string_size) {
+      bench_hashtable_cstr(ids, missing_ids, n);
+      bench_trie(ids, missing_ids, n);
+    }
+    bench_arena(n, ALLOC_ARENA_BACKEND_HEAP);
+    bench_arena(n, ALLOC_ARENA_BACKEND_VM);
+  }
+
+  if (paths_num != 0) {
+    corpus_t corpus = corpus_load(paths, paths_num);
+    if (corpus.tokens_num != 0)
+      bench_corpus(&corpus);
+    corpus_destroy(&corpus);
+  }
+
+  free(missing_ids);
+  free(ids);
+  free(missing);
+  free(keys);
+  free(paths);
+  return 0;
+}
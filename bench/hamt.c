@@ -0,0 +1,108 @@
+#include "bench.h"
+#include "containers/hamt.h"
+#include "containers/hashtable.h"
+
+// Scopes nest `DEPTH' deep over `GLOBALS' global symbols and each one declares
+// `LOCALS' more. Entering a scope either snapshots the enclosing map or copies
+// the enclosing table.
+#define GLOBALS 1024
+#define DEPTH 32
+#define LOCALS 8
+#define ROUNDS 64
+#define LOOKUP_OPS (1 << 22)
+
+static u64 keys[GLOBALS + DEPTH * LOCALS];
+
+static b8 u64_equals(const void *a, const void *b)
+{
+  return *(const u64 *)a == *(const u64 *)b;
+}
+
+static void copy_entry(const void *key, const void *value, void *ctx)
+{
+  hashtable_t **table = ctx;
+  hashtable_put_raw(*table, key, value);
+}
+
+static void bench_scopes_hamt(void)
+{
+  alloc_arena_t arena = alloc_arena_create();
+  hamt_t globals = hamt_create(&arena, hash_function_i64, u64_equals);
+  for (sz i = 0; i < GLOBALS; i++)
+    hamt_put(&globals, &keys[i], &keys[i]);
+
+  const u64 start = bench_now_ns();
+  for (sz round = 0; round < ROUNDS; round++) {
+    hamt_t scopes[DEPTH + 1];
+    scopes[0] = globals;
+    for (sz depth = 1; depth <= DEPTH; depth++) {
+      scopes[depth] = hamt_snapshot(&scopes[depth - 1]);
+      for (sz i = 0; i < LOCALS; i++) {
+        u64 *key = &keys[GLOBALS + (depth - 1) * LOCALS + i];
+        hamt_put(&scopes[depth], key, key);
+      }
+    }
+    BENCH_KEEP(hamt_get(&scopes[DEPTH], &keys[round]));
+  }
+  bench_report("hamt snapshot per scope", ROUNDS * DEPTH,
+               bench_now_ns() - start);
+
+  u64 state = 0;
+  const u64 lookup_start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hamt_get(&globals, &keys[bench_rand(&state) % GLOBALS]));
+  bench_report("hamt lookup", LOOKUP_OPS, bench_now_ns() - lookup_start);
+
+  alloc_arena_destroy(&arena);
+}
+
+static void bench_scopes_hashtable(void)
+{
+  hashtable_t *globals;
+  hashtable_create(globals, u64, u64 *);
+  for (sz i = 0; i < GLOBALS; i++) {
+    u64 *value = &keys[i];
+    hashtable_put(globals, keys[i], value);
+  }
+
+  const u64 start = bench_now_ns();
+  for (sz round = 0; round < ROUNDS; round++) {
+    hashtable_t *scopes[DEPTH + 1];
+    scopes[0] = globals;
+    for (sz depth = 1; depth <= DEPTH; depth++) {
+      hashtable_create(scopes[depth], u64, u64 *);
+      hashtable_reserve(scopes[depth], GLOBALS + depth * LOCALS);
+      hashtable_foreach_ctx(scopes[depth - 1], copy_entry, &scopes[depth]);
+      for (sz i = 0; i < LOCALS; i++) {
+        u64 *value = &keys[GLOBALS + (depth - 1) * LOCALS + i];
+        hashtable_put(scopes[depth], *value, value);
+      }
+    }
+    BENCH_KEEP(hashtable_get(scopes[DEPTH], keys[round]));
+    for (sz depth = 1; depth <= DEPTH; depth++)
+      hashtable_destroy(scopes[depth]);
+  }
+  bench_report("hashtable copy per scope", ROUNDS * DEPTH,
+               bench_now_ns() - start);
+
+  u64 state = 0;
+  const u64 lookup_start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hashtable_get(globals, keys[bench_rand(&state) % GLOBALS]));
+  bench_report("hashtable lookup", LOOKUP_OPS, bench_now_ns() - lookup_start);
+
+  hashtable_destroy(globals);
+}
+
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+  u64 state = 42;
+  for (sz i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    keys[i] = bench_rand(&state);
+
+  bench_header("scoped symbol tables");
+  bench_scopes_hamt();
+  bench_scopes_hashtable();
+  return 0;
+}
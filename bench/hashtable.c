@@ -0,0 +1,309 @@
+#include "bench.h"
+#include "containers/hashset.h"
+#include "containers/hashtable.h"
+#include "containers/hashtable_typed.h"
+#include <stdio.h>
+#include <string.h>
+
+// Tables are grown to `CAPACITY' slots and filled up to each load factor, the
+// largest one is the point right before they grow again.
+#define CAPACITY (1 << 16)
+#define LOOKUP_OPS (1 << 22)
+#define CHURN_OPS (1 << 22)
+#define ID_LEN 16
+
+static const f64 load_factors[] = { 0.5, 0.625, 0.75, 0.875 };
+
+#define u64_eq(_a, _b) ((_a) == (_b))
+SOLC_DEFINE_HASHTABLE(u64_table, u64, u64, hash_u64, u64_eq)
+SOLC_DEFINE_HASHTABLE(ident_table, string_key_t, u64, string_key_hash,
+                      string_key_equals)
+
+static char *make_ids(const u64 *keys, sz n)
+{
+  char *ids = malloc(n * ID_LEN);
+  for (sz i = 0; i < n; i++)
+    snprintf(&ids[i * ID_LEN], ID_LEN, "id_%012llx",
+             (unsigned long long)(keys[i] & 0xFFFFFFFFFFFFULL));
+  return ids;
+}
+
+static void bench_u64(const u64 *keys, const u64 *missing, sz n, f64 lf)
+{
+  char name[64];
+  hashtable_t *table;
+  hashtable_create(table, u64, u64);
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < n; i++)
+    hashtable_put(table, keys[i], i);
+  snprintf(name, sizeof(name), "hashtable u64 insert lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hashtable_get(table, keys[i % n]));
+  snprintf(name, sizeof(name), "hashtable u64 hit lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hashtable_get(table, missing[i % n]));
+  snprintf(name, sizeof(name), "hashtable u64 miss lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  hashtable_destroy(table);
+}
+
+static void bench_typed(const u64 *keys, const u64 *missing, sz n, f64 lf)
+{
+  char name[64];
+  u64_table_t table = u64_table_create();
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < n; i++)
+    u64_table_put(&table, keys[i], i);
+  snprintf(name, sizeof(name), "typed u64 insert lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(u64_table_get(&table, keys[i % n]));
+  snprintf(name, sizeof(name), "typed u64 hit lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(u64_table_get(&table, missing[i % n]));
+  snprintf(name, sizeof(name), "typed u64 miss lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  u64_table_destroy(&table);
+}
+
+static void bench_cstr(const char *ids, const char *missing_ids, sz n, f64 lf)
+{
+  char name[64];
+  hashtable_t *table;
+  hashtable_create(table, const char *, u64);
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < n; i++) {
+    const char *id = &ids[i * ID_LEN];
+    hashtable_put(table, id, i);
+  }
+  snprintf(name, sizeof(name), "hashtable cstr insert lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++) {
+    const char *id = &ids[(i % n) * ID_LEN];
+    BENCH_KEEP(hashtable_get(table, id));
+  }
+  snprintf(name, sizeof(name), "hashtable cstr hit lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++) {
+    const char *id = &missing_ids[(i % n) * ID_LEN];
+    BENCH_KEEP(hashtable_get(table, id));
+  }
+  snprintf(name, sizeof(name), "hashtable cstr miss lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  hashtable_destroy(table);
+}
+
+// Building and dropping a string table, keys either copied one malloc at a
+// time or into a storage arena.
+static void bench_cstr_storage(const char *ids, sz n, f64 lf)
+{
+  char name[64];
+
+  u64 start = bench_now_ns();
+  hashtable_t *table;
+  hashtable_create(table, const char *, u64);
+  for (sz i = 0; i < n; i++) {
+    const char *id = &ids[i * ID_LEN];
+    hashtable_put(table, id, i);
+  }
+  hashtable_destroy(table);
+  snprintf(name, sizeof(name), "hashtable cstr build heap lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  alloc_arena_t arena = alloc_arena_create();
+  hashtable_create_in_arena(table, const char *, u64, &arena);
+  for (sz i = 0; i < n; i++) {
+    const char *id = &ids[i * ID_LEN];
+    hashtable_put(table, id, i);
+  }
+  hashtable_destroy(table);
+  alloc_arena_destroy(&arena);
+  snprintf(name, sizeof(name), "hashtable cstr build arena lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+}
+
+// Identifiers are hashed once when they are made, like the lexer would.
+static void bench_string_key(const char *ids, const char *missing_ids, sz n,
+                             f64 lf)
+{
+  char name[64];
+  string_key_t *keys = malloc(n * sizeof(string_key_t));
+  string_key_t *missing = malloc(n * sizeof(string_key_t));
+  for (sz i = 0; i < n; i++) {
+    keys[i] = string_key_from_cstr(&ids[i * ID_LEN]);
+    missing[i] = string_key_from_cstr(&missing_ids[i * ID_LEN]);
+  }
+  ident_table_t table = ident_table_create();
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < n; i++)
+    ident_table_put(&table, keys[i], i);
+  snprintf(name, sizeof(name), "typed string_key insert lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(ident_table_get(&table, keys[i % n]));
+  snprintf(name, sizeof(name), "typed string_key hit lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(ident_table_get(&table, missing[i % n]));
+  snprintf(name, sizeof(name), "typed string_key miss lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  ident_table_destroy(&table);
+  free(missing);
+  free(keys);
+}
+
+static void bench_set(const u64 *keys, const u64 *missing, sz n, f64 lf)
+{
+  char name[64];
+  hashset_t *set;
+  hashset_create(set, u64);
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < n; i++)
+    hashset_set(set, keys[i]);
+  snprintf(name, sizeof(name), "hashset u64 insert lf=%.3f", lf);
+  bench_report(name, n, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hashset_is_set(set, keys[i % n]));
+  snprintf(name, sizeof(name), "hashset u64 hit lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hashset_is_set(set, missing[i % n]));
+  snprintf(name, sizeof(name), "hashset u64 miss lf=%.3f", lf);
+  bench_report(name, LOOKUP_OPS, bench_now_ns() - start);
+
+  hashset_destroy(set);
+}
+
+// Builds a table from a known number of entries, growing as it goes versus
+// reserving once and inserting them in bulk.
+static void bench_bulk(const u64 *keys, sz n)
+{
+  u64 *values = malloc(n * sizeof(u64));
+  for (sz i = 0; i < n; i++)
+    values[i] = i;
+
+  hashtable_t *table;
+  hashtable_create(table, u64, u64);
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < n; i++)
+    hashtable_put(table, keys[i], values[i]);
+  bench_report("hashtable u64 build by put", n, bench_now_ns() - start);
+  hashtable_destroy(table);
+
+  hashtable_create(table, u64, u64);
+  start = bench_now_ns();
+  hashtable_insert_many(table, keys, values, n);
+  bench_report("hashtable u64 build by insert_many", n,
+               bench_now_ns() - start);
+
+  // Clearing keeps the capacity, so the second build never grows.
+  hashtable_clear(table);
+  start = bench_now_ns();
+  hashtable_insert_many(table, keys, values, n);
+  bench_report("hashtable u64 rebuild after clear", n, bench_now_ns() - start);
+  hashtable_destroy(table);
+
+  free(values);
+}
+
+// Replaces random keys for a long time, which leaves tombstones all over the
+// table, then looks at how misses fare afterwards.
+static void bench_churn(const u64 *keys, const u64 *missing, sz n)
+{
+  hashtable_t *table;
+  hashtable_create(table, u64, u64);
+  u64 *live = malloc(n * sizeof(u64));
+  for (sz i = 0; i < n; i++) {
+    live[i] = keys[i];
+    hashtable_put(table, live[i], i);
+  }
+
+  u64 state = 42;
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < CHURN_OPS; i++) {
+    const sz victim = bench_rand(&state) % n;
+    hashtable_remove(table, live[victim]);
+    live[victim] = bench_rand(&state) | 1;
+    hashtable_put(table, live[victim], i);
+  }
+  bench_report("hashtable u64 churn remove+insert", CHURN_OPS,
+               bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(hashtable_get(table, missing[i % n]));
+  bench_report("hashtable u64 miss after churn", LOOKUP_OPS,
+               bench_now_ns() - start);
+
+  free(live);
+  hashtable_destroy(table);
+}
+
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+  const sz max_n = (sz)(CAPACITY * load_factors[3]);
+  u64 *keys = malloc(max_n * sizeof(u64));
+  u64 *missing = malloc(max_n * sizeof(u64));
+
+  // Odd keys are inserted and even keys miss.
+  u64 state = 0;
+  for (sz i = 0; i < max_n; i++) {
+    keys[i] = bench_rand(&state) | 1;
+    missing[i] = bench_rand(&state) & ~1ULL;
+  }
+  char *ids = make_ids(keys, max_n);
+  char *missing_ids = make_ids(missing, max_n);
+
+  bench_header("hashtable/hashset");
+  for (sz i = 0; i < sizeof(load_factors) / sizeof(load_factors[0]); i++) {
+    const sz n = (sz)(CAPACITY * load_factors[i]);
+    bench_u64(keys, missing, n, load_factors[i]);
+    bench_typed(keys, missing, n, load_factors[i]);
+    bench_cstr(ids, missing_ids, n, load_factors[i]);
+    bench_string_key(ids, missing_ids, n, load_factors[i]);
+    bench_cstr_storage(ids, n, load_factors[i]);
+    bench_set(keys, missing, n, load_factors[i]);
+  }
+  bench_churn(keys, missing, (sz)(CAPACITY * load_factors[2]));
+  bench_bulk(keys, max_n);
+
+  free(missing_ids);
+  free(ids);
+  free(missing);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,179 @@
+#include "bench.h"
+#include "solc/init.h"
+#include "solc/lexer/lexer.h"
+#include "solc/parser/ast.h"
+#include "solc/parser/parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The generated source is `FUNCS' functions of `STMTS' assignments, each with
+// an expression of about `EXPR_OPERATORS' binary operators over identifiers,
+// numbers, calls, array elements, prefix operators and nested parentheses.
+#define FUNCS 64
+#define STMTS 64
+#define EXPR_OPERATORS 12
+#define MAX_DEPTH 3
+#define MIN_TOKENS (1 << 24)
+#define MAX_THREADS 8
+
+static const char *operands[] = { "a", "bb", "ccc", "42", "0x1F", "1.5" };
+static const char *binary_operators[] = {
+  "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^",
+  "==", "!=", "<", ">", "<=", ">=", "&&", "||",
+};
+static const char *prefix_operators[] = { "!", "~", "-", "*", "&" };
+
+#define PICK(_state, _array) \
+  (_array)[bench_rand(_state) % (sizeof(_array) / sizeof((_array)[0]))]
+
+typedef struct {
+  char *data;
+  sz len;
+  sz capacity;
+} source_t;
+
+static void source_append(source_t *source, const char *str)
+{
+  const sz len = strlen(str);
+  if (source->len + len + 1 > source->capacity) {
+    source->capacity = SOLC_MAX(source->capacity * 2, source->len + len + 1);
+    source->data = realloc(source->data, source->capacity);
+  }
+  memcpy(source->data + source->len, str, len + 1);
+  source->len += len;
+}
+
+static void generate_expr(source_t *source, u64 *state, sz depth,
+                          sz operators_num);
+
+static void generate_operand(source_t *source, u64 *state, sz depth)
+{
+  if (bench_rand(state) % 4 == 0)
+    source_append(source, PICK(state, prefix_operators));
+
+  switch (depth < MAX_DEPTH ? bench_rand(state) % 8 : 0) {
+  case 0:
+  case 1:
+  case 2:
+  case 3:
+    source_append(source, PICK(state, operands));
+    return;
+  case 4:
+    source_append(source, "f(");
+    generate_expr(source, state, depth + 1, 2);
+    source_append(source, ", ");
+    generate_expr(source, state, depth + 1, 1);
+    source_append(source, ")");
+    return;
+  case 5:
+    source_append(source, "arr[");
+    generate_expr(source, state, depth + 1, 1);
+    source_append(source, "]");
+    return;
+  default:
+    source_append(source, "(");
+    generate_expr(source, state, depth + 1, 3);
+    source_append(source, ")");
+    return;
+  }
+}
+
+static void generate_expr(source_t *source, u64 *state, sz depth,
+                          sz operators_num)
+{
+  generate_operand(source, state, depth);
+  for (sz i = 0; i < operators_num; i++) {
+    source_append(source, " ");
+    source_append(source, PICK(state, binary_operators));
+    source_append(source, " ");
+    generate_operand(source, state, depth);
+  }
+}
+
+static char *generate_source(void)
+{
+  source_t source = { 0 };
+  u64 state = 0;
+  for (sz i = 0; i < FUNCS; i++) {
+    char header[64];
+    snprintf(header, sizeof(header), "f%zu :: () -> s32 {\n", i);
+    source_append(&source, header);
+    for (sz j = 0; j < STMTS; j++) {
+      source_append(&source, "  x = ");
+      generate_expr(&source, &state, 0, EXPR_OPERATORS);
+      source_append(&source, ";\n");
+    }
+    source_append(&source, "}\n\n");
+  }
+  return source.data;
+}
+
+static char *read_file(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (f == nullptr)
+    return nullptr;
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  char *src = malloc((sz)size + 1);
+  src[fread(src, 1, (sz)size, f)] = '\0';
+  fclose(f);
+  return src;
+}
+
+// Lexes once, then parses the tokens over and over. Sources with parse
+// errors are timed as well, that is the error path.
+static void bench_parse(const char *name, const char *src)
+{
+  solc_init();
+  solc_lexer_t *lexer = solc_lexer_create(src);
+  sz tokens_num;
+  solc_token_t *tokens = solc_lexer_tokenize(lexer, &tokens_num);
+
+  const sz rounds = SOLC_MAX(MIN_TOKENS / SOLC_MAX(tokens_num, (sz)1), (sz)1);
+  for (sz threads_num = 1; threads_num <= MAX_THREADS; threads_num *= 2) {
+    const u64 start = bench_now_ns();
+    for (sz i = 0; i < rounds; i++) {
+      solc_parser_t parser = solc_parser_create(tokens, tokens_num);
+      solc_ast_t *root = solc_parser_parse_parallel(&parser, threads_num);
+      BENCH_KEEP(root);
+      solc_ast_destroy(root);
+      solc_parser_destroy(&parser);
+    }
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s threads=%zu", name, threads_num);
+    bench_report(label, tokens_num * rounds, bench_now_ns() - start);
+  }
+
+  solc_lexer_destroy(lexer);
+  solc_deinit();
+}
+
+// Reports nanoseconds per token. The paths of further sources to parse can be
+// given on the command line.
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+  bench_header("parser, per token");
+
+  char *src = generate_source();
+  bench_parse("expression heavy", src);
+  free(src);
+
+  for (s32 i = 1; i < argc; i++) {
+    if (argv[i][0] == '-')
+      continue;
+    char *file_src = read_file(argv[i]);
+    if (file_src == nullptr) {
+      fprintf(stderr, "cannot read `%s'\n", argv[i]);
+      continue;
+    }
+    const char *name = strrchr(argv[i], '/');
+    bench_parse(name != nullptr ? name + 1 : argv[i], file_src);
+    free(file_src);
+  }
+  return 0;
+}
@@ -0,0 +1,115 @@
+#include "bench.h"
+#include "containers/trie.h"
+#include "solc/init.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LOOKUP_OPS (1 << 24)
+
+// The keyword tables `parser_context.c' used to build at startup.
+static const char *const toplevel_keywords[] = {
+  "enum", "typedef", "struct", "union", "import", "extern", "export", nullptr,
+};
+static const char *const stmt_keywords[] = {
+  "struct", "union",    "enum", "return", "goto",  "break",
+  "continue", "fallthrough", "while", "for", "do", "loop",
+  "switch", "defer",    "if",   "typedef", nullptr,
+};
+static const char *const struct_keywords[] = {
+  "typedef", "enum", "struct", "union", "public", "private", nullptr,
+};
+static const char *const union_keywords[] = {
+  "typedef", "enum", "struct", "union", nullptr,
+};
+static const char *const qualifiers[] = {
+  "inline", "persist", "local", "const", nullptr,
+};
+static const char *const *const tables[] = {
+  toplevel_keywords, stmt_keywords, struct_keywords, union_keywords, qualifiers,
+};
+#define TABLES_NUM (sizeof(tables) / sizeof(tables[0]))
+
+// What a statement lookup sees: mostly identifiers, some of them sharing a
+// prefix with a keyword.
+static const char *const stmt_words[] = {
+  "x",      "count", "return", "i",      "if",     "parser", "result",
+  "for",    "str",   "while",  "len",    "tokens", "break",  "do_work",
+  "node",   "const", "defer",  "switch", "idx",    "retval", "cont",
+};
+#define STMT_WORDS_NUM (sizeof(stmt_words) / sizeof(stmt_words[0]))
+
+// The trie every table used before, one 256-pointer node per character.
+typedef struct legacy_node_t {
+  struct legacy_node_t *children[0x100];
+  void *data_ptr;
+} legacy_node_t;
+
+static sz legacy_nodes_num;
+
+static legacy_node_t *legacy_node_create(void)
+{
+  legacy_nodes_num++;
+  return calloc(1, sizeof(legacy_node_t));
+}
+
+static void legacy_insert(legacy_node_t *cur, const char *str, void *data_ptr)
+{
+  for (; *str; str++) {
+    if (cur->children[(u8)*str] == nullptr)
+      cur->children[(u8)*str] = legacy_node_create();
+    cur = cur->children[(u8)*str];
+  }
+  cur->data_ptr = data_ptr;
+}
+
+// Kept out of line, `trie_get()' is a call away from the parser as well.
+__attribute__((noinline)) static void *legacy_get(legacy_node_t *cur,
+                                                  const char *str)
+{
+  for (; *str; str++) {
+    if (cur->children[(u8)*str] == nullptr)
+      return nullptr;
+    cur = cur->children[(u8)*str];
+  }
+  return cur->data_ptr;
+}
+
+s32 main(s32 argc, char **argv)
+{
+  bench_init(argc, argv);
+  solc_init();
+
+  legacy_node_t *legacy[TABLES_NUM];
+  trie_t *radix[TABLES_NUM];
+  sz radix_bytes = 0;
+  for (sz i = 0; i < TABLES_NUM; i++) {
+    legacy[i] = legacy_node_create();
+    radix[i] = trie_create();
+    for (const char *const *word = tables[i]; *word != nullptr; word++) {
+      legacy_insert(legacy[i], *word, (void *)*word);
+      trie_insert(radix[i], *word, (void *)*word);
+    }
+    radix_bytes += trie_get_memory_usage(radix[i]);
+  }
+
+  bench_header("trie");
+  bench_report_bytes("256-pointer trie keyword tables",
+                     legacy_nodes_num * sizeof(legacy_node_t));
+  bench_report_bytes("radix trie keyword tables", radix_bytes);
+  legacy_node_t *legacy_stmt = legacy[1];
+  trie_t *radix_stmt = radix[1];
+
+  u64 start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(legacy_get(legacy_stmt, stmt_words[i % STMT_WORDS_NUM]));
+  bench_report("256-pointer trie stmt lookup", LOOKUP_OPS,
+               bench_now_ns() - start);
+
+  start = bench_now_ns();
+  for (sz i = 0; i < LOOKUP_OPS; i++)
+    BENCH_KEEP(trie_get(radix_stmt, stmt_words[i % STMT_WORDS_NUM]));
+  bench_report("radix trie stmt lookup", LOOKUP_OPS, bench_now_ns() - start);
+
+  solc_deinit();
+  return 0;
+}
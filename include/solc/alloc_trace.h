@@ -0,0 +1,21 @@
+#ifndef __SOLC_ALLOC_TRACE_H__
+#define __SOLC_ALLOC_TRACE_H__
+
+#include <solc/defs.h>
+
+__SOLC_CPP_GUARD_TOP()
+
+// Returns false if libsolc was built without `-Dalloc_trace=true', in which
+// case the functions below do nothing.
+b8 solc_alloc_trace_enabled(void);
+
+// Starts writing every allocation (call site, size, subsystem and AST type)
+// to `path'. Fold the log with `tools/alloc_trace_fold.py'.
+b8 solc_alloc_trace_open(const char *path);
+
+// Flushes the log and appends the name tables.
+void solc_alloc_trace_close(void);
+
+__SOLC_CPP_GUARD_BOTTOM()
+
+#endif // __SOLC_ALLOC_TRACE_H__
@@ -3,5 +3,8 @@
 
 void solc_init(void);
 void solc_deinit(void);
+// Frees what the last translation unit left in the global arenas, nothing it
+// lexed or parsed may be used afterwards.
+void solc_reset(void);
 
 #endif // __SOLC_INIT_H__
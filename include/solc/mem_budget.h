@@ -0,0 +1,24 @@
+#ifndef __SOLC_MEM_BUDGET_H__
+#define __SOLC_MEM_BUDGET_H__
+
+#include <solc/defs.h>
+
+// Called once the budget cannot be met any more, `phase' names what the
+// compiler was doing (e.g. "parsing"). Must not return.
+typedef void (*solc_mem_budget_exceeded_func_t)(const char *phase, sz resident,
+                                                sz limit);
+
+__SOLC_CPP_GUARD_TOP()
+
+// Limits the resident memory of the process to `max_bytes', 0 removes the
+// limit. When the limit is approached retained arena memory is given back to
+// the OS before giving up.
+void solc_mem_budget_set_limit(sz max_bytes);
+
+// Without an exceeded function a diagnostic is printed and the process
+// aborts.
+void solc_mem_budget_set_exceeded_func(solc_mem_budget_exceeded_func_t func);
+
+__SOLC_CPP_GUARD_BOTTOM()
+
+#endif // __SOLC_MEM_BUDGET_H__
@@ -0,0 +1,48 @@
+#ifndef __SOLC_MEM_STATS_H__
+#define __SOLC_MEM_STATS_H__
+
+#include <solc/defs.h>
+#include <stdio.h>
+
+// Subsystems heap memory is attributed to.
+// #define __SOLC_MEM_TAG_X(tag_name, display_name) ...
+#define __SOLC_MEM_TAGS                        \
+  __SOLC_MEM_TAG_X(ARENA, "arena")             \
+  __SOLC_MEM_TAG_X(TOKENS, "tokens")           \
+  __SOLC_MEM_TAG_X(AST, "ast")                 \
+  __SOLC_MEM_TAG_X(DIAGNOSTICS, "diagnostics") \
+  __SOLC_MEM_TAG_X(VECTOR, "vector")           \
+  __SOLC_MEM_TAG_X(STRING, "string")           \
+  __SOLC_MEM_TAG_X(HASHTABLE, "hashtable")     \
+  __SOLC_MEM_TAG_X(HASHSET, "hashset")
+
+typedef enum {
+#define __SOLC_MEM_TAG_X(tag_name, display_name) SOLC_MEM_TAG_##tag_name,
+  __SOLC_MEM_TAGS
+#undef __SOLC_MEM_TAG_X
+  SOLC_MEM_TAG_MAX,
+} solc_mem_tag_t;
+
+typedef enum {
+  SOLC_MEM_STATS_FORMAT_TABLE,
+  SOLC_MEM_STATS_FORMAT_JSON,
+} solc_mem_stats_format_t;
+
+__SOLC_CPP_GUARD_TOP()
+
+// Returns false if libsolc was built without `-Dmem_stats=true', in which
+// case the functions below do nothing.
+b8 solc_mem_stats_enabled(void);
+
+// Starts a new reporting scope (e.g. a source file). Scope counters and peak
+// are reset, totals are kept.
+void solc_mem_stats_begin_scope(void);
+
+// Prints either the current scope (`scope_only') or the totals since
+// `solc_init()'. JSON is printed as a single line.
+void solc_mem_stats_print(FILE *stream, const char *label, b8 scope_only,
+                          solc_mem_stats_format_t format);
+
+__SOLC_CPP_GUARD_BOTTOM()
+
+#endif // __SOLC_MEM_STATS_H__
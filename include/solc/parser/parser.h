@@ -33,6 +33,12 @@ typedef struct {
 typedef struct {
   solc_token_t *tokens;
   solc_parser_error_t *errors_v;
+  // Speculative generic type lists of the current top-level statement, by the
+  // position of their `<'.
+  struct __hashtable_t *speculations;
+  // Per token, the position of the bracket closing it, see
+  // `parser_brackets_match()'.
+  sz *bracket_matches;
   sz pos, tokens_num;
   b8 errored;
 } solc_parser_t;
@@ -40,6 +46,9 @@ typedef struct {
 solc_parser_t solc_parser_create(solc_token_t *tokens, sz tokens_num);
 void solc_parser_destroy(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse(solc_parser_t *parser);
+// Parses the top-level statements on up to `threads_num' threads. The tree and
+// the errors are the same as those of `solc_parser_parse()'.
+solc_ast_t *solc_parser_parse_parallel(solc_parser_t *parser, sz threads_num);
 solc_parser_error_t *solc_parser_get_errors(solc_parser_t *parser,
                                             sz *errors_num);
 
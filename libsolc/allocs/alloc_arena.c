@@ -1,53 +1,105 @@
 #include "allocs/alloc_arena.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
+#include "allocs/alloc_vm.h"
+#include "allocs/mem_budget.h"
+#include "allocs/mem_stats.h"
 #include "containers/vector.h"
 #include "solc/defs.h"
 #include <stdlib.h>
 
 #define MINIMAL_BLOCK_SIZE 16384
+#define COMMIT_GRANULARITY 65536
 
 static inline alloc_arena_block_t *
-alloc_arena_add_block(alloc_arena_t *alloc_arena, sz block_size);
+alloc_arena_add_block(alloc_arena_t *alloc_arena, sz min_size);
+static inline b8 alloc_arena_commit(alloc_arena_t *alloc_arena,
+                                    alloc_arena_block_t *block, sz needed);
+static inline void alloc_arena_release(alloc_arena_t *alloc_arena,
+                                       alloc_arena_block_t *block, sz keep);
+static inline b8 alloc_arena_block_fits(const alloc_arena_block_t *block,
+                                        sz size);
 static inline sz get_aligned(sz x, sz alignment);
 
 alloc_arena_t alloc_arena_create(void)
 {
+  return alloc_arena_create_with_policy(
+    (alloc_arena_policy_t){ .backend = ALLOC_ARENA_BACKEND_HEAP });
+}
+
+alloc_arena_t alloc_arena_create_with_policy(alloc_arena_policy_t policy)
+{
+#ifndef ALLOC_VM_SUPPORTED
+  policy.backend = ALLOC_ARENA_BACKEND_HEAP;
+#endif
+  if (policy.backend == ALLOC_ARENA_BACKEND_VM)
+    policy.reserve_size =
+      get_aligned(SOLC_MAX(policy.reserve_size, ALLOC_VM_HUGE_PAGE_SIZE),
+                  ALLOC_VM_HUGE_PAGE_SIZE);
+
   return (alloc_arena_t){
     .blocks = vector_reserve(alloc_arena_block_t, 16),
     .blocks_num = 0,
+    .current_block = 0,
+    .policy = policy,
+    .committed = 0,
   };
 }
 
 void alloc_arena_destroy(alloc_arena_t *alloc_arena)
 {
   SOLC_ASSUME(alloc_arena != nullptr);
-  for (sz i = 0; i < alloc_arena->blocks_num; i++)
-    free(alloc_arena->blocks[i].memory);
+  for (sz i = 0; i < alloc_arena->blocks_num; i++) {
+    alloc_arena_block_t *block = &alloc_arena->blocks[i];
+    switch (block->backend) {
+    case ALLOC_ARENA_BACKEND_HEAP:
+      alloc_heap_free(block->memory);
+      break;
+    case ALLOC_ARENA_BACKEND_VM:
+#ifdef ALLOC_VM_SUPPORTED
+      mem_stats_on_free(SOLC_MEM_TAG_ARENA, block->committed);
+      alloc_vm_release(block->memory, block->size);
+#endif
+      break;
+    }
+  }
   vector_destroy(alloc_arena->blocks);
 }
 
 void *alloc_arena_allocate_aligned(alloc_arena_t *alloc_arena, sz size,
                                    sz alignment)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(alloc_arena != nullptr && size > 0 && alignment > 0);
 
   sz real_size = alignment + size;
   alloc_arena_block_t *suitable_block = nullptr;
 
-  for (sz i = 0; i < alloc_arena->blocks_num; i++) {
-    alloc_arena_block_t *block = &alloc_arena->blocks[i];
-    if (((uptr)block->memory + block->size) - block->cursor < real_size)
-      continue;
+  // Whatever is left in the blocks before the current one is given up.
+  for (sz i = alloc_arena->current_block; i < alloc_arena->blocks_num; i++) {
+    if SOLC_LIKELY (alloc_arena_block_fits(&alloc_arena->blocks[i],
+                                           real_size)) {
+      suitable_block = &alloc_arena->blocks[i];
+      alloc_arena->current_block = i;
+      break;
+    }
+  }
 
-    suitable_block = block;
-    break;
+  if (suitable_block == nullptr) {
+    suitable_block = alloc_arena_add_block(alloc_arena, real_size);
+    alloc_arena->current_block = alloc_arena->blocks_num - 1;
   }
 
-  if (suitable_block == nullptr)
-    suitable_block = alloc_arena_add_block(
-      alloc_arena, get_aligned(real_size, MINIMAL_BLOCK_SIZE));
+  const sz needed =
+    suitable_block->cursor + real_size - (uptr)suitable_block->memory;
+  if SOLC_UNLIKELY (needed > suitable_block->committed &&
+                    !alloc_arena_commit(alloc_arena, suitable_block, needed))
+    mem_budget_fail(real_size);
 
   void *out_data = (void *)get_aligned(suitable_block->cursor, alignment);
   suitable_block->cursor += real_size;
+  mem_stats_on_arena_alloc(size, real_size - size);
+  alloc_trace_record(ALLOC_TRACE_KIND_ARENA, SOLC_MEM_TAG_ARENA, size);
 
   return out_data;
 }
@@ -55,16 +107,67 @@ void *alloc_arena_allocate_aligned(alloc_arena_t *alloc_arena, sz size,
 void alloc_arena_clear(alloc_arena_t *alloc_arena)
 {
   SOLC_ASSUME(alloc_arena != nullptr);
-  for (sz i = 0; i < alloc_arena->blocks_num; i++)
-    alloc_arena->blocks[i].cursor = (uptr)alloc_arena->blocks[i].memory;
+
+  const sz release_threshold = alloc_arena->policy.release_threshold;
+  sz kept = 0;
+  alloc_arena->current_block = 0;
+  for (sz i = 0; i < alloc_arena->blocks_num; i++) {
+    alloc_arena_block_t *block = &alloc_arena->blocks[i];
+    block->cursor = (uptr)block->memory;
+
+    if (block->backend != ALLOC_ARENA_BACKEND_VM || release_threshold == 0)
+      continue;
+
+    // Everything committed above the high-water mark goes back to the OS.
+    const sz budget = release_threshold > kept ? release_threshold - kept : 0;
+    const sz keep = SOLC_MIN(block->committed,
+                             get_aligned(budget, COMMIT_GRANULARITY));
+    alloc_arena_release(alloc_arena, block, keep);
+    kept += keep;
+  }
+}
+
+void alloc_arena_trim(alloc_arena_t *alloc_arena)
+{
+  SOLC_ASSUME(alloc_arena != nullptr);
+
+  // Pressure can be relieved in the middle of `alloc_arena_allocate()' on this
+  // very arena, so blocks are never removed, only decommitted past the cursor.
+  for (sz i = 0; i < alloc_arena->blocks_num; i++) {
+    alloc_arena_block_t *block = &alloc_arena->blocks[i];
+    if (block->backend != ALLOC_ARENA_BACKEND_VM)
+      continue;
+
+    const sz used = block->cursor - (uptr)block->memory;
+    alloc_arena_release(alloc_arena, block,
+                        get_aligned(used, COMMIT_GRANULARITY));
+  }
 }
 
 static inline alloc_arena_block_t *
-alloc_arena_add_block(alloc_arena_t *alloc_arena, sz block_size)
+alloc_arena_add_block(alloc_arena_t *alloc_arena, sz min_size)
 {
   alloc_arena_block_t block = { 0 };
-  block.memory = malloc(block_size);
-  block.size = block_size;
+
+#ifdef ALLOC_VM_SUPPORTED
+  if (alloc_arena->policy.backend == ALLOC_ARENA_BACKEND_VM) {
+    block.size =
+      get_aligned(SOLC_MAX(min_size, alloc_arena->policy.reserve_size),
+                  ALLOC_VM_HUGE_PAGE_SIZE);
+    block.memory = alloc_vm_reserve(block.size, ALLOC_VM_HUGE_PAGE_SIZE);
+    block.committed = 0;
+    block.backend = ALLOC_ARENA_BACKEND_VM;
+  }
+#endif
+
+  // Either the heap was asked for or the address space ran out.
+  if (block.memory == nullptr) {
+    block.size = get_aligned(min_size, MINIMAL_BLOCK_SIZE);
+    block.memory = alloc_heap_malloc(SOLC_MEM_TAG_ARENA, block.size);
+    block.committed = block.size;
+    block.backend = ALLOC_ARENA_BACKEND_HEAP;
+  }
+
   block.cursor = (uptr)block.memory;
   vector_push(alloc_arena->blocks, block);
 
@@ -73,6 +176,71 @@ alloc_arena_add_block(alloc_arena_t *alloc_arena, sz block_size)
   return block_ptr;
 }
 
+static inline b8 alloc_arena_commit(alloc_arena_t *alloc_arena,
+                                    alloc_arena_block_t *block, sz needed)
+{
+#ifdef ALLOC_VM_SUPPORTED
+  SOLC_ASSUME(block->backend == ALLOC_ARENA_BACKEND_VM);
+
+  const sz granularity =
+    block->huge ? ALLOC_VM_HUGE_PAGE_SIZE : COMMIT_GRANULARITY;
+  const sz target = SOLC_MIN(get_aligned(needed, granularity), block->size);
+  // Charged first, relieving pressure may decommit this block down to its
+  // cursor.
+  mem_budget_charge(target - block->committed);
+  const sz delta = target - block->committed;
+  if SOLC_UNLIKELY (!alloc_vm_commit((char *)block->memory + block->committed,
+                                     delta)) {
+    mem_budget_relieve();
+    if (!alloc_vm_commit((char *)block->memory + block->committed, delta))
+      return false;
+  }
+
+  mem_stats_on_alloc(SOLC_MEM_TAG_ARENA, delta);
+  block->committed = target;
+  alloc_arena->committed += delta;
+
+  const sz huge_page_threshold = alloc_arena->policy.huge_page_threshold;
+  if (!block->huge && huge_page_threshold != 0 &&
+      alloc_arena->committed >= huge_page_threshold) {
+    alloc_vm_advise_huge(block->memory, block->size);
+    block->huge = true;
+  }
+
+  return true;
+#else
+  SOLC_UNUSED_PERMIT(alloc_arena);
+  SOLC_UNUSED_PERMIT(block);
+  SOLC_UNUSED_PERMIT(needed);
+  return false;
+#endif
+}
+
+static inline void alloc_arena_release(alloc_arena_t *alloc_arena,
+                                       alloc_arena_block_t *block, sz keep)
+{
+#ifdef ALLOC_VM_SUPPORTED
+  if (keep >= block->committed)
+    return;
+
+  const sz delta = block->committed - keep;
+  alloc_vm_decommit((char *)block->memory + keep, delta);
+  mem_stats_on_free(SOLC_MEM_TAG_ARENA, delta);
+  block->committed = keep;
+  alloc_arena->committed -= delta;
+#else
+  SOLC_UNUSED_PERMIT(alloc_arena);
+  SOLC_UNUSED_PERMIT(block);
+  SOLC_UNUSED_PERMIT(keep);
+#endif
+}
+
+static inline b8 alloc_arena_block_fits(const alloc_arena_block_t *block,
+                                        sz size)
+{
+  return ((uptr)block->memory + block->size) - block->cursor >= size;
+}
+
 static inline sz get_aligned(sz x, sz alignment)
 {
   return x + (-x & (alignment - 1));
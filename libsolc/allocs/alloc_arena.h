@@ -3,25 +3,56 @@
 
 #include "solc/defs.h"
 
+typedef enum {
+  // Blocks are allocated with `malloc()' and stay resident until destroyed.
+  ALLOC_ARENA_BACKEND_HEAP,
+  // Blocks are large reserved virtual ranges that are committed on demand.
+  // Falls back to the heap where virtual memory is not available.
+  ALLOC_ARENA_BACKEND_VM,
+} alloc_arena_backend_t;
+
+typedef struct {
+  alloc_arena_backend_t backend;
+  // Size of the virtual range reserved per block (VM only).
+  sz reserve_size;
+  // Once this many bytes are committed the blocks are advised to use huge
+  // pages, 0 disables it (VM only).
+  sz huge_page_threshold;
+  // `alloc_arena_clear()' keeps this many committed bytes and gives the rest
+  // back to the OS, 0 keeps everything (VM only).
+  sz release_threshold;
+} alloc_arena_policy_t;
+
 typedef struct {
   void *memory;
   sz size;
+  sz committed;
   uptr cursor;
+  alloc_arena_backend_t backend;
+  b8 huge;
 } alloc_arena_block_t;
 
-typedef struct {
+typedef struct __alloc_arena_t {
   alloc_arena_block_t *blocks;
   sz blocks_num;
+  // The block allocations are bumped from. Only moves forward until
+  // `alloc_arena_clear()', so filled blocks are never searched again.
+  sz current_block;
+  alloc_arena_policy_t policy;
+  sz committed;
 } alloc_arena_t;
 
 alloc_arena_t alloc_arena_create(void);
+alloc_arena_t alloc_arena_create_with_policy(alloc_arena_policy_t policy);
 void alloc_arena_destroy(alloc_arena_t *alloc_arena);
 void *alloc_arena_allocate_aligned(alloc_arena_t *alloc_arena, sz size,
                                    sz alignment);
-static inline void *alloc_arena_allocate(alloc_arena_t *alloc_arena, sz size)
-{
-  return alloc_arena_allocate_aligned(alloc_arena, size, 16);
-}
+// A macro rather than a function, so allocation traces see the real caller.
+#define alloc_arena_allocate(_alloc_arena, _size) \
+  alloc_arena_allocate_aligned((_alloc_arena), (_size), 16)
 void alloc_arena_clear(alloc_arena_t *alloc_arena);
+// Gives committed memory past the cursors back to the OS, used under memory
+// pressure. Heap blocks are kept as they are.
+void alloc_arena_trim(alloc_arena_t *alloc_arena);
 
 #endif // __SOLC_ALLOC_ARENA_H__
@@ -0,0 +1,101 @@
+#include "allocs/alloc_heap.h"
+#include "allocs/mem_stats.h"
+#include "solc/defs.h"
+#include <stdlib.h>
+
+void *alloc_heap_malloc_slow(sz size)
+{
+  mem_budget_relieve();
+  void *ptr = malloc(size);
+  if SOLC_UNLIKELY (ptr == nullptr)
+    mem_budget_fail(size);
+  return ptr;
+}
+
+void *alloc_heap_realloc_slow(void *ptr, sz size)
+{
+  mem_budget_relieve();
+  void *new_ptr = realloc(ptr, size);
+  if SOLC_UNLIKELY (new_ptr == nullptr)
+    mem_budget_fail(size);
+  return new_ptr;
+}
+
+#ifdef ALLOC_HEAP_TAGGED
+
+// Stored right before every tracked allocation. Kept at 16 bytes so the
+// returned pointer keeps malloc's alignment.
+typedef struct {
+  sz size;
+  u32 tag;
+  u32 _pad;
+} alloc_heap_prefix_t;
+
+_Static_assert(sizeof(alloc_heap_prefix_t) == 16,
+               "alloc_heap_prefix_t must keep 16 byte alignment");
+
+static inline alloc_heap_prefix_t *get_prefix(const void *ptr);
+
+void *alloc_heap_malloc(solc_mem_tag_t tag, sz size)
+{
+  SOLC_ASSUME(tag < SOLC_MEM_TAG_MAX);
+  mem_budget_charge(sizeof(alloc_heap_prefix_t) + size);
+  alloc_heap_prefix_t *prefix = malloc(sizeof(alloc_heap_prefix_t) + size);
+  if SOLC_UNLIKELY (prefix == nullptr)
+    prefix = alloc_heap_malloc_slow(sizeof(alloc_heap_prefix_t) + size);
+
+  prefix->size = size;
+  prefix->tag = tag;
+  mem_stats_on_alloc(tag, size);
+  alloc_trace_record(ALLOC_TRACE_KIND_HEAP, tag, size);
+
+  return prefix + 1;
+}
+
+void *alloc_heap_realloc(void *ptr, sz size)
+{
+  SOLC_ASSUME(ptr != nullptr);
+
+  alloc_heap_prefix_t *prefix = get_prefix(ptr);
+  const solc_mem_tag_t tag = (solc_mem_tag_t)prefix->tag;
+  const sz old_size = prefix->size;
+  if (size > old_size)
+    mem_budget_charge(size - old_size);
+
+  // A failed `realloc()' leaves the block alone.
+  const uptr addr = (uptr)prefix;
+  prefix = realloc(prefix, sizeof(alloc_heap_prefix_t) + size);
+  if SOLC_UNLIKELY (prefix == nullptr)
+    prefix = alloc_heap_realloc_slow((void *)addr,
+                                     sizeof(alloc_heap_prefix_t) + size);
+
+  prefix->size = size;
+  mem_stats_on_free(tag, old_size);
+  mem_stats_on_alloc(tag, size);
+  alloc_trace_record(ALLOC_TRACE_KIND_HEAP, tag, size);
+
+  return prefix + 1;
+}
+
+void alloc_heap_free(void *ptr)
+{
+  if (ptr == nullptr)
+    return;
+
+  alloc_heap_prefix_t *prefix = get_prefix(ptr);
+  mem_stats_on_free((solc_mem_tag_t)prefix->tag, prefix->size);
+  free(prefix);
+}
+
+solc_mem_tag_t alloc_heap_get_tag(const void *ptr)
+{
+  SOLC_ASSUME(ptr != nullptr);
+  return (solc_mem_tag_t)get_prefix(ptr)->tag;
+}
+
+static inline alloc_heap_prefix_t *get_prefix(const void *ptr)
+{
+  return (alloc_heap_prefix_t *)ptr - 1;
+}
+
+#endif
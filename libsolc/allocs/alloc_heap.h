@@ -0,0 +1,67 @@
+#ifndef __SOLC_ALLOC_HEAP_H__
+#define __SOLC_ALLOC_HEAP_H__
+
+#include "allocs/alloc_trace.h"
+#include "allocs/mem_budget.h"
+#include "solc/defs.h"
+#include "solc/mem_stats.h"
+#include <stdlib.h>
+
+// All long-lived heap memory of libsolc goes through these, so it can be
+// attributed to a subsystem. Without SOLC_MEM_STATS and SOLC_ALLOC_TRACE they
+// are plain `malloc()' and `free()'. They never return nullptr, running out of
+// memory (or out of the memory budget) ends the process with a diagnostic.
+
+#if defined(SOLC_MEM_STATS) || defined(SOLC_ALLOC_TRACE)
+#define ALLOC_HEAP_TAGGED
+#endif
+
+// Retry a failed `malloc()' or `realloc()' once pressure was relieved.
+void *alloc_heap_malloc_slow(sz size);
+void *alloc_heap_realloc_slow(void *ptr, sz size);
+
+#ifdef ALLOC_HEAP_TAGGED
+void *alloc_heap_malloc(solc_mem_tag_t tag, sz size);
+// Keeps the tag of `ptr', which must not be nullptr.
+void *alloc_heap_realloc(void *ptr, sz size);
+void alloc_heap_free(void *ptr);
+solc_mem_tag_t alloc_heap_get_tag(const void *ptr);
+#else
+static inline void *alloc_heap_malloc(solc_mem_tag_t tag, sz size)
+{
+  SOLC_UNUSED_PERMIT(tag);
+  alloc_trace_record(ALLOC_TRACE_KIND_HEAP, tag, size);
+  mem_budget_charge(size);
+  void *ptr = malloc(size);
+  if SOLC_UNLIKELY (ptr == nullptr)
+    ptr = alloc_heap_malloc_slow(size);
+  return ptr;
+}
+
+static inline void *alloc_heap_realloc(void *ptr, sz size)
+{
+  SOLC_ASSUME(ptr != nullptr);
+  // The old size is unknown here, so the whole block is charged.
+  mem_budget_charge(size);
+  // A failed `realloc()' leaves the block alone, kept as an address so that
+  // is not mistaken for a use after free.
+  const uptr addr = (uptr)ptr;
+  void *new_ptr = realloc(ptr, size);
+  if SOLC_UNLIKELY (new_ptr == nullptr)
+    new_ptr = alloc_heap_realloc_slow((void *)addr, size);
+  return new_ptr;
+}
+
+static inline void alloc_heap_free(void *ptr)
+{
+  free(ptr);
+}
+
+static inline solc_mem_tag_t alloc_heap_get_tag(const void *ptr)
+{
+  SOLC_UNUSED_PERMIT(ptr);
+  return SOLC_MEM_TAG_MAX;
+}
+#endif
+
+#endif // __SOLC_ALLOC_HEAP_H__
@@ -0,0 +1,200 @@
+// `dladdr()' is hidden by a strict `-std=c11'.
+#define _GNU_SOURCE
+
+#include "allocs/alloc_trace.h"
+#include "solc/alloc_trace.h"
+#include "solc/defs.h"
+#include "solc/mem_stats.h"
+#include "solc/parser/ast.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef SOLC_ALLOC_TRACE
+
+#include <dlfcn.h>
+#include <pthread.h>
+
+// Log layout, all little endian as written by the host:
+//   header:  "SOLCATR\0", u32 version, u32 record size, u64 libsolc load
+//            address, u16 path length, libsolc path
+//   records: alloc_trace_record_t, terminated by one with `size' == U32_MAX
+//   tables:  u32 count, { u8 length, name } per memory tag,
+//            u32 count, { u16 AST type, u8 length, name } per AST type
+#define ALLOC_TRACE_MAGIC "SOLCATR"
+#define ALLOC_TRACE_VERSION 1
+#define ALLOC_TRACE_BUFFER_RECORDS 4096
+
+typedef struct {
+  u64 site;
+  u32 size;
+  u16 ast_type;
+  u8 tag;
+  u8 kind;
+} alloc_trace_record_t;
+
+_Static_assert(sizeof(alloc_trace_record_t) == 16,
+               "alloc_trace_record_t must be 16 bytes");
+
+// Records are buffered for all threads, the call sites are per thread.
+static struct {
+  pthread_mutex_t lock;
+  FILE *file;
+  sz records_num;
+  alloc_trace_record_t records[ALLOC_TRACE_BUFFER_RECORDS];
+} alloc_trace = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static _Thread_local struct {
+  void *site;
+  u16 ast_type;
+} alloc_trace_current = { nullptr, ALLOC_TRACE_NO_AST_TYPE };
+
+static void flush(void);
+static void write_name(const char *name);
+
+b8 solc_alloc_trace_enabled(void)
+{
+  return true;
+}
+
+b8 solc_alloc_trace_open(const char *path)
+{
+  SOLC_ASSUME(path != nullptr);
+  if SOLC_UNLIKELY (alloc_trace.file != nullptr)
+    solc_alloc_trace_close();
+
+  alloc_trace.file = fopen(path, "wb");
+  if SOLC_UNLIKELY (alloc_trace.file == nullptr)
+    return false;
+  alloc_trace.records_num = 0;
+
+  // Sites are stored as raw addresses, the offline tool needs the load
+  // address of libsolc to symbolize them.
+  Dl_info info = { 0 };
+  dladdr((void *)solc_alloc_trace_open, &info);
+  const u32 version = ALLOC_TRACE_VERSION;
+  const u32 record_size = sizeof(alloc_trace_record_t);
+  const u64 base = (uptr)info.dli_fbase;
+  const char *lib_path = info.dli_fname != nullptr ? info.dli_fname : "";
+  const u16 lib_path_len = (u16)strlen(lib_path);
+
+  fwrite(ALLOC_TRACE_MAGIC, 1, sizeof(ALLOC_TRACE_MAGIC), alloc_trace.file);
+  fwrite(&version, sizeof(version), 1, alloc_trace.file);
+  fwrite(&record_size, sizeof(record_size), 1, alloc_trace.file);
+  fwrite(&base, sizeof(base), 1, alloc_trace.file);
+  fwrite(&lib_path_len, sizeof(lib_path_len), 1, alloc_trace.file);
+  fwrite(lib_path, 1, lib_path_len, alloc_trace.file);
+
+  return true;
+}
+
+void solc_alloc_trace_close(void)
+{
+  if (alloc_trace.file == nullptr)
+    return;
+
+  pthread_mutex_lock(&alloc_trace.lock);
+  flush();
+  const alloc_trace_record_t terminator = {
+    .size = UINT32_MAX,
+    .ast_type = ALLOC_TRACE_NO_AST_TYPE,
+  };
+  fwrite(&terminator, sizeof(terminator), 1, alloc_trace.file);
+
+  const u32 tags_num = SOLC_MEM_TAG_MAX;
+  fwrite(&tags_num, sizeof(tags_num), 1, alloc_trace.file);
+#define __SOLC_MEM_TAG_X(tag_name, display_name) write_name(display_name);
+  __SOLC_MEM_TAGS
+#undef __SOLC_MEM_TAG_X
+
+  u32 ast_types_num = 0;
+#define __SOLC_AST_TYPE_X(type_name, group_name, in_group_id, in_code_name) \
+  ast_types_num++;
+  __SOLC_AST_TYPES
+#undef __SOLC_AST_TYPE_X
+  fwrite(&ast_types_num, sizeof(ast_types_num), 1, alloc_trace.file);
+#define __SOLC_AST_TYPE_X(type_name, group_name, in_group_id, in_code_name) \
+  {                                                                         \
+    const u16 type = __SOLC_FULL_AST_NAME(type_name, group_name);           \
+    fwrite(&type, sizeof(type), 1, alloc_trace.file);                       \
+    write_name(__SOLC_QUOTE(in_code_name));                                 \
+  }
+  __SOLC_AST_TYPES
+#undef __SOLC_AST_TYPE_X
+
+  fclose(alloc_trace.file);
+  alloc_trace.file = nullptr;
+  pthread_mutex_unlock(&alloc_trace.lock);
+}
+
+void *alloc_trace_enter(void *site, u16 ast_type)
+{
+  if (alloc_trace_current.site != nullptr)
+    return nullptr;
+
+  alloc_trace_current.site = site;
+  alloc_trace_current.ast_type = ast_type;
+  return site;
+}
+
+void alloc_trace_leave(void **token)
+{
+  if (*token == nullptr)
+    return;
+
+  alloc_trace_current.site = nullptr;
+  alloc_trace_current.ast_type = ALLOC_TRACE_NO_AST_TYPE;
+}
+
+void alloc_trace_record(alloc_trace_kind_t kind, solc_mem_tag_t tag, sz size)
+{
+  if SOLC_LIKELY (alloc_trace.file == nullptr)
+    return;
+
+  const alloc_trace_record_t record = {
+    .site = (uptr)alloc_trace_current.site,
+    .size = (u32)SOLC_MIN(size, UINT32_MAX - 1),
+    .ast_type = alloc_trace_current.ast_type,
+    .tag = (u8)tag,
+    .kind = (u8)kind,
+  };
+  pthread_mutex_lock(&alloc_trace.lock);
+  alloc_trace.records[alloc_trace.records_num++] = record;
+  if SOLC_UNLIKELY (alloc_trace.records_num == ALLOC_TRACE_BUFFER_RECORDS)
+    flush();
+  pthread_mutex_unlock(&alloc_trace.lock);
+}
+
+static void flush(void)
+{
+  fwrite(alloc_trace.records, sizeof(alloc_trace_record_t),
+         alloc_trace.records_num, alloc_trace.file);
+  alloc_trace.records_num = 0;
+}
+
+static void write_name(const char *name)
+{
+  const u8 len = (u8)strlen(name);
+  fwrite(&len, sizeof(len), 1, alloc_trace.file);
+  fwrite(name, 1, len, alloc_trace.file);
+}
+
+#else
+
+b8 solc_alloc_trace_enabled(void)
+{
+  return false;
+}
+
+b8 solc_alloc_trace_open(const char *path)
+{
+  SOLC_UNUSED_PERMIT(path);
+  return false;
+}
+
+void solc_alloc_trace_close(void)
+{
+}
+
+#endif
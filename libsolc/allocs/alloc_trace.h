@@ -0,0 +1,33 @@
+#ifndef __SOLC_ALLOCS_ALLOC_TRACE_H__
+#define __SOLC_ALLOCS_ALLOC_TRACE_H__
+
+#include "solc/alloc_trace.h"
+#include "solc/defs.h"
+#include "solc/mem_stats.h"
+
+typedef enum {
+  ALLOC_TRACE_KIND_HEAP,
+  ALLOC_TRACE_KIND_ARENA,
+} alloc_trace_kind_t;
+
+#define ALLOC_TRACE_NO_AST_TYPE 0xFFFF
+
+#ifdef SOLC_ALLOC_TRACE
+// Makes `site' the call site of every allocation until the matching
+// `alloc_trace_leave()', unless an outer call already claimed it. Returns the
+// token to pass to `alloc_trace_leave()'.
+void *alloc_trace_enter(void *site, u16 ast_type);
+void alloc_trace_leave(void **token);
+void alloc_trace_record(alloc_trace_kind_t kind, solc_mem_tag_t tag, sz size);
+
+// Attributes the allocations of the enclosing function to its caller.
+#define ALLOC_TRACE_SITE()                                 \
+  __attribute__((cleanup(alloc_trace_leave), unused)) void \
+    *__alloc_trace_token = alloc_trace_enter(              \
+      __builtin_return_address(0), ALLOC_TRACE_NO_AST_TYPE)
+#else
+#define ALLOC_TRACE_SITE() ((void)0)
+#define alloc_trace_record(_kind, _tag, _size) ((void)0)
+#endif
+
+#endif // __SOLC_ALLOCS_ALLOC_TRACE_H__
@@ -0,0 +1,67 @@
+// `MAP_ANONYMOUS' and `madvise()' are hidden by a strict `-std=c11'.
+#define _DEFAULT_SOURCE
+
+#include "allocs/alloc_vm.h"
+#include "solc/defs.h"
+
+#ifdef ALLOC_VM_SUPPORTED
+
+#include <sys/mman.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+void *alloc_vm_reserve(sz size, sz alignment)
+{
+  SOLC_ASSUME(size > 0 && (alignment & (alignment - 1)) == 0);
+
+  // Over-reserve so an aligned range fits, then cut off both ends.
+  const sz mapped_size = size + alignment;
+  void *mapped =
+    mmap(nullptr, mapped_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if SOLC_UNLIKELY (mapped == MAP_FAILED)
+    return nullptr;
+
+  const uptr start = (uptr)mapped;
+  const uptr aligned = (start + alignment - 1) & ~(uptr)(alignment - 1);
+  const sz head = aligned - start;
+  const sz tail = mapped_size - head - size;
+  if (head > 0)
+    munmap(mapped, head);
+  if (tail > 0)
+    munmap((void *)(aligned + size), tail);
+
+  return (void *)aligned;
+}
+
+void alloc_vm_release(void *memory, sz size)
+{
+  SOLC_ASSUME(memory != nullptr);
+  munmap(memory, size);
+}
+
+b8 alloc_vm_commit(void *memory, sz size)
+{
+  SOLC_ASSUME(memory != nullptr);
+  return mprotect(memory, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void alloc_vm_decommit(void *memory, sz size)
+{
+  SOLC_ASSUME(memory != nullptr);
+  madvise(memory, size, MADV_DONTNEED);
+  mprotect(memory, size, PROT_NONE);
+}
+
+void alloc_vm_advise_huge(void *memory, sz size)
+{
+  SOLC_ASSUME(memory != nullptr);
+#ifdef MADV_HUGEPAGE
+  madvise(memory, size, MADV_HUGEPAGE);
+#else
+  SOLC_UNUSED_PERMIT(size);
+#endif
+}
+
+#endif
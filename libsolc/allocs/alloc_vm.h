@@ -0,0 +1,29 @@
+#ifndef __SOLC_ALLOC_VM_H__
+#define __SOLC_ALLOC_VM_H__
+
+#include "solc/defs.h"
+
+// Thin layer over the virtual memory interface of the OS. Address space is
+// reserved inaccessible first and committed piece by piece. Only available
+// when ALLOC_VM_SUPPORTED is defined, callers fall back to the heap otherwise.
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ALLOC_VM_SUPPORTED
+#endif
+
+#define ALLOC_VM_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+#ifdef ALLOC_VM_SUPPORTED
+// Returns a range of `size' bytes aligned to `alignment' (a power of two), or
+// nullptr if the address space could not be reserved.
+void *alloc_vm_reserve(sz size, sz alignment);
+void alloc_vm_release(void *memory, sz size);
+b8 alloc_vm_commit(void *memory, sz size);
+// Gives the pages back to the OS, the range has to be committed again before
+// it is touched.
+void alloc_vm_decommit(void *memory, sz size);
+// Asks for transparent huge pages, ignored where they are not supported.
+void alloc_vm_advise_huge(void *memory, sz size);
+#endif
+
+#endif // __SOLC_ALLOC_VM_H__
@@ -0,0 +1,175 @@
+// `sysconf()' and `malloc_trim()' are hidden by a strict `-std=c11'.
+#define _DEFAULT_SOURCE
+
+#include "allocs/mem_budget.h"
+#include "solc/defs.h"
+#include "solc/mem_budget.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#define MAX_PRESSURE_FUNCS 16
+#define MIN_SAMPLE_INTERVAL 65536
+
+typedef struct {
+  mem_budget_pressure_func_t func;
+  void *ctx;
+} pressure_func_entry_t;
+
+// The limit, the phase and the pressure functions are set by the thread that
+// drives the compilation, any thread charges.
+static struct {
+  sz limit;
+  // Resident memory is sampled whenever this many bytes were charged.
+  sz sample_interval;
+  _Atomic sz since_sample;
+  const char *phase;
+  solc_mem_budget_exceeded_func_t exceeded_func;
+  pressure_func_entry_t pressure_funcs[MAX_PRESSURE_FUNCS];
+  sz pressure_funcs_num;
+  pthread_mutex_t relieve_lock;
+} mem_budget = {
+  .phase = "initializing",
+  .relieve_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+// Pressure functions may allocate, which must not relieve again.
+static _Thread_local b8 relieving = false;
+
+static sz get_resident(void);
+
+void solc_mem_budget_set_limit(sz max_bytes)
+{
+  mem_budget.limit = max_bytes;
+  mem_budget.sample_interval = SOLC_MAX(max_bytes / 64, MIN_SAMPLE_INTERVAL);
+  atomic_store(&mem_budget.since_sample, 0);
+}
+
+void solc_mem_budget_set_exceeded_func(solc_mem_budget_exceeded_func_t func)
+{
+  mem_budget.exceeded_func = func;
+}
+
+void mem_budget_add_pressure_func(mem_budget_pressure_func_t func, void *ctx)
+{
+  SOLC_ASSUME(func != nullptr);
+  SOLC_ASSERT(mem_budget.pressure_funcs_num < MAX_PRESSURE_FUNCS);
+  mem_budget.pressure_funcs[mem_budget.pressure_funcs_num++] =
+    (pressure_func_entry_t){ func, ctx };
+}
+
+void mem_budget_remove_pressure_func(mem_budget_pressure_func_t func,
+                                     void *ctx)
+{
+  for (sz i = 0; i < mem_budget.pressure_funcs_num; i++) {
+    pressure_func_entry_t *entry = &mem_budget.pressure_funcs[i];
+    if (entry->func != func || entry->ctx != ctx)
+      continue;
+
+    *entry = mem_budget.pressure_funcs[--mem_budget.pressure_funcs_num];
+    return;
+  }
+}
+
+const char *mem_budget_enter_phase(const char *phase)
+{
+  SOLC_ASSUME(phase != nullptr);
+  const char *previous_phase = mem_budget.phase;
+  mem_budget.phase = phase;
+  return previous_phase;
+}
+
+void mem_budget_leave_phase(const char *previous_phase)
+{
+  SOLC_ASSUME(previous_phase != nullptr);
+  mem_budget.phase = previous_phase;
+}
+
+void mem_budget_charge(sz size)
+{
+  if SOLC_LIKELY (mem_budget.limit == 0 || relieving)
+    return;
+
+  // Only the thread that crosses the interval samples.
+  const sz since_sample =
+    atomic_fetch_add_explicit(&mem_budget.since_sample, size,
+                              memory_order_relaxed) +
+    size;
+  if SOLC_LIKELY (since_sample < mem_budget.sample_interval)
+    return;
+  atomic_store_explicit(&mem_budget.since_sample, 0, memory_order_relaxed);
+
+  // Start giving memory back at 7/8 of the budget, fail only if that did not
+  // make room for `size'.
+  const sz soft_limit = mem_budget.limit - mem_budget.limit / 8;
+  if SOLC_LIKELY (get_resident() + size < soft_limit)
+    return;
+
+  mem_budget_relieve();
+  if SOLC_UNLIKELY (get_resident() + size > mem_budget.limit)
+    mem_budget_fail(size);
+}
+
+void mem_budget_relieve(void)
+{
+  if (relieving)
+    return;
+
+  relieving = true;
+  pthread_mutex_lock(&mem_budget.relieve_lock);
+  for (sz i = 0; i < mem_budget.pressure_funcs_num; i++)
+    mem_budget.pressure_funcs[i].func(mem_budget.pressure_funcs[i].ctx);
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+  pthread_mutex_unlock(&mem_budget.relieve_lock);
+  relieving = false;
+}
+
+void mem_budget_fail(sz size)
+{
+  const sz resident = get_resident();
+  if (mem_budget.exceeded_func != nullptr)
+    mem_budget.exceeded_func(mem_budget.phase, resident, mem_budget.limit);
+
+  fprintf(stderr,
+          "solc: out of memory while %s (%zu bytes resident, %zu bytes "
+          "requested, limit %zu bytes)\n",
+          mem_budget.phase, resident, size, mem_budget.limit);
+  abort();
+}
+
+static sz get_resident(void)
+{
+#if defined(__linux__)
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if SOLC_UNLIKELY (statm == nullptr)
+    return 0;
+
+  unsigned long pages_total = 0, pages_resident = 0;
+  const b8 ok = fscanf(statm, "%lu %lu", &pages_total, &pages_resident) == 2;
+  fclose(statm);
+  return ok ? (sz)pages_resident * (sz)sysconf(_SC_PAGESIZE) : 0;
+#elif defined(__unix__) || defined(__APPLE__)
+  // Only the peak is portable, which is what the budget caps anyway.
+  struct rusage usage = { 0 };
+  if SOLC_UNLIKELY (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return (sz)usage.ru_maxrss;
+#else
+  return (sz)usage.ru_maxrss * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,30 @@
+#ifndef __SOLC_ALLOCS_MEM_BUDGET_H__
+#define __SOLC_ALLOCS_MEM_BUDGET_H__
+
+#include "solc/defs.h"
+#include "solc/mem_budget.h"
+
+// Gives memory that is retained but not in use back to the OS.
+typedef void (*mem_budget_pressure_func_t)(void *ctx);
+
+void mem_budget_add_pressure_func(mem_budget_pressure_func_t func, void *ctx);
+void mem_budget_remove_pressure_func(mem_budget_pressure_func_t func,
+                                     void *ctx);
+
+// Phases are static strings, `mem_budget_enter_phase()' returns the previous
+// one to restore with `mem_budget_leave_phase()'.
+const char *mem_budget_enter_phase(const char *phase);
+void mem_budget_leave_phase(const char *previous_phase);
+
+// Has to be called before `size' new bytes are requested from the OS. Relieves
+// pressure or fails if they would not fit into the budget.
+void mem_budget_charge(sz size);
+
+// Runs all pressure functions.
+void mem_budget_relieve(void);
+
+// Reports the exceeded budget (or an allocation of `size' bytes the OS
+// refused) and never returns.
+_Noreturn void mem_budget_fail(sz size);
+
+#endif // __SOLC_ALLOCS_MEM_BUDGET_H__
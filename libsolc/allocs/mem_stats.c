@@ -0,0 +1,201 @@
+#include "allocs/mem_stats.h"
+#include "solc/defs.h"
+#include "solc/mem_stats.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#ifdef SOLC_MEM_STATS
+
+#define MEM_STATS_ALL SOLC_MEM_TAG_MAX
+
+typedef struct {
+  u64 allocs;
+  u64 frees;
+  u64 bytes;
+  u64 peak;
+} mem_stats_counter_t;
+
+typedef struct {
+  // One counter per tag, the last one accumulates all of them.
+  mem_stats_counter_t counters[SOLC_MEM_TAG_MAX + 1];
+  u64 arena_requested;
+  u64 arena_waste;
+} mem_stats_set_t;
+
+// Allocations may come from any thread, the parallel parser has a few.
+static struct {
+  pthread_mutex_t lock;
+  mem_stats_set_t total;
+  mem_stats_set_t scope;
+  u64 live[SOLC_MEM_TAG_MAX + 1];
+} mem_stats = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static const char *tag_names[] = {
+#define __SOLC_MEM_TAG_X(tag_name, display_name) display_name,
+  __SOLC_MEM_TAGS
+#undef __SOLC_MEM_TAG_X
+  "total",
+};
+
+static inline void update_peak(mem_stats_counter_t *counter, u64 live);
+static void print_table(FILE *stream, const char *label,
+                        const mem_stats_set_t *set);
+static void print_json(FILE *stream, const char *label,
+                       const mem_stats_set_t *set);
+
+void mem_stats_on_alloc(solc_mem_tag_t tag, sz size)
+{
+  pthread_mutex_lock(&mem_stats.lock);
+  mem_stats.live[tag] += size;
+  mem_stats.live[MEM_STATS_ALL] += size;
+
+  const solc_mem_tag_t idxs[] = { tag, MEM_STATS_ALL };
+  for (sz i = 0; i < 2; i++) {
+    mem_stats_counter_t *total = &mem_stats.total.counters[idxs[i]];
+    mem_stats_counter_t *scope = &mem_stats.scope.counters[idxs[i]];
+    total->allocs++;
+    scope->allocs++;
+    total->bytes += size;
+    scope->bytes += size;
+    update_peak(total, mem_stats.live[idxs[i]]);
+    update_peak(scope, mem_stats.live[idxs[i]]);
+  }
+  pthread_mutex_unlock(&mem_stats.lock);
+}
+
+void mem_stats_on_free(solc_mem_tag_t tag, sz size)
+{
+  pthread_mutex_lock(&mem_stats.lock);
+  mem_stats.live[tag] -= size;
+  mem_stats.live[MEM_STATS_ALL] -= size;
+
+  mem_stats.total.counters[tag].frees++;
+  mem_stats.scope.counters[tag].frees++;
+  mem_stats.total.counters[MEM_STATS_ALL].frees++;
+  mem_stats.scope.counters[MEM_STATS_ALL].frees++;
+  pthread_mutex_unlock(&mem_stats.lock);
+}
+
+void mem_stats_on_arena_alloc(sz requested, sz waste)
+{
+  pthread_mutex_lock(&mem_stats.lock);
+  mem_stats.total.arena_requested += requested;
+  mem_stats.scope.arena_requested += requested;
+  mem_stats.total.arena_waste += waste;
+  mem_stats.scope.arena_waste += waste;
+  pthread_mutex_unlock(&mem_stats.lock);
+}
+
+b8 solc_mem_stats_enabled(void)
+{
+  return true;
+}
+
+void solc_mem_stats_begin_scope(void)
+{
+  pthread_mutex_lock(&mem_stats.lock);
+  mem_stats.scope = (mem_stats_set_t){ 0 };
+  for (sz i = 0; i <= MEM_STATS_ALL; i++)
+    mem_stats.scope.counters[i].peak = mem_stats.live[i];
+  pthread_mutex_unlock(&mem_stats.lock);
+}
+
+void solc_mem_stats_print(FILE *stream, const char *label, b8 scope_only,
+                          solc_mem_stats_format_t format)
+{
+  SOLC_ASSUME(stream != nullptr && label != nullptr);
+  pthread_mutex_lock(&mem_stats.lock);
+  const mem_stats_set_t *set = scope_only ? &mem_stats.scope :
+                                            &mem_stats.total;
+  switch (format) {
+  case SOLC_MEM_STATS_FORMAT_TABLE:
+    print_table(stream, label, set);
+    break;
+  case SOLC_MEM_STATS_FORMAT_JSON:
+    print_json(stream, label, set);
+    break;
+  }
+  pthread_mutex_unlock(&mem_stats.lock);
+}
+
+static inline void update_peak(mem_stats_counter_t *counter, u64 live)
+{
+  if (live > counter->peak)
+    counter->peak = live;
+}
+
+static void print_table(FILE *stream, const char *label,
+                        const mem_stats_set_t *set)
+{
+  fprintf(stream, "Memory statistics for %s:\n", label);
+  fprintf(stream, "  %-12s %12s %12s %14s %14s %14s\n", "subsystem", "allocs",
+          "frees", "bytes", "live", "peak");
+  for (sz i = 0; i <= MEM_STATS_ALL; i++) {
+    const mem_stats_counter_t *counter = &set->counters[i];
+    fprintf(stream, "  %-12s %12llu %12llu %14llu %14llu %14llu\n",
+            tag_names[i], (unsigned long long)counter->allocs,
+            (unsigned long long)counter->frees,
+            (unsigned long long)counter->bytes,
+            (unsigned long long)mem_stats.live[i],
+            (unsigned long long)counter->peak);
+  }
+
+  u64 arena_total = set->arena_requested + set->arena_waste;
+  fprintf(stream,
+          "  arena: %llu bytes requested, %llu bytes of alignment waste "
+          "(%.1f%%)\n",
+          (unsigned long long)set->arena_requested,
+          (unsigned long long)set->arena_waste,
+          arena_total == 0 ? 0.0 : 100.0 * set->arena_waste / arena_total);
+}
+
+static void print_json(FILE *stream, const char *label,
+                       const mem_stats_set_t *set)
+{
+  fputs("{\"label\":\"", stream);
+  for (const char *c = label; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      fputc('\\', stream);
+    fputc(*c, stream);
+  }
+  fputs("\",\"subsystems\":{", stream);
+  for (sz i = 0; i <= MEM_STATS_ALL; i++) {
+    const mem_stats_counter_t *counter = &set->counters[i];
+    fprintf(stream,
+            "%s\"%s\":{\"allocs\":%llu,\"frees\":%llu,\"bytes\":%llu,"
+            "\"live\":%llu,\"peak\":%llu}",
+            i == 0 ? "" : ",", tag_names[i],
+            (unsigned long long)counter->allocs,
+            (unsigned long long)counter->frees,
+            (unsigned long long)counter->bytes,
+            (unsigned long long)mem_stats.live[i],
+            (unsigned long long)counter->peak);
+  }
+  fprintf(stream, "},\"arena\":{\"requested\":%llu,\"waste\":%llu}}\n",
+          (unsigned long long)set->arena_requested,
+          (unsigned long long)set->arena_waste);
+}
+
+#else
+
+b8 solc_mem_stats_enabled(void)
+{
+  return false;
+}
+
+void solc_mem_stats_begin_scope(void)
+{
+}
+
+void solc_mem_stats_print(FILE *stream, const char *label, b8 scope_only,
+                          solc_mem_stats_format_t format)
+{
+  SOLC_UNUSED_PERMIT(stream);
+  SOLC_UNUSED_PERMIT(label);
+  SOLC_UNUSED_PERMIT(scope_only);
+  SOLC_UNUSED_PERMIT(format);
+}
+
+#endif
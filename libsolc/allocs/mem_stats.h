@@ -0,0 +1,19 @@
+#ifndef __SOLC_ALLOCS_MEM_STATS_H__
+#define __SOLC_ALLOCS_MEM_STATS_H__
+
+#include "solc/defs.h"
+#include "solc/mem_stats.h"
+
+#ifdef SOLC_MEM_STATS
+void mem_stats_on_alloc(solc_mem_tag_t tag, sz size);
+void mem_stats_on_free(solc_mem_tag_t tag, sz size);
+// `requested' is what the caller asked for, `waste' is what the arena had to
+// reserve on top of it to satisfy the alignment.
+void mem_stats_on_arena_alloc(sz requested, sz waste);
+#else
+#define mem_stats_on_alloc(_tag, _size) ((void)0)
+#define mem_stats_on_free(_tag, _size) ((void)0)
+#define mem_stats_on_arena_alloc(_requested, _waste) ((void)0)
+#endif
+
+#endif // __SOLC_ALLOCS_MEM_STATS_H__
@@ -0,0 +1,336 @@
+#include "containers/bitset.h"
+#include "allocs/alloc_arena.h"
+#include "allocs/alloc_trace.h"
+#include "solc/defs.h"
+#include <string.h>
+
+// The AVX2 kernels are compiled for that target alone and picked at run time,
+// so the library still runs on CPUs without it.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BITSET_AVX2
+#define BITSET_AVX2_TARGET __attribute__((target("avx2,popcnt")))
+#define BITSET_AVX2_WORDS 4
+#endif
+
+// Words are allocated in multiples of this, aligned to as many bytes.
+#define BITSET_WORDS_ALIGNMENT 4
+#define BITSET_GROWTH_FACTOR 2
+
+typedef enum {
+  BITSET_OP_OR,
+  BITSET_OP_AND,
+  BITSET_OP_ANDNOT,
+} bitset_op_t;
+
+static inline sz bitset_words_num(sz bits_num);
+static inline b8 bitset_has_avx2(void);
+static u64 *bitset_words_alloc(alloc_arena_t *arena, sz words_capacity);
+static b8 bitset_apply(u64 *dst, const u64 *src, sz words_num, bitset_op_t op);
+static b8 bitset_apply_words(u64 *dst, const u64 *src, sz words_num,
+                             bitset_op_t op);
+static sz bitset_count_words(const u64 *words, sz words_num);
+static b8 bitset_is_zero(const u64 *words, sz words_num);
+
+#ifdef BITSET_AVX2
+BITSET_AVX2_TARGET static b8 bitset_apply_avx2(u64 *dst, const u64 *src,
+                                               sz words_num, bitset_op_t op);
+BITSET_AVX2_TARGET static sz bitset_count_avx2(const u64 *words,
+                                               sz words_num);
+#endif
+
+static bitset_t bitset_create_impl(alloc_arena_t *arena, sz bits_num,
+                                   b8 is_growable)
+{
+  SOLC_ASSUME(arena != nullptr);
+
+  const sz words_capacity = SOLC_MAX(bitset_words_num(bits_num),
+                                     (sz)BITSET_WORDS_ALIGNMENT);
+  return (bitset_t){
+    .words = bitset_words_alloc(arena, words_capacity),
+    .bits_num = bits_num,
+    .words_capacity = words_capacity,
+    .arena = arena,
+    .is_growable = is_growable,
+  };
+}
+
+bitset_t bitset_create(alloc_arena_t *arena, sz bits_num)
+{
+  return bitset_create_impl(arena, bits_num, false);
+}
+
+bitset_t bitset_create_growable(alloc_arena_t *arena, sz bits_num)
+{
+  return bitset_create_impl(arena, bits_num, true);
+}
+
+bitset_t bitset_copy(const bitset_t *bitset)
+{
+  SOLC_ASSUME(bitset != nullptr);
+
+  bitset_t copy =
+    bitset_create_impl(bitset->arena, bitset->bits_num, bitset->is_growable);
+  memcpy(copy.words, bitset->words,
+         bitset_words_num(bitset->bits_num) * sizeof(u64));
+  return copy;
+}
+
+void bitset_resize(bitset_t *bitset, sz bits_num)
+{
+  SOLC_ASSUME(bitset != nullptr);
+  SOLC_ASSERT(bitset->is_growable);
+
+  if (bits_num > bitset->bits_num) {
+    __bitset_grow(bitset, bits_num);
+    return;
+  }
+
+  // Bits past the end are kept clear, the set operations rely on it.
+  const sz words_num = bitset_words_num(bits_num);
+  memset(bitset->words + words_num, 0,
+         (bitset_words_num(bitset->bits_num) - words_num) * sizeof(u64));
+  if (bits_num % BITSET_WORD_BITS != 0)
+    bitset->words[words_num - 1] &=
+      (1ULL << (bits_num % BITSET_WORD_BITS)) - 1;
+  bitset->bits_num = bits_num;
+}
+
+void bitset_clear(bitset_t *bitset)
+{
+  SOLC_ASSUME(bitset != nullptr);
+  memset(bitset->words, 0, bitset_words_num(bitset->bits_num) * sizeof(u64));
+}
+
+b8 bitset_union(bitset_t *dst, const bitset_t *src)
+{
+  SOLC_ASSUME(dst != nullptr && src != nullptr);
+
+  if (src->bits_num > dst->bits_num)
+    __bitset_grow(dst, src->bits_num);
+  return bitset_apply(dst->words, src->words, bitset_words_num(src->bits_num),
+                      BITSET_OP_OR);
+}
+
+b8 bitset_intersect(bitset_t *dst, const bitset_t *src)
+{
+  SOLC_ASSUME(dst != nullptr && src != nullptr);
+
+  const sz dst_words_num = bitset_words_num(dst->bits_num);
+  const sz words_num =
+    SOLC_MIN(dst_words_num, bitset_words_num(src->bits_num));
+  b8 changed = bitset_apply(dst->words, src->words, words_num, BITSET_OP_AND);
+
+  // Whatever `src' does not cover is intersected with nothing.
+  if (!bitset_is_zero(dst->words + words_num, dst_words_num - words_num)) {
+    memset(dst->words + words_num, 0,
+           (dst_words_num - words_num) * sizeof(u64));
+    changed = true;
+  }
+  return changed;
+}
+
+b8 bitset_difference(bitset_t *dst, const bitset_t *src)
+{
+  SOLC_ASSUME(dst != nullptr && src != nullptr);
+
+  const sz words_num = SOLC_MIN(bitset_words_num(dst->bits_num),
+                                bitset_words_num(src->bits_num));
+  return bitset_apply(dst->words, src->words, words_num, BITSET_OP_ANDNOT);
+}
+
+sz bitset_count(const bitset_t *bitset)
+{
+  SOLC_ASSUME(bitset != nullptr);
+
+  const sz words_num = bitset_words_num(bitset->bits_num);
+#ifdef BITSET_AVX2
+  if (bitset_has_avx2())
+    return bitset_count_avx2(bitset->words, words_num);
+#endif
+  return bitset_count_words(bitset->words, words_num);
+}
+
+b8 bitset_equals(const bitset_t *a, const bitset_t *b)
+{
+  SOLC_ASSUME(a != nullptr && b != nullptr);
+
+  const sz a_words_num = bitset_words_num(a->bits_num);
+  const sz b_words_num = bitset_words_num(b->bits_num);
+  const sz words_num = SOLC_MIN(a_words_num, b_words_num);
+  return memcmp(a->words, b->words, words_num * sizeof(u64)) == 0 &&
+         bitset_is_zero(a->words + words_num, a_words_num - words_num) &&
+         bitset_is_zero(b->words + words_num, b_words_num - words_num);
+}
+
+sz bitset_next(const bitset_t *bitset, sz from)
+{
+  SOLC_ASSUME(bitset != nullptr);
+
+  if (from >= bitset->bits_num)
+    return bitset->bits_num;
+
+  const sz words_num = bitset_words_num(bitset->bits_num);
+  sz word_index = from / BITSET_WORD_BITS;
+  u64 word = bitset->words[word_index] & (~0ULL << (from % BITSET_WORD_BITS));
+  while (word == 0) {
+    if (++word_index == words_num)
+      return bitset->bits_num;
+    word = bitset->words[word_index];
+  }
+  return word_index * BITSET_WORD_BITS + (sz)__builtin_ctzll(word);
+}
+
+void bitset_foreach(const bitset_t *bitset,
+                    bitset_foreach_function_t foreach_function, void *ctx)
+{
+  SOLC_ASSUME(bitset != nullptr && foreach_function != nullptr);
+
+  const sz words_num = bitset_words_num(bitset->bits_num);
+  for (sz i = 0; i < words_num; i++)
+    for (u64 word = bitset->words[i]; word != 0; word &= word - 1)
+      foreach_function(i * BITSET_WORD_BITS + (sz)__builtin_ctzll(word), ctx);
+}
+
+void __bitset_grow(bitset_t *bitset, sz bits_num)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(bitset != nullptr && bits_num > bitset->bits_num);
+  SOLC_ASSERT(bitset->is_growable);
+
+  const sz words_num = bitset_words_num(bits_num);
+  if (words_num > bitset->words_capacity) {
+    const sz words_capacity =
+      SOLC_MAX(words_num, bitset->words_capacity * BITSET_GROWTH_FACTOR);
+    u64 *words = bitset_words_alloc(bitset->arena, words_capacity);
+    memcpy(words, bitset->words,
+           bitset_words_num(bitset->bits_num) * sizeof(u64));
+    bitset->words = words;
+    bitset->words_capacity = words_capacity;
+  }
+  bitset->bits_num = bits_num;
+}
+
+static inline sz bitset_words_num(sz bits_num)
+{
+  return (bits_num + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+
+static inline b8 bitset_has_avx2(void)
+{
+#if defined(__AVX2__)
+  return true;
+#elif defined(BITSET_AVX2)
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+static u64 *bitset_words_alloc(alloc_arena_t *arena, sz words_capacity)
+{
+  ALLOC_TRACE_SITE();
+
+  words_capacity = (words_capacity + BITSET_WORDS_ALIGNMENT - 1) &
+                   ~(sz)(BITSET_WORDS_ALIGNMENT - 1);
+  u64 *words = alloc_arena_allocate_aligned(
+    arena, words_capacity * sizeof(u64),
+    BITSET_WORDS_ALIGNMENT * sizeof(u64));
+  memset(words, 0, words_capacity * sizeof(u64));
+  return words;
+}
+
+static b8 bitset_apply(u64 *dst, const u64 *src, sz words_num, bitset_op_t op)
+{
+#ifdef BITSET_AVX2
+  if (bitset_has_avx2())
+    return bitset_apply_avx2(dst, src, words_num, op);
+#endif
+  return bitset_apply_words(dst, src, words_num, op);
+}
+
+static b8 bitset_apply_words(u64 *dst, const u64 *src, sz words_num,
+                             bitset_op_t op)
+{
+  u64 changed = 0;
+  for (sz i = 0; i < words_num; i++) {
+    u64 word;
+    switch (op) {
+    case BITSET_OP_OR:
+      word = dst[i] | src[i];
+      break;
+    case BITSET_OP_AND:
+      word = dst[i] & src[i];
+      break;
+    case BITSET_OP_ANDNOT:
+      word = dst[i] & ~src[i];
+      break;
+    default:
+      SOLC_NOREACH();
+    }
+    changed |= word ^ dst[i];
+    dst[i] = word;
+  }
+  return changed != 0;
+}
+
+static sz bitset_count_words(const u64 *words, sz words_num)
+{
+  sz count = 0;
+  for (sz i = 0; i < words_num; i++)
+    count += (sz)__builtin_popcountll(words[i]);
+  return count;
+}
+
+static b8 bitset_is_zero(const u64 *words, sz words_num)
+{
+  for (sz i = 0; i < words_num; i++)
+    if (words[i] != 0)
+      return false;
+  return true;
+}
+
+#ifdef BITSET_AVX2
+BITSET_AVX2_TARGET static b8 bitset_apply_avx2(u64 *dst, const u64 *src,
+                                               sz words_num, bitset_op_t op)
+{
+  const sz vector_words_num = words_num & ~(sz)(BITSET_AVX2_WORDS - 1);
+  __m256i changed = _mm256_setzero_si256();
+  for (sz i = 0; i < vector_words_num; i += BITSET_AVX2_WORDS) {
+    const __m256i a = _mm256_load_si256((const __m256i *)(dst + i));
+    const __m256i b = _mm256_load_si256((const __m256i *)(src + i));
+    __m256i word;
+    switch (op) {
+    case BITSET_OP_OR:
+      word = _mm256_or_si256(a, b);
+      break;
+    case BITSET_OP_AND:
+      word = _mm256_and_si256(a, b);
+      break;
+    case BITSET_OP_ANDNOT:
+      word = _mm256_andnot_si256(b, a);
+      break;
+    default:
+      SOLC_NOREACH();
+    }
+    changed = _mm256_or_si256(changed, _mm256_xor_si256(word, a));
+    _mm256_store_si256((__m256i *)(dst + i), word);
+  }
+
+  const b8 tail_changed = bitset_apply_words(
+    dst + vector_words_num, src + vector_words_num,
+    words_num - vector_words_num, op);
+  return !_mm256_testz_si256(changed, changed) || tail_changed;
+}
+
+BITSET_AVX2_TARGET static sz bitset_count_avx2(const u64 *words,
+                                               sz words_num)
+{
+  // Counting is bound by `popcnt' rather than by loads, the target is only
+  // there so it is used instead of the generic fallback.
+  sz count = 0;
+  for (sz i = 0; i < words_num; i++)
+    count += (sz)__builtin_popcountll(words[i]);
+  return count;
+}
+#endif
@@ -0,0 +1,77 @@
+#ifndef __SOLC_CONTAINER_BITSET_H__
+#define __SOLC_CONTAINER_BITSET_H__
+
+#include "allocs/alloc_arena.h"
+#include "solc/defs.h"
+
+#define BITSET_WORD_BITS 64
+
+// A dense set of bit indices, stored as `u64' words in `arena'. Fixed sets
+// hold exactly the bits they were created with, growable ones grow when a bit
+// past their end is set or another set is merged into them. Set operations
+// work a word at a time, or four words at a time where AVX2 is available.
+//
+// Growing leaves the old words in the arena, so a set that is still growing
+// should not share an arena with a lot of short lived ones.
+typedef struct {
+  u64 *words;
+  sz bits_num;
+  sz words_capacity;
+  alloc_arena_t *arena;
+  b8 is_growable;
+} bitset_t;
+
+typedef void (*bitset_foreach_function_t)(sz bit, void *ctx);
+
+bitset_t bitset_create(alloc_arena_t *arena, sz bits_num);
+bitset_t bitset_create_growable(alloc_arena_t *arena, sz bits_num);
+// A copy in the same arena, fixed or growable as `bitset' is.
+bitset_t bitset_copy(const bitset_t *bitset);
+void bitset_resize(bitset_t *bitset, sz bits_num);
+void bitset_clear(bitset_t *bitset);
+
+// The set operations store their result in `dst' and return whether it
+// changed, which is what a dataflow fixed point iterates on.
+b8 bitset_union(bitset_t *dst, const bitset_t *src);
+b8 bitset_intersect(bitset_t *dst, const bitset_t *src);
+b8 bitset_difference(bitset_t *dst, const bitset_t *src);
+
+sz bitset_count(const bitset_t *bitset);
+b8 bitset_equals(const bitset_t *a, const bitset_t *b);
+// The first set bit at or after `from', `bits_num' if there is none.
+sz bitset_next(const bitset_t *bitset, sz from);
+void bitset_foreach(const bitset_t *bitset,
+                    bitset_foreach_function_t foreach_function, void *ctx);
+
+void __bitset_grow(bitset_t *bitset, sz bits_num);
+
+static inline void bitset_set(bitset_t *bitset, sz bit)
+{
+  SOLC_ASSUME(bitset != nullptr);
+  if SOLC_UNLIKELY (bit >= bitset->bits_num)
+    __bitset_grow(bitset, bit + 1);
+  bitset->words[bit / BITSET_WORD_BITS] |= 1ULL << (bit % BITSET_WORD_BITS);
+}
+
+static inline void bitset_unset(bitset_t *bitset, sz bit)
+{
+  SOLC_ASSUME(bitset != nullptr);
+  if SOLC_UNLIKELY (bit >= bitset->bits_num) {
+    SOLC_ASSERT(bitset->is_growable);
+    return;
+  }
+  bitset->words[bit / BITSET_WORD_BITS] &= ~(1ULL << (bit % BITSET_WORD_BITS));
+}
+
+static inline b8 bitset_test(const bitset_t *bitset, sz bit)
+{
+  SOLC_ASSUME(bitset != nullptr);
+  if SOLC_UNLIKELY (bit >= bitset->bits_num) {
+    SOLC_ASSERT(bitset->is_growable);
+    return false;
+  }
+  return (bitset->words[bit / BITSET_WORD_BITS] >> (bit % BITSET_WORD_BITS)) &
+         1;
+}
+
+#endif // __SOLC_CONTAINER_BITSET_H__
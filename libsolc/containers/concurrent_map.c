@@ -0,0 +1,158 @@
+// `pthread_rwlock_t' is hidden by a strict `-std=c11'.
+#define _DEFAULT_SOURCE
+
+#include "containers/concurrent_map.h"
+#include "allocs/alloc_arena.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
+#include "solc/defs.h"
+#include <pthread.h>
+#include <string.h>
+
+#define CM_ALLOC(_size) alloc_heap_malloc(SOLC_MEM_TAG_HASHTABLE, (_size))
+#define CM_CACHE_LINE 64
+#define CM_SHARD_BODY_SIZE \
+  ((sizeof(cm_shard_body_t) + CM_CACHE_LINE - 1) & ~(sz)(CM_CACHE_LINE - 1))
+
+typedef struct {
+  pthread_rwlock_t lock;
+  // Maps keys to their value copies in `arena'.
+  hashtable_t *table;
+  alloc_arena_t arena;
+} cm_shard_body_t;
+
+// Shards are padded to whole cache lines so that locking one does not
+// invalidate its neighbours.
+typedef union {
+  cm_shard_body_t body;
+  u8 padding[CM_SHARD_BODY_SIZE];
+} cm_shard_t;
+
+typedef struct __concurrent_map_t {
+  cm_shard_t shards[CONCURRENT_MAP_SHARDS];
+
+  sz value_size;
+  sz value_alignment;
+  hash_function_t hash_function;
+} concurrent_map_t;
+
+static inline cm_shard_body_t *cm_get_shard(concurrent_map_t *map,
+                                            hash_t hash);
+static inline void *cm_find(cm_shard_body_t *shard, const void *key,
+                            hash_t hash);
+
+concurrent_map_t *__concurrent_map_create_impl(
+  sz key_size, sz value_size, sz value_alignment, hash_function_t hash_function,
+  size_policy_t key_size_policy, get_size_function_t get_key_size_function,
+  compare_function_t key_compare_function)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(hash_function != nullptr && value_size > 0);
+
+  concurrent_map_t *out_map = CM_ALLOC(sizeof(concurrent_map_t));
+  out_map->value_size = value_size;
+  out_map->value_alignment = value_alignment;
+  out_map->hash_function = hash_function;
+
+  for (sz i = 0; i < CONCURRENT_MAP_SHARDS; i++) {
+    cm_shard_body_t *shard = &out_map->shards[i].body;
+    SOLC_ASSERT(pthread_rwlock_init(&shard->lock, nullptr) == 0);
+    shard->arena = alloc_arena_create();
+    shard->table = __hashtable_create_impl(
+      key_size, sizeof(void *), hash_function, key_size_policy,
+      SIZE_POLICY_FIXED, get_key_size_function, nullptr, key_compare_function,
+      &shard->arena);
+  }
+
+  return out_map;
+}
+
+void concurrent_map_destroy(concurrent_map_t *map)
+{
+  SOLC_ASSUME(map != nullptr);
+
+  for (sz i = 0; i < CONCURRENT_MAP_SHARDS; i++) {
+    cm_shard_body_t *shard = &map->shards[i].body;
+    hashtable_destroy(shard->table);
+    alloc_arena_destroy(&shard->arena);
+    pthread_rwlock_destroy(&shard->lock);
+  }
+  alloc_heap_free(map);
+}
+
+sz concurrent_map_get_size(concurrent_map_t *map)
+{
+  SOLC_ASSUME(map != nullptr);
+
+  sz size = 0;
+  for (sz i = 0; i < CONCURRENT_MAP_SHARDS; i++) {
+    cm_shard_body_t *shard = &map->shards[i].body;
+    pthread_rwlock_rdlock(&shard->lock);
+    size += hashtable_get_size(shard->table);
+    pthread_rwlock_unlock(&shard->lock);
+  }
+  return size;
+}
+
+void *__concurrent_map_get_impl(concurrent_map_t *map, const void *key)
+{
+  SOLC_ASSUME(map != nullptr && key != nullptr);
+
+  const hash_t hash = map->hash_function(key);
+  cm_shard_body_t *shard = cm_get_shard(map, hash);
+  pthread_rwlock_rdlock(&shard->lock);
+  void *value = cm_find(shard, key, hash);
+  pthread_rwlock_unlock(&shard->lock);
+  return value;
+}
+
+void *__concurrent_map_get_or_insert_impl(concurrent_map_t *map,
+                                          const void *key, const void *value,
+                                          b8 *out_inserted)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(map != nullptr && key != nullptr && value != nullptr);
+
+  const hash_t hash = map->hash_function(key);
+  cm_shard_body_t *shard = cm_get_shard(map, hash);
+  pthread_rwlock_rdlock(&shard->lock);
+  void *out_value = cm_find(shard, key, hash);
+  pthread_rwlock_unlock(&shard->lock);
+
+  // Another thread may insert the key between the two locks, so it is looked
+  // up again before anything is copied.
+  b8 inserted = false;
+  if SOLC_UNLIKELY (out_value == nullptr) {
+    pthread_rwlock_wrlock(&shard->lock);
+    out_value = cm_find(shard, key, hash);
+    if (out_value == nullptr) {
+      out_value = alloc_arena_allocate_aligned(&shard->arena, map->value_size,
+                                               map->value_alignment);
+      memcpy(out_value, value, map->value_size);
+      shard->table =
+        __hashtable_put_hashed_impl(shard->table, key, hash, &out_value);
+      inserted = true;
+    }
+    pthread_rwlock_unlock(&shard->lock);
+  }
+
+  if (out_inserted != nullptr)
+    *out_inserted = inserted;
+  return out_value;
+}
+
+// The top bits of a multiplicative hash pick the shard, the tables inside
+// probe with the low bits of the plain one.
+static inline cm_shard_body_t *cm_get_shard(concurrent_map_t *map,
+                                            hash_t hash)
+{
+  const u64 mixed = (u64)hash * 0x9E3779B97F4A7C15ULL;
+  return &map->shards[mixed >> (64 - CONCURRENT_MAP_SHARD_BITS)].body;
+}
+
+static inline void *cm_find(cm_shard_body_t *shard, const void *key,
+                            hash_t hash)
+{
+  void *const *slot = __hashtable_get_hashed_impl(shard->table, key, hash);
+  return slot != nullptr ? *slot : nullptr;
+}
@@ -0,0 +1,64 @@
+#ifndef __SOLC_CONTAINER_CONCURRENT_MAP_H__
+#define __SOLC_CONTAINER_CONCURRENT_MAP_H__
+
+#include "containers/hashtable.h"
+#include "solc/defs.h"
+
+#include "hash.h"
+#include "types.h"
+
+// A map shared between threads, split into `CONCURRENT_MAP_SHARDS' shards
+// that each have their own lock, table and arena. Entries are never removed
+// and values are copied into the shard's arena, so the address returned for a
+// key stays the same until the map is destroyed, no matter how the tables
+// grow:
+//
+//   concurrent_map_t *interner;
+//   concurrent_map_create(interner, const char *, u32);
+//
+//   b8 inserted;
+//   u32 *id = concurrent_map_get_or_insert(interner, name, next_id, &inserted);
+//
+// Keys follow `hashtable_t', strings are copied. Values have a fixed size and
+// the map does not synchronize writes to them, only their insertion.
+typedef struct __concurrent_map_t concurrent_map_t;
+
+#define CONCURRENT_MAP_SHARD_BITS 6
+#define CONCURRENT_MAP_SHARDS (1 << CONCURRENT_MAP_SHARD_BITS)
+
+#define concurrent_map_create(_map_ptr, _key_type, _value_type)          \
+  {                                                                      \
+    _key_type __concurrent_map_phantom_key__;                            \
+    (_map_ptr) = __concurrent_map_create_impl(                           \
+      sizeof(_key_type), sizeof(_value_type), _Alignof(_value_type),     \
+      get_default_hash_function(__concurrent_map_phantom_key__),         \
+      get_default_size_policy(__concurrent_map_phantom_key__),           \
+      get_default_get_size_function(__concurrent_map_phantom_key__),     \
+      get_default_key_compare_function(__concurrent_map_phantom_key__)); \
+  }
+
+// Returns the value of `_key' or `nullptr'.
+#define concurrent_map_get(_map, _key) \
+  __concurrent_map_get_impl((_map), __hashtable_arg_macro((_key)))
+
+// Returns the value of `_key', inserting a copy of `_value' first if there is
+// none. `*_out_inserted' (unless `nullptr') tells which thread's value won.
+#define concurrent_map_get_or_insert(_map, _key, _value, _out_inserted) \
+  __concurrent_map_get_or_insert_impl((_map),                           \
+                                      __hashtable_arg_macro((_key)),    \
+                                      &(_value), (_out_inserted))
+
+void concurrent_map_destroy(concurrent_map_t *map);
+// Only exact while no other thread inserts.
+sz concurrent_map_get_size(concurrent_map_t *map);
+
+concurrent_map_t *__concurrent_map_create_impl(
+  sz key_size, sz value_size, sz value_alignment, hash_function_t hash_function,
+  size_policy_t key_size_policy, get_size_function_t get_key_size_function,
+  compare_function_t key_compare_function);
+void *__concurrent_map_get_impl(concurrent_map_t *map, const void *key);
+void *__concurrent_map_get_or_insert_impl(concurrent_map_t *map,
+                                          const void *key, const void *value,
+                                          b8 *out_inserted);
+
+#endif // __SOLC_CONTAINER_CONCURRENT_MAP_H__
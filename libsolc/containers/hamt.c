@@ -0,0 +1,433 @@
+#include "containers/hamt.h"
+#include "allocs/alloc_arena.h"
+#include "allocs/alloc_trace.h"
+#include "solc/defs.h"
+#include <string.h>
+
+// Every level consumes `HAMT_BITS' bits of the hash. Keys whose hashes are
+// equal down to the last bit end up in a collision node, a plain list.
+#define HAMT_BITS 5
+#define HAMT_MASK ((1U << HAMT_BITS) - 1)
+#define HAMT_HASH_BITS (sizeof(hash_t) * 8)
+
+typedef struct {
+  hash_t hash;
+  const void *key;
+  void *value;
+} hamt_entry_t;
+
+// Slots holding an entry are set in `datamap', slots holding a child in
+// `nodemap'. The node stores the entries in slot order, followed by the
+// children. Collision nodes have no slots, `datamap' counts their entries.
+typedef struct __hamt_node_t {
+  u32 datamap;
+  u32 nodemap;
+  hamt_entry_t entries[];
+} hamt_node_t;
+
+static inline b8 hamt_is_collision(u32 shift);
+static inline u32 hamt_slot_bit(hash_t hash, u32 shift);
+static inline u32 hamt_index(u32 map, u32 bit);
+static inline u32 hamt_entries_num(const hamt_node_t *node, u32 shift);
+static inline u32 hamt_children_num(const hamt_node_t *node);
+static inline hamt_node_t **hamt_children(const hamt_node_t *node, u32 shift);
+static inline b8 hamt_is_single_entry(const hamt_node_t *node, u32 shift);
+static inline b8 hamt_key_equals(const hamt_t *map, const hamt_entry_t *entry,
+                                 hash_t hash, const void *key);
+
+static hamt_node_t *hamt_node_alloc(hamt_t *map, u32 entries_num,
+                                    u32 children_num);
+static hamt_node_t *hamt_node_copy(hamt_t *map, const hamt_node_t *node,
+                                   u32 shift);
+static hamt_node_t *hamt_node_merge(hamt_t *map, const hamt_entry_t *a,
+                                    const hamt_entry_t *b, u32 shift);
+static hamt_node_t *hamt_put_node(hamt_t *map, const hamt_node_t *node,
+                                  u32 shift, const hamt_entry_t *entry,
+                                  b8 *out_added);
+static hamt_node_t *hamt_remove_node(hamt_t *map, hamt_node_t *node, u32 shift,
+                                     hash_t hash, const void *key,
+                                     b8 *out_removed);
+static void hamt_foreach_node(const hamt_node_t *node, u32 shift,
+                              hamt_foreach_function_t foreach_function,
+                              void *ctx);
+
+hamt_t hamt_create(alloc_arena_t *arena, hash_function_t hash_function,
+                   compare_function_t key_compare_function)
+{
+  SOLC_ASSUME(arena != nullptr && hash_function != nullptr);
+  return (hamt_t){
+    .root = nullptr,
+    .size = 0,
+    .hash_function = hash_function,
+    .key_compare_function = key_compare_function,
+    .arena = arena,
+  };
+}
+
+void *hamt_get(const hamt_t *map, const void *key)
+{
+  SOLC_ASSUME(map != nullptr);
+
+  const hash_t hash = map->hash_function(key);
+  const hamt_node_t *node = map->root;
+  for (u32 shift = 0; node != nullptr; shift += HAMT_BITS) {
+    if SOLC_UNLIKELY (hamt_is_collision(shift)) {
+      for (u32 i = 0; i < node->datamap; i++)
+        if (hamt_key_equals(map, &node->entries[i], hash, key))
+          return node->entries[i].value;
+      return nullptr;
+    }
+
+    const u32 bit = hamt_slot_bit(hash, shift);
+    if (node->datamap & bit) {
+      const hamt_entry_t *entry =
+        &node->entries[hamt_index(node->datamap, bit)];
+      return hamt_key_equals(map, entry, hash, key) ? entry->value : nullptr;
+    }
+    if (!(node->nodemap & bit))
+      return nullptr;
+
+    node = hamt_children(node, shift)[hamt_index(node->nodemap, bit)];
+  }
+  return nullptr;
+}
+
+void hamt_put(hamt_t *map, const void *key, void *value)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(map != nullptr);
+
+  const hamt_entry_t entry = {
+    .hash = map->hash_function(key),
+    .key = key,
+    .value = value,
+  };
+
+  if (map->root == nullptr) {
+    map->root = hamt_node_alloc(map, 1, 0);
+    map->root->datamap = hamt_slot_bit(entry.hash, 0);
+    map->root->nodemap = 0;
+    map->root->entries[0] = entry;
+    map->size = 1;
+    return;
+  }
+
+  b8 added = false;
+  map->root = hamt_put_node(map, map->root, 0, &entry, &added);
+  map->size += added;
+}
+
+b8 hamt_remove(hamt_t *map, const void *key)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(map != nullptr);
+
+  if (map->root == nullptr)
+    return false;
+
+  b8 removed = false;
+  map->root = hamt_remove_node(map, map->root, 0, map->hash_function(key), key,
+                               &removed);
+  map->size -= removed;
+  return removed;
+}
+
+sz hamt_get_size(const hamt_t *map)
+{
+  SOLC_ASSUME(map != nullptr);
+  return map->size;
+}
+
+void hamt_foreach(const hamt_t *map, hamt_foreach_function_t foreach_function,
+                  void *ctx)
+{
+  SOLC_ASSUME(map != nullptr && foreach_function != nullptr);
+  if (map->root != nullptr)
+    hamt_foreach_node(map->root, 0, foreach_function, ctx);
+}
+
+static inline b8 hamt_is_collision(u32 shift)
+{
+  return shift >= HAMT_HASH_BITS;
+}
+
+static inline u32 hamt_slot_bit(hash_t hash, u32 shift)
+{
+  return 1U << ((hash >> shift) & HAMT_MASK);
+}
+
+// Position of the slot `bit' among the slots set in `map'.
+static inline u32 hamt_index(u32 map, u32 bit)
+{
+  return (u32)__builtin_popcount(map & (bit - 1));
+}
+
+static inline u32 hamt_entries_num(const hamt_node_t *node, u32 shift)
+{
+  return hamt_is_collision(shift) ? node->datamap :
+                                    (u32)__builtin_popcount(node->datamap);
+}
+
+static inline u32 hamt_children_num(const hamt_node_t *node)
+{
+  return (u32)__builtin_popcount(node->nodemap);
+}
+
+static inline hamt_node_t **hamt_children(const hamt_node_t *node, u32 shift)
+{
+  return (hamt_node_t **)&node->entries[hamt_entries_num(node, shift)];
+}
+
+// Such a node is folded into its parent, so every other non-root node holds at
+// least two entries or a child and each map has a single shape.
+static inline b8 hamt_is_single_entry(const hamt_node_t *node, u32 shift)
+{
+  return hamt_entries_num(node, shift) == 1 && hamt_children_num(node) == 0;
+}
+
+static inline b8 hamt_key_equals(const hamt_t *map, const hamt_entry_t *entry,
+                                 hash_t hash, const void *key)
+{
+  if (entry->hash != hash)
+    return false;
+  if (entry->key == key)
+    return true;
+  return map->key_compare_function != nullptr &&
+         map->key_compare_function(entry->key, key);
+}
+
+static hamt_node_t *hamt_node_alloc(hamt_t *map, u32 entries_num,
+                                    u32 children_num)
+{
+  return alloc_arena_allocate_aligned(
+    map->arena,
+    sizeof(hamt_node_t) + entries_num * sizeof(hamt_entry_t) +
+      children_num * sizeof(hamt_node_t *),
+    _Alignof(hamt_node_t));
+}
+
+static hamt_node_t *hamt_node_copy(hamt_t *map, const hamt_node_t *node,
+                                   u32 shift)
+{
+  const u32 entries_num = hamt_entries_num(node, shift);
+  const u32 children_num = hamt_children_num(node);
+  hamt_node_t *out_node = hamt_node_alloc(map, entries_num, children_num);
+  memcpy(out_node, node,
+         sizeof(hamt_node_t) + entries_num * sizeof(hamt_entry_t) +
+           children_num * sizeof(hamt_node_t *));
+  return out_node;
+}
+
+// A node holding only `a' and `b', whose slots collided one level up.
+static hamt_node_t *hamt_node_merge(hamt_t *map, const hamt_entry_t *a,
+                                    const hamt_entry_t *b, u32 shift)
+{
+  if SOLC_UNLIKELY (hamt_is_collision(shift)) {
+    hamt_node_t *out_node = hamt_node_alloc(map, 2, 0);
+    out_node->datamap = 2;
+    out_node->nodemap = 0;
+    out_node->entries[0] = *a;
+    out_node->entries[1] = *b;
+    return out_node;
+  }
+
+  const u32 bit_a = hamt_slot_bit(a->hash, shift);
+  const u32 bit_b = hamt_slot_bit(b->hash, shift);
+  if (bit_a == bit_b) {
+    hamt_node_t *out_node = hamt_node_alloc(map, 0, 1);
+    out_node->datamap = 0;
+    out_node->nodemap = bit_a;
+    hamt_children(out_node, shift)[0] =
+      hamt_node_merge(map, a, b, shift + HAMT_BITS);
+    return out_node;
+  }
+
+  hamt_node_t *out_node = hamt_node_alloc(map, 2, 0);
+  out_node->datamap = bit_a | bit_b;
+  out_node->nodemap = 0;
+  out_node->entries[bit_a < bit_b ? 0 : 1] = *a;
+  out_node->entries[bit_a < bit_b ? 1 : 0] = *b;
+  return out_node;
+}
+
+static hamt_node_t *hamt_put_node(hamt_t *map, const hamt_node_t *node,
+                                  u32 shift, const hamt_entry_t *entry,
+                                  b8 *out_added)
+{
+  if SOLC_UNLIKELY (hamt_is_collision(shift)) {
+    for (u32 i = 0; i < node->datamap; i++) {
+      if (!hamt_key_equals(map, &node->entries[i], entry->hash, entry->key))
+        continue;
+
+      hamt_node_t *out_node = hamt_node_copy(map, node, shift);
+      out_node->entries[i].value = entry->value;
+      return out_node;
+    }
+
+    hamt_node_t *out_node = hamt_node_alloc(map, node->datamap + 1, 0);
+    out_node->datamap = node->datamap + 1;
+    out_node->nodemap = 0;
+    memcpy(out_node->entries, node->entries,
+           node->datamap * sizeof(hamt_entry_t));
+    out_node->entries[node->datamap] = *entry;
+    *out_added = true;
+    return out_node;
+  }
+
+  const u32 bit = hamt_slot_bit(entry->hash, shift);
+  const u32 entries_num = hamt_entries_num(node, shift);
+  const u32 children_num = hamt_children_num(node);
+  hamt_node_t *const *children = hamt_children(node, shift);
+
+  if (node->nodemap & bit) {
+    const u32 child_index = hamt_index(node->nodemap, bit);
+    hamt_node_t *child = hamt_put_node(map, children[child_index],
+                                       shift + HAMT_BITS, entry, out_added);
+    if (child == children[child_index])
+      return (hamt_node_t *)node;
+
+    hamt_node_t *out_node = hamt_node_copy(map, node, shift);
+    hamt_children(out_node, shift)[child_index] = child;
+    return out_node;
+  }
+
+  const u32 index = hamt_index(node->datamap, bit);
+  if (!(node->datamap & bit)) {
+    hamt_node_t *out_node = hamt_node_alloc(map, entries_num + 1, children_num);
+    out_node->datamap = node->datamap | bit;
+    out_node->nodemap = node->nodemap;
+    memcpy(out_node->entries, node->entries, index * sizeof(hamt_entry_t));
+    out_node->entries[index] = *entry;
+    memcpy(&out_node->entries[index + 1], &node->entries[index],
+           (entries_num - index) * sizeof(hamt_entry_t));
+    memcpy(hamt_children(out_node, shift), children,
+           children_num * sizeof(hamt_node_t *));
+    *out_added = true;
+    return out_node;
+  }
+
+  const hamt_entry_t *old_entry = &node->entries[index];
+  if (hamt_key_equals(map, old_entry, entry->hash, entry->key)) {
+    if (old_entry->value == entry->value)
+      return (hamt_node_t *)node;
+
+    hamt_node_t *out_node = hamt_node_copy(map, node, shift);
+    out_node->entries[index].value = entry->value;
+    return out_node;
+  }
+
+  // The slot is taken by another key, both move one level down.
+  hamt_node_t *child =
+    hamt_node_merge(map, old_entry, entry, shift + HAMT_BITS);
+  const u32 child_index = hamt_index(node->nodemap, bit);
+  hamt_node_t *out_node =
+    hamt_node_alloc(map, entries_num - 1, children_num + 1);
+  out_node->datamap = node->datamap & ~bit;
+  out_node->nodemap = node->nodemap | bit;
+  memcpy(out_node->entries, node->entries, index * sizeof(hamt_entry_t));
+  memcpy(&out_node->entries[index], &node->entries[index + 1],
+         (entries_num - index - 1) * sizeof(hamt_entry_t));
+
+  hamt_node_t **out_children = hamt_children(out_node, shift);
+  memcpy(out_children, children, child_index * sizeof(hamt_node_t *));
+  out_children[child_index] = child;
+  memcpy(&out_children[child_index + 1], &children[child_index],
+         (children_num - child_index) * sizeof(hamt_node_t *));
+  *out_added = true;
+  return out_node;
+}
+
+// Returns `nullptr' once the node is empty, which only the root can become.
+static hamt_node_t *hamt_remove_node(hamt_t *map, hamt_node_t *node, u32 shift,
+                                     hash_t hash, const void *key,
+                                     b8 *out_removed)
+{
+  if SOLC_UNLIKELY (hamt_is_collision(shift)) {
+    for (u32 i = 0; i < node->datamap; i++) {
+      if (!hamt_key_equals(map, &node->entries[i], hash, key))
+        continue;
+
+      hamt_node_t *out_node = hamt_node_alloc(map, node->datamap - 1, 0);
+      out_node->datamap = node->datamap - 1;
+      out_node->nodemap = 0;
+      memcpy(out_node->entries, node->entries, i * sizeof(hamt_entry_t));
+      memcpy(&out_node->entries[i], &node->entries[i + 1],
+             (node->datamap - i - 1) * sizeof(hamt_entry_t));
+      *out_removed = true;
+      return out_node;
+    }
+    return node;
+  }
+
+  const u32 bit = hamt_slot_bit(hash, shift);
+  const u32 entries_num = hamt_entries_num(node, shift);
+  const u32 children_num = hamt_children_num(node);
+  hamt_node_t *const *children = hamt_children(node, shift);
+
+  if (node->datamap & bit) {
+    const u32 index = hamt_index(node->datamap, bit);
+    if (!hamt_key_equals(map, &node->entries[index], hash, key))
+      return node;
+
+    *out_removed = true;
+    if (entries_num == 1 && children_num == 0)
+      return nullptr;
+
+    hamt_node_t *out_node = hamt_node_alloc(map, entries_num - 1, children_num);
+    out_node->datamap = node->datamap & ~bit;
+    out_node->nodemap = node->nodemap;
+    memcpy(out_node->entries, node->entries, index * sizeof(hamt_entry_t));
+    memcpy(&out_node->entries[index], &node->entries[index + 1],
+           (entries_num - index - 1) * sizeof(hamt_entry_t));
+    memcpy(hamt_children(out_node, shift), children,
+           children_num * sizeof(hamt_node_t *));
+    return out_node;
+  }
+
+  if (!(node->nodemap & bit))
+    return node;
+
+  const u32 child_index = hamt_index(node->nodemap, bit);
+  hamt_node_t *child =
+    hamt_remove_node(map, children[child_index], shift + HAMT_BITS, hash, key,
+                     out_removed);
+  if (child == children[child_index])
+    return node;
+
+  if (!hamt_is_single_entry(child, shift + HAMT_BITS)) {
+    hamt_node_t *out_node = hamt_node_copy(map, node, shift);
+    hamt_children(out_node, shift)[child_index] = child;
+    return out_node;
+  }
+
+  // The child's last entry moves up into the slot the child took.
+  const u32 index = hamt_index(node->datamap, bit);
+  hamt_node_t *out_node =
+    hamt_node_alloc(map, entries_num + 1, children_num - 1);
+  out_node->datamap = node->datamap | bit;
+  out_node->nodemap = node->nodemap & ~bit;
+  memcpy(out_node->entries, node->entries, index * sizeof(hamt_entry_t));
+  out_node->entries[index] = child->entries[0];
+  memcpy(&out_node->entries[index + 1], &node->entries[index],
+         (entries_num - index) * sizeof(hamt_entry_t));
+
+  hamt_node_t **out_children = hamt_children(out_node, shift);
+  memcpy(out_children, children, child_index * sizeof(hamt_node_t *));
+  memcpy(&out_children[child_index], &children[child_index + 1],
+         (children_num - child_index - 1) * sizeof(hamt_node_t *));
+  return out_node;
+}
+
+static void hamt_foreach_node(const hamt_node_t *node, u32 shift,
+                              hamt_foreach_function_t foreach_function,
+                              void *ctx)
+{
+  const u32 entries_num = hamt_entries_num(node, shift);
+  for (u32 i = 0; i < entries_num; i++)
+    foreach_function(node->entries[i].key, node->entries[i].value, ctx);
+
+  hamt_node_t *const *children = hamt_children(node, shift);
+  for (u32 i = 0, children_num = hamt_children_num(node); i < children_num;
+       i++)
+    hamt_foreach_node(children[i], shift + HAMT_BITS, foreach_function, ctx);
+}
@@ -0,0 +1,55 @@
+#ifndef __SOLC_CONTAINER_HAMT_H__
+#define __SOLC_CONTAINER_HAMT_H__
+
+#include "allocs/alloc_arena.h"
+#include "solc/defs.h"
+
+#include "hash.h"
+#include "types.h"
+
+// A persistent hash array mapped trie. Changing a map copies only the path
+// from the root to the changed entry and shares every other node, so taking a
+// snapshot is copying the `hamt_t' itself. This suits scopes, a nested scope
+// starts from a snapshot of the enclosing one and dropping it restores the
+// outer state:
+//
+//   hamt_t scope = hamt_create(arena, hash_function_cstr,
+//                              key_compare_function_cstr);
+//   hamt_put(&scope, "x", outer_x);
+//
+//   hamt_t inner = hamt_snapshot(&scope);
+//   hamt_put(&inner, "x", inner_x); // `scope' still maps "x" to `outer_x'.
+//
+// Keys and values are pointers the map does not own. Nodes live in `arena'
+// and are only freed with it, since older snapshots may still use them.
+typedef struct __hamt_node_t hamt_node_t;
+
+typedef struct {
+  hamt_node_t *root;
+  sz size;
+  hash_function_t hash_function;
+  // `nullptr' compares keys by address, e.g. for interned names.
+  compare_function_t key_compare_function;
+  alloc_arena_t *arena;
+} hamt_t;
+
+typedef void (*hamt_foreach_function_t)(const void *key, void *value,
+                                        void *ctx);
+
+hamt_t hamt_create(alloc_arena_t *arena, hash_function_t hash_function,
+                   compare_function_t key_compare_function);
+
+static inline hamt_t hamt_snapshot(const hamt_t *map)
+{
+  return *map;
+}
+
+void *hamt_get(const hamt_t *map, const void *key);
+// Inserts or overwrites, snapshots taken before are left as they were.
+void hamt_put(hamt_t *map, const void *key, void *value);
+b8 hamt_remove(hamt_t *map, const void *key);
+sz hamt_get_size(const hamt_t *map);
+void hamt_foreach(const hamt_t *map, hamt_foreach_function_t foreach_function,
+                  void *ctx);
+
+#endif // __SOLC_CONTAINER_HAMT_H__
@@ -1,4 +1,7 @@
 #include "containers/hashset.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
+#include "containers/swiss_group.h"
 #include "hash.h"
 #include "solc/defs.h"
 #include "types.h"
@@ -6,15 +9,18 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define HS_MAX_LOAD_FACTOR 0.65f
+#define HS_ALLOC(_size) alloc_heap_malloc(SOLC_MEM_TAG_HASHSET, (_size))
 #define HS_INITIAL_SIZE 128
 #define HS_RESIZE_FACTOR 2
+// Variable-size keys are strings or pointer aligned records.
+#define HS_STORAGE_ALIGNMENT sizeof(void *)
 
-typedef u8 hs_ctrl_t;
-typedef enum {
-  HS_CTRL_FLAG_EMPTY = 0b10000000,
-  HS_CTRL_FLAG_DELETED = 0b11111111,
-} hs_ctrl_flags_t;
+// Capacities are powers of two, so every probe step is a mask.
+_Static_assert((HS_INITIAL_SIZE & (HS_INITIAL_SIZE - 1)) == 0 &&
+                 HS_INITIAL_SIZE >= SWISS_GROUP_WIDTH,
+               "HS_INITIAL_SIZE must be a power of two of whole groups");
+
+typedef swiss_ctrl_t hs_ctrl_t;
 
 typedef struct __hashset_t {
   hs_ctrl_t *ctrl;
@@ -22,12 +28,14 @@ typedef struct __hashset_t {
 
   sz size;
   sz filled;
+  sz deleted;
 
   sz key_size;
 
   hash_function_t hash_function;
   get_size_function_t get_key_size_function;
   compare_function_t key_compare_function;
+  alloc_arena_t *storage_arena;
 
   size_policy_t key_size_policy;
 } hashset_t;
@@ -35,8 +43,19 @@ typedef struct __hashset_t {
 static inline hash_t hs_h1(hash_t hash);
 static inline hash_t hs_h2(hash_t hash);
 static inline b8 hs_ctrl_flag_is_present(hs_ctrl_t ctrl);
-static hashset_t *hs_resize_and_rehash(hashset_t *set);
+static inline b8 hs_find(hashset_t *set, const void *key, hash_t hash,
+                         sz *out_pos);
+static inline sz hs_find_free(hashset_t *set, hash_t hash);
+static inline b8 hs_key_equals(hashset_t *set, sz pos, const void *key);
+static inline sz hs_max_filled(sz size);
+static void hs_rehash(hashset_t *set);
+static void hs_rehash_in_place(hashset_t *set);
+static void hs_grow(hashset_t *set, sz new_size);
+static inline hash_t hs_hash_slot(hashset_t *set, sz pos);
+static void hs_swap_bytes(void *a, void *b, sz n);
 static inline void *hs_get_key_slot_addr(hashset_t *set, sz pos);
+static inline const void *hs_get_key(hashset_t *set, sz pos);
+static void hs_free_keys(hashset_t *set);
 static void hs_set_key(hashset_t *set, sz pos, const void *key);
 
 #define CTRL_BLOCK_SIZE(_size) (sizeof(hs_ctrl_t) * (_size))
@@ -47,29 +66,33 @@ static void hs_set_key(hashset_t *set, sz pos, const void *key);
 hashset_t *__hashset_create_impl(sz key_size, hash_function_t hash_function,
                                  size_policy_t key_size_policy,
                                  get_size_function_t get_key_size_function,
-                                 compare_function_t key_compare_function)
+                                 compare_function_t key_compare_function,
+                                 alloc_arena_t *storage_arena)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(hash_function != nullptr);
 
-  hashset_t *out_set = malloc(sizeof(hashset_t));
+  hashset_t *out_set = HS_ALLOC(sizeof(hashset_t));
 
   if (key_size_policy == SIZE_POLICY_VARIABLE)
     key_size = sizeof(void *);
 
-  void *block = malloc(FULL_BLOCK_SIZE(key_size, HS_INITIAL_SIZE));
+  void *block = HS_ALLOC(FULL_BLOCK_SIZE(key_size, HS_INITIAL_SIZE));
 
   out_set->ctrl = block;
-  memset(out_set->ctrl, HS_CTRL_FLAG_EMPTY, CTRL_BLOCK_SIZE(HS_INITIAL_SIZE));
+  memset(out_set->ctrl, SWISS_CTRL_EMPTY, CTRL_BLOCK_SIZE(HS_INITIAL_SIZE));
 
   out_set->key_slots = (char *)block + CTRL_BLOCK_SIZE(HS_INITIAL_SIZE);
   memset(out_set->key_slots, 0, KEY_BLOCK_SIZE(key_size, HS_INITIAL_SIZE));
 
   out_set->size = HS_INITIAL_SIZE;
   out_set->filled = 0;
+  out_set->deleted = 0;
   out_set->key_size = key_size;
   out_set->hash_function = hash_function;
   out_set->get_key_size_function = get_key_size_function;
   out_set->key_compare_function = key_compare_function;
+  out_set->storage_arena = storage_arena;
   out_set->key_size_policy = key_size_policy;
 
   return out_set;
@@ -79,133 +102,71 @@ void hashset_destroy(hashset_t *set)
 {
   SOLC_ASSUME(set != nullptr);
 
-  if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
-    for (sz i = 0; i < set->size; i++) {
-      if (hs_ctrl_flag_is_present(set->ctrl[i]))
-        continue;
-
-      void *key = hs_get_key_slot_addr(set, i);
-      key = *(void **)key;
-      free(key);
-    }
-  }
-
-  free(set->ctrl);
-  free(set);
+  hs_free_keys(set);
+  alloc_heap_free(set->ctrl);
+  alloc_heap_free(set);
 }
 
 hashset_t *__hashset_set_impl(hashset_t *set, const void *key)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(set != nullptr && key != nullptr);
 
   hash_t hash = set->hash_function(key);
-  sz pos = hs_h1(hash) % set->size;
-  hs_ctrl_t h2 = hs_h2(hash);
-
-  while (1) {
-    if (h2 == set->ctrl[pos]) {
-      void *slot_key = hs_get_key_slot_addr(set, pos);
-      if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
-        if SOLC_UNLIKELY (set->key_compare_function == nullptr)
-          SOLC_NOREACH();
-
-        slot_key = *(void **)slot_key;
-        SOLC_ASSUME(slot_key != nullptr);
-
-        if SOLC_LIKELY (set->key_compare_function(key, slot_key)) {
-          return set;
-        }
-      } else if SOLC_LIKELY (memcmp(key, slot_key, set->key_size) == 0) {
-        return set;
-      }
-    }
+  sz pos;
+  if (hs_find(set, key, hash, &pos))
+    return set;
 
-    if (hs_ctrl_flag_is_present(set->ctrl[pos])) {
-      hs_set_key(set, pos, key);
+  pos = hs_find_free(set, hash);
+  hs_set_key(set, pos, key);
 
-      set->ctrl[pos] = h2;
-      set->filled++;
+  if (set->ctrl[pos] == SWISS_CTRL_DELETED)
+    set->deleted--;
+  set->ctrl[pos] = hs_h2(hash);
+  set->filled++;
 
-      float load_factor = (float)set->filled / set->size;
-      if SOLC_UNLIKELY (load_factor > HS_MAX_LOAD_FACTOR) {
-        set = hs_resize_and_rehash(set);
-      }
+  if SOLC_UNLIKELY (set->filled + set->deleted > hs_max_filled(set->size))
+    hs_rehash(set);
 
-      return set;
-    }
-
-    pos = (pos + 1) % set->size;
-  }
+  // The set is rehashed in place, callers may keep using their pointer.
+  return set;
 }
 
 b8 __hashset_is_set_impl(hashset_t *set, const void *key)
 {
   SOLC_ASSUME(set != nullptr && key != nullptr);
 
-  hash_t hash = set->hash_function(key);
-  sz pos = hs_h1(hash) % set->size;
-  hs_ctrl_t h2 = hs_h2(hash);
-
-  while (1) {
-    if (h2 == set->ctrl[pos]) {
-      void *slot_key = hs_get_key_slot_addr(set, pos);
-      if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
-        if SOLC_UNLIKELY (set->key_compare_function == nullptr)
-          SOLC_NOREACH();
-
-        slot_key = *(void **)slot_key;
-        SOLC_ASSUME(slot_key != nullptr);
-
-        if SOLC_LIKELY (set->key_compare_function(key, slot_key)) {
-          return true;
-        }
-      } else if SOLC_LIKELY (memcmp(key, slot_key, set->key_size) == 0) {
-        return true;
-      }
-    }
-
-    if SOLC_UNLIKELY (set->ctrl[pos] == HS_CTRL_FLAG_EMPTY)
-      return false;
-
-    pos = (pos + 1) % set->size;
-  }
+  sz pos;
+  return hs_find(set, key, set->hash_function(key), &pos);
 }
 
 void __hashset_unset_impl(hashset_t *set, const void *key)
 {
   SOLC_ASSUME(set != nullptr && key != nullptr);
 
-  hash_t hash = set->hash_function(key);
-  sz pos = hs_h1(hash) % set->size;
-
-  while (1) {
-    if (hs_h2(hash) == set->ctrl[pos]) {
-      void *slot_key = hs_get_key_slot_addr(set, pos);
-      if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
-        SOLC_ASSUME(set->key_compare_function != nullptr);
-        if SOLC_LIKELY (set->key_compare_function(key, *(void **)slot_key)) {
-          void **key_slot_ptr = slot_key;
-
-          free(*key_slot_ptr);
-          *key_slot_ptr = 0;
-
-          set->ctrl[pos] = HS_CTRL_FLAG_DELETED;
-          set->filled--;
-          return;
-        }
-      } else if SOLC_LIKELY (memcmp(key, slot_key, set->key_size) == 0) {
-        memset(slot_key, 0, set->key_size);
-        set->ctrl[pos] = HS_CTRL_FLAG_DELETED;
-        set->filled--;
-        return;
-      }
-    }
+  sz pos;
+  if (!hs_find(set, key, set->hash_function(key), &pos))
+    return;
 
-    if (set->ctrl[pos] == HS_CTRL_FLAG_EMPTY)
-      return;
+  void **key_slot_ptr = hs_get_key_slot_addr(set, pos);
+  if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
+    if (set->storage_arena == nullptr)
+      alloc_heap_free(*key_slot_ptr);
+    *key_slot_ptr = 0;
+  } else {
+    memset(key_slot_ptr, 0, set->key_size);
+  }
 
-    pos = (pos + 1) % set->size;
+  // A group that still has an empty slot ends every probe sequence reaching
+  // it, so no lookup depends on this slot and it needs no tombstone.
+  const sz base = pos & ~(sz)(SWISS_GROUP_WIDTH - 1);
+  if (swiss_group_match_empty(swiss_group_load(&set->ctrl[base])) != 0) {
+    set->ctrl[pos] = SWISS_CTRL_EMPTY;
+  } else {
+    set->ctrl[pos] = SWISS_CTRL_DELETED;
+    set->deleted++;
   }
+  set->filled--;
 }
 
 sz hashset_get_size(hashset_t *set)
@@ -220,6 +181,89 @@ b8 hashset_is_empty(hashset_t *set)
   return set->filled == 0;
 }
 
+void hashset_foreach(hashset_t *set,
+                     hashset_foreach_function_t foreach_function)
+{
+  SOLC_ASSUME(set != nullptr && foreach_function != nullptr);
+  hashset_cursor_t cursor = hashset_cursor_create(set);
+  while (hashset_cursor_next(&cursor))
+    foreach_function(cursor.key);
+}
+
+void hashset_foreach_ctx(hashset_t *set,
+                         hashset_foreach_ctx_function_t foreach_function,
+                         void *ctx)
+{
+  SOLC_ASSUME(set != nullptr && foreach_function != nullptr);
+  hashset_cursor_t cursor = hashset_cursor_create(set);
+  while (hashset_cursor_next(&cursor))
+    foreach_function(cursor.key, ctx);
+}
+
+void hashset_reserve(hashset_t *set, sz n)
+{
+  SOLC_ASSUME(set != nullptr);
+
+  sz new_size = set->size;
+  while (hs_max_filled(new_size) < n)
+    new_size *= HS_RESIZE_FACTOR;
+
+  if (new_size != set->size)
+    hs_grow(set, new_size);
+}
+
+void hashset_set_many(hashset_t *set, const void *keys, sz n)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(set != nullptr && (n == 0 || keys != nullptr));
+
+  hashset_reserve(set, set->filled + n);
+  for (sz i = 0; i < n; i++) {
+    const char *key = (const char *)keys + set->key_size * i;
+    __hashset_set_impl(set, set->key_size_policy == SIZE_POLICY_VARIABLE ?
+                              *(const void *const *)key :
+                              key);
+  }
+}
+
+void hashset_clear(hashset_t *set)
+{
+  SOLC_ASSUME(set != nullptr);
+
+  hs_free_keys(set);
+  memset(set->ctrl, SWISS_CTRL_EMPTY, CTRL_BLOCK_SIZE(set->size));
+  memset(set->key_slots, 0, KEY_BLOCK_SIZE(set->key_size, set->size));
+  set->filled = 0;
+  set->deleted = 0;
+}
+
+hashset_cursor_t hashset_cursor_create(hashset_t *set)
+{
+  SOLC_ASSUME(set != nullptr);
+  return (hashset_cursor_t){
+    .set = set,
+    .pos = 0,
+    .key = nullptr,
+  };
+}
+
+b8 hashset_cursor_next(hashset_cursor_t *cursor)
+{
+  SOLC_ASSUME(cursor != nullptr);
+
+  hashset_t *set = cursor->set;
+  while (cursor->pos < set->size) {
+    const sz pos = cursor->pos++;
+    if (hs_ctrl_flag_is_present(set->ctrl[pos]))
+      continue;
+
+    cursor->key = hs_get_key(set, pos);
+    return true;
+  }
+
+  return false;
+}
+
 static inline hash_t hs_h1(hash_t hash)
 {
   return hash >> 7;
@@ -235,43 +279,177 @@ static inline b8 hs_ctrl_flag_is_present(hs_ctrl_t ctrl)
   return (ctrl & 0b10000000) != 0;
 }
 
-static hashset_t *hs_resize_and_rehash(hashset_t *set)
+// Probes a group at a time, a group with an empty slot ends the probe
+// sequence. Groups are visited in triangular steps, which reach every group of
+// a power of two sized table and break up clusters of full groups.
+static inline b8 hs_find(hashset_t *set, const void *key, hash_t hash,
+                         sz *out_pos)
 {
-  SOLC_ASSUME(set != nullptr);
+  const sz groups_mask = set->size / SWISS_GROUP_WIDTH - 1;
+  const hs_ctrl_t h2 = hs_h2(hash);
+  sz group_pos = hs_h1(hash) & groups_mask;
+
+  for (sz step = 1;; step++) {
+    const sz base = group_pos * SWISS_GROUP_WIDTH;
+    const swiss_group_t group = swiss_group_load(&set->ctrl[base]);
+
+    for (swiss_bitmask_t match = swiss_group_match(group, h2); match != 0;
+         match = swiss_bitmask_next(match)) {
+      const sz pos = base + swiss_bitmask_lowest(match);
+      if SOLC_LIKELY (hs_key_equals(set, pos, key)) {
+        *out_pos = pos;
+        return true;
+      }
+    }
+
+    if SOLC_LIKELY (swiss_group_match_empty(group) != 0)
+      return false;
 
-  sz new_size = set->size * HS_RESIZE_FACTOR;
+    group_pos = (group_pos + step) & groups_mask;
+  }
+}
 
-  sz new_memreq = FULL_BLOCK_SIZE(set->key_size, new_size);
-  void *new_block = malloc(new_memreq);
+static inline sz hs_find_free(hashset_t *set, hash_t hash)
+{
+  const sz groups_mask = set->size / SWISS_GROUP_WIDTH - 1;
+  sz group_pos = hs_h1(hash) & groups_mask;
 
-  const sz ctrl_block_size = CTRL_BLOCK_SIZE(new_size);
+  for (sz step = 1;; step++) {
+    const sz base = group_pos * SWISS_GROUP_WIDTH;
+    const swiss_bitmask_t free_mask = swiss_group_match_empty_or_deleted(
+      swiss_group_load(&set->ctrl[base]));
+    if SOLC_LIKELY (free_mask != 0)
+      return base + swiss_bitmask_lowest(free_mask);
 
-  hs_ctrl_t *new_ctrl = new_block;
-  memset(new_ctrl, HS_CTRL_FLAG_EMPTY, ctrl_block_size);
+    group_pos = (group_pos + step) & groups_mask;
+  }
+}
 
-  void *new_key_slots = (char *)new_block + ctrl_block_size;
-  memset(new_key_slots, 0, KEY_BLOCK_SIZE(set->key_size, new_size));
+static inline b8 hs_key_equals(hashset_t *set, sz pos, const void *key)
+{
+  void *slot_key = hs_get_key_slot_addr(set, pos);
+  if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
+    SOLC_ASSUME(set->key_compare_function != nullptr);
 
-  hashset_t *new_set = malloc(sizeof(hashset_t));
-  memcpy(new_set, set, sizeof(hashset_t));
-  new_set->ctrl = new_ctrl;
-  new_set->key_slots = new_key_slots;
-  new_set->size = new_size;
-  new_set->filled = 0;
+    slot_key = *(void **)slot_key;
+    SOLC_ASSUME(slot_key != nullptr);
 
-  for (sz i = 0; i < set->size; i++) {
-    if (hs_ctrl_flag_is_present(set->ctrl[i]))
+    return set->key_compare_function(key, slot_key);
+  }
+
+  // Fixed size keys such as `string_key_t' may point to what they compare.
+  if (set->key_compare_function != nullptr)
+    return set->key_compare_function(key, slot_key);
+  return memcmp(key, slot_key, set->key_size) == 0;
+}
+
+// At most 7/8 of the slots are full or deleted.
+static inline sz hs_max_filled(sz size)
+{
+  return size - size / 8;
+}
+
+static void hs_rehash(hashset_t *set)
+{
+  SOLC_ASSUME(set != nullptr);
+
+  // Mostly tombstones, dropping them makes enough room without growing.
+  if (set->filled <= hs_max_filled(set->size) / 2) {
+    hs_rehash_in_place(set);
+    return;
+  }
+
+  hs_grow(set, set->size * HS_RESIZE_FACTOR);
+}
+
+static void hs_rehash_in_place(hashset_t *set)
+{
+  // Full slots are marked deleted until they are placed again, tombstones
+  // become empty.
+  for (sz i = 0; i < set->size; i++)
+    set->ctrl[i] = hs_ctrl_flag_is_present(set->ctrl[i]) ? SWISS_CTRL_EMPTY :
+                                                           SWISS_CTRL_DELETED;
+
+  for (sz i = 0; i < set->size;) {
+    if (set->ctrl[i] != SWISS_CTRL_DELETED) {
+      i++;
       continue;
+    }
 
-    void *key = hs_get_key_slot_addr(set, i);
+    const hash_t hash = hs_hash_slot(set, i);
+    const sz new_pos = hs_find_free(set, hash);
+
+    // Still in the first group with room on its probe sequence.
+    if (new_pos / SWISS_GROUP_WIDTH == i / SWISS_GROUP_WIDTH) {
+      set->ctrl[i] = hs_h2(hash);
+      i++;
+      continue;
+    }
 
-    if (set->key_size_policy == SIZE_POLICY_VARIABLE)
-      key = *(void **)key;
+    hs_swap_bytes(hs_get_key_slot_addr(set, i),
+                  hs_get_key_slot_addr(set, new_pos), set->key_size);
 
-    __hashset_set_impl(new_set, key);
+    // An empty target got the slot's key and left a zeroed one behind, a
+    // deleted one handed over a key that has not been placed yet.
+    if (set->ctrl[new_pos] == SWISS_CTRL_EMPTY) {
+      set->ctrl[i] = SWISS_CTRL_EMPTY;
+      i++;
+    }
+    set->ctrl[new_pos] = hs_h2(hash);
   }
 
-  return new_set;
+  set->deleted = 0;
+}
+
+static void hs_grow(hashset_t *set, sz new_size)
+{
+  hs_ctrl_t *old_ctrl = set->ctrl;
+  const void *old_key_slots = set->key_slots;
+  const sz old_size = set->size;
+
+  void *new_block = HS_ALLOC(FULL_BLOCK_SIZE(set->key_size, new_size));
+
+  const sz ctrl_block_size = CTRL_BLOCK_SIZE(new_size);
+  set->ctrl = new_block;
+  memset(set->ctrl, SWISS_CTRL_EMPTY, ctrl_block_size);
+
+  set->key_slots = (char *)new_block + ctrl_block_size;
+  memset(set->key_slots, 0, KEY_BLOCK_SIZE(set->key_size, new_size));
+  set->size = new_size;
+  set->deleted = 0;
+
+  // Keys are moved as they are, variable-size ones keep their allocations.
+  for (sz i = 0; i < old_size; i++) {
+    if (hs_ctrl_flag_is_present(old_ctrl[i]))
+      continue;
+
+    const char *key_slot = (const char *)old_key_slots + set->key_size * i;
+    const void *key = set->key_size_policy == SIZE_POLICY_VARIABLE ?
+                        *(void *const *)key_slot :
+                        key_slot;
+
+    const hash_t hash = set->hash_function(key);
+    const sz pos = hs_find_free(set, hash);
+    memcpy(hs_get_key_slot_addr(set, pos), key_slot, set->key_size);
+    set->ctrl[pos] = hs_h2(hash);
+  }
+
+  alloc_heap_free(old_ctrl);
+}
+
+static inline hash_t hs_hash_slot(hashset_t *set, sz pos)
+{
+  return set->hash_function(hs_get_key(set, pos));
+}
+
+static void hs_swap_bytes(void *a, void *b, sz n)
+{
+  u8 *x = a, *y = b;
+  for (sz i = 0; i < n; i++) {
+    const u8 tmp = x[i];
+    x[i] = y[i];
+    y[i] = tmp;
+  }
 }
 
 static inline void *hs_get_key_slot_addr(hashset_t *set, sz pos)
@@ -280,6 +458,29 @@ static inline void *hs_get_key_slot_addr(hashset_t *set, sz pos)
   return (char *)set->key_slots + (set->key_size * pos);
 }
 
+// Variable-size keys are stored as pointers to their copies.
+static inline const void *hs_get_key(hashset_t *set, sz pos)
+{
+  void *key_slot = hs_get_key_slot_addr(set, pos);
+  return set->key_size_policy == SIZE_POLICY_VARIABLE ? *(void **)key_slot :
+                                                        key_slot;
+}
+
+// Arena copies are released with the arena.
+static void hs_free_keys(hashset_t *set)
+{
+  if (set->key_size_policy != SIZE_POLICY_VARIABLE ||
+      set->storage_arena != nullptr)
+    return;
+
+  for (sz i = 0; i < set->size; i++) {
+    if (hs_ctrl_flag_is_present(set->ctrl[i]))
+      continue;
+
+    alloc_heap_free(*(void **)hs_get_key_slot_addr(set, i));
+  }
+}
+
 static void hs_set_key(hashset_t *set, sz pos, const void *key)
 {
   SOLC_ASSUME(set != nullptr && key != nullptr);
@@ -287,11 +488,14 @@ static void hs_set_key(hashset_t *set, sz pos, const void *key)
 
   if (set->key_size_policy == SIZE_POLICY_VARIABLE) {
     void **key_ptr = key_slot;
-    if (*key_ptr != nullptr)
-      free(*key_ptr);
+    if (set->storage_arena == nullptr)
+      alloc_heap_free(*key_ptr);
 
     sz key_size = set->get_key_size_function(key);
-    *key_ptr = malloc(key_size);
+    *key_ptr = set->storage_arena != nullptr ?
+                 alloc_arena_allocate_aligned(set->storage_arena, key_size,
+                                              HS_STORAGE_ALIGNMENT) :
+                 HS_ALLOC(key_size);
     memcpy(*key_ptr, key, key_size);
 
     return;
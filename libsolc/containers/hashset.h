@@ -1,12 +1,29 @@
 #ifndef __SOLC_CONTAINERS_HASHSET_H__
 #define __SOLC_CONTAINERS_HASHSET_H__
 
+#include "allocs/alloc_arena.h"
 #include "hash.h"
 #include "solc/defs.h"
 #include "types.h"
 
 typedef struct __hashset_t hashset_t;
 
+typedef void (*hashset_foreach_function_t)(const void *key);
+typedef void (*hashset_foreach_ctx_function_t)(const void *key, void *ctx);
+
+// Walks the keys in slot order:
+//
+//   hashset_cursor_t cursor = hashset_cursor_create(set);
+//   while (hashset_cursor_next(&cursor))
+//     use(cursor.key);
+//
+// `key' points into the set, which must not change meanwhile.
+typedef struct {
+  hashset_t *set;
+  sz pos;
+  const void *key;
+} hashset_cursor_t;
+
 #define hashset_create(_set_ptr, _key_type)                                  \
   {                                                                          \
     _key_type __hashset_phantom_key__;                                       \
@@ -14,14 +31,26 @@ typedef struct __hashset_t hashset_t;
       sizeof(_key_type), get_default_hash_function(__hashset_phantom_key__), \
       get_default_size_policy(__hashset_phantom_key__),                      \
       get_default_get_size_function(__hashset_phantom_key__),                \
-      get_default_key_compare_function(__hashset_phantom_key__));            \
+      get_default_key_compare_function(__hashset_phantom_key__), nullptr);   \
+  }
+
+// Variable-size keys are copied into `_arena' instead of being allocated one
+// by one. They live as long as the arena.
+#define hashset_create_in_arena(_set_ptr, _key_type, _arena)                 \
+  {                                                                          \
+    _key_type __hashset_phantom_key__;                                       \
+    (_set_ptr) = __hashset_create_impl(                                      \
+      sizeof(_key_type), get_default_hash_function(__hashset_phantom_key__), \
+      get_default_size_policy(__hashset_phantom_key__),                      \
+      get_default_get_size_function(__hashset_phantom_key__),                \
+      get_default_key_compare_function(__hashset_phantom_key__), (_arena));  \
   }
 
 #define hashset_create_raw(_key_type, _hash_function, _key_size_policy,   \
                            _get_key_size_function, _key_compare_function) \
   __hashset_create_impl(sizeof(_key_type), (_hash_function),              \
                         (_key_size_policy), (_get_key_size_function),     \
-                        (_key_compare_function))
+                        (_key_compare_function), nullptr)
 
 #define hashset_set(_set, _key)                                       \
   {                                                                   \
@@ -43,7 +72,8 @@ typedef struct __hashset_t hashset_t;
 hashset_t *__hashset_create_impl(sz key_size, hash_function_t hash_function,
                                  size_policy_t key_size_policy,
                                  get_size_function_t get_key_size_function,
-                                 compare_function_t key_compare_function);
+                                 compare_function_t key_compare_function,
+                                 alloc_arena_t *storage_arena);
 void hashset_destroy(hashset_t *set);
 hashset_t *__hashset_set_impl(hashset_t *set, const void *key);
 b8 __hashset_is_set_impl(hashset_t *set, const void *key);
@@ -51,6 +81,20 @@ void __hashset_unset_impl(hashset_t *set, const void *key);
 
 sz hashset_get_size(hashset_t *set);
 b8 hashset_is_empty(hashset_t *set);
+void hashset_foreach(hashset_t *set,
+                     hashset_foreach_function_t foreach_function);
+void hashset_foreach_ctx(hashset_t *set,
+                         hashset_foreach_ctx_function_t foreach_function,
+                         void *ctx);
+// Makes room for `n' keys in total, so setting them never rehashes.
+void hashset_reserve(hashset_t *set, sz n);
+// `keys' is an array of `n' keys of the set's type, for variable-size keys that
+// is an array of pointers.
+void hashset_set_many(hashset_t *set, const void *keys, sz n);
+// Removes every key but keeps the capacity.
+void hashset_clear(hashset_t *set);
+hashset_cursor_t hashset_cursor_create(hashset_t *set);
+b8 hashset_cursor_next(hashset_cursor_t *cursor);
 
 #define __hashset_arg_macro(_X) \
   _Generic((_X), char *: (_X), const char *: (_X), default: &(_X))
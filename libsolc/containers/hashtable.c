@@ -1,11 +1,21 @@
 #include "containers/hashtable.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
+#include "containers/swiss_group.h"
 #include <stdlib.h>
 #include <string.h>
 #include "solc/defs.h"
 
+#define HT_ALLOC(_size) alloc_heap_malloc(SOLC_MEM_TAG_HASHTABLE, (_size))
 #define HT_INITIAL_SIZE 64
 #define HT_RESIZE_FACTOR 2
-#define HT_MAX_LOAD_FACTOR 0.65f
+// Variable-size entries are strings or pointer aligned records.
+#define HT_STORAGE_ALIGNMENT sizeof(void *)
+
+// Capacities are powers of two, so every probe step is a mask.
+_Static_assert((HT_INITIAL_SIZE & (HT_INITIAL_SIZE - 1)) == 0 &&
+                 HT_INITIAL_SIZE >= SWISS_GROUP_WIDTH,
+               "HT_INITIAL_SIZE must be a power of two of whole groups");
 
 #define CTRL_BLOCK_SIZE(_num_of_entries) (sizeof(ht_ctrl_t) * (_num_of_entries))
 #define KEY_BLOCK_SIZE(_key_size, _num_of_entries) \
@@ -17,11 +27,7 @@
    KEY_BLOCK_SIZE((_key_size), (_num_of_entries)) +              \
    VALUE_BLOCK_SIZE((_value_size), (_num_of_entries)))
 
-typedef u8 ht_ctrl_t;
-typedef enum {
-  HT_CTRL_FLAG_EMPTY = 0b10000000,
-  HT_CTRL_FLAG_DELETED = 0b11111111,
-} ht_ctrl_flags_t;
+typedef swiss_ctrl_t ht_ctrl_t;
 
 typedef struct __hashtable_t {
   ht_ctrl_t *ctrl;
@@ -29,6 +35,7 @@ typedef struct __hashtable_t {
 
   sz size;
   sz filled;
+  sz deleted;
 
   sz key_size;
   sz value_size;
@@ -36,6 +43,7 @@ typedef struct __hashtable_t {
   hash_function_t hash_function;
   get_size_function_t get_key_size_function, get_value_size_function;
   compare_function_t key_compare_function;
+  alloc_arena_t *storage_arena;
 
   size_policy_t key_size_policy : 1;
   size_policy_t value_size_policy : 1;
@@ -46,24 +54,41 @@ static inline ht_ctrl_t ht_h2(hash_t hash);
 
 static inline b8 ht_ctrl_flag_is_present(ht_ctrl_t ctrl);
 
-static hashtable_t *ht_resize_and_rehash(hashtable_t *table);
+static inline b8 ht_find(hashtable_t *table, const void *key, hash_t hash,
+                         sz *out_pos);
+static inline sz ht_find_free(hashtable_t *table, hash_t hash);
+static inline b8 ht_key_equals(hashtable_t *table, sz pos, const void *key);
+
+static inline sz ht_max_filled(sz size);
+static void ht_rehash(hashtable_t *table);
+static void ht_rehash_in_place(hashtable_t *table);
+static void ht_grow(hashtable_t *table, sz new_size);
+static inline hash_t ht_hash_slot(hashtable_t *table, sz pos);
+static void ht_swap_bytes(void *a, void *b, sz n);
 
 static inline void *ht_get_key_slot_addr(hashtable_t *table, sz pos);
 static inline void *ht_get_value_slot_addr(hashtable_t *table, sz pos);
+static inline const void *ht_get_key(hashtable_t *table, sz pos);
+static inline const void *ht_get_value(hashtable_t *table, sz pos);
+static void ht_free_entries(hashtable_t *table);
 
 static void ht_set_key(hashtable_t *table, sz pos, const void *key);
 static void ht_set_value(hashtable_t *table, sz pos, const void *value);
+static void *ht_copy_entry(hashtable_t *table, void *old_copy, const void *data,
+                           sz size);
+static void ht_free_entry(hashtable_t *table, void *copy);
 
 hashtable_t *__hashtable_create_impl(
   sz key_size, sz value_size, hash_function_t hash_function,
   size_policy_t key_size_policy, size_policy_t value_size_policy,
   get_size_function_t get_key_size_function,
   get_size_function_t get_value_size_function,
-  compare_function_t key_compare_function)
+  compare_function_t key_compare_function, alloc_arena_t *storage_arena)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(hash_function != nullptr);
 
-  hashtable_t *out_table = malloc(sizeof(hashtable_t));
+  hashtable_t *out_table = HT_ALLOC(sizeof(hashtable_t));
 
   if (key_size_policy == SIZE_POLICY_VARIABLE) {
     key_size = sizeof(void *);
@@ -72,10 +97,11 @@ hashtable_t *__hashtable_create_impl(
     value_size = sizeof(void *);
   }
 
-  void *block = malloc(FULL_BLOCK_SIZE(key_size, value_size, HT_INITIAL_SIZE));
+  void *block =
+    HT_ALLOC(FULL_BLOCK_SIZE(key_size, value_size, HT_INITIAL_SIZE));
 
   out_table->ctrl = block;
-  memset(out_table->ctrl, HT_CTRL_FLAG_EMPTY, CTRL_BLOCK_SIZE(HT_INITIAL_SIZE));
+  memset(out_table->ctrl, SWISS_CTRL_EMPTY, CTRL_BLOCK_SIZE(HT_INITIAL_SIZE));
 
   out_table->slots = (char *)block + CTRL_BLOCK_SIZE(HT_INITIAL_SIZE);
   memset(out_table->slots, 0,
@@ -84,12 +110,14 @@ hashtable_t *__hashtable_create_impl(
 
   out_table->size = HT_INITIAL_SIZE;
   out_table->filled = 0;
+  out_table->deleted = 0;
   out_table->key_size = key_size;
   out_table->value_size = value_size;
   out_table->hash_function = hash_function;
   out_table->get_key_size_function = get_key_size_function;
   out_table->get_value_size_function = get_value_size_function;
   out_table->key_compare_function = key_compare_function;
+  out_table->storage_arena = storage_arena;
   out_table->key_size_policy = key_size_policy;
   out_table->value_size_policy = value_size_policy;
 
@@ -100,176 +128,106 @@ void hashtable_destroy(hashtable_t *table)
 {
   SOLC_ASSUME(table != nullptr);
 
-  if (table->key_size_policy == SIZE_POLICY_VARIABLE ||
-      table->value_size_policy == SIZE_POLICY_VARIABLE) {
-    for (sz i = 0; i < table->size; i++) {
-      if (ht_ctrl_flag_is_present(table->ctrl[i]))
-        continue;
-
-      if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
-        void *key = ht_get_key_slot_addr(table, i);
-        key = *(void **)key;
-        free(key);
-      }
-
-      if (table->value_size_policy == SIZE_POLICY_VARIABLE) {
-        void *value = ht_get_value_slot_addr(table, i);
-        value = *(void **)value;
-        free(value);
-      }
-    }
-  }
-
-  free(table->ctrl);
-  free(table);
+  ht_free_entries(table);
+  alloc_heap_free(table->ctrl);
+  alloc_heap_free(table);
 }
 
 hashtable_t *__hashtable_put_impl(hashtable_t *table, const void *key,
                                   const void *value)
 {
-  SOLC_ASSUME(table != nullptr && key != nullptr && value != nullptr);
+  SOLC_ASSUME(table != nullptr);
+  return __hashtable_put_hashed_impl(table, key, table->hash_function(key),
+                                     value);
+}
 
-  hash_t hash = table->hash_function(key);
-  sz pos = ht_h1(hash) % table->size;
-  ht_ctrl_t h2 = ht_h2(hash);
-
-  while (1) {
-    if (h2 == table->ctrl[pos]) {
-      void *slot_key = ht_get_key_slot_addr(table, pos);
-      if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
-        SOLC_ASSUME(table->key_compare_function != nullptr);
-
-        slot_key = *(void **)slot_key;
-        SOLC_ASSUME(slot_key != nullptr);
-
-        if SOLC_LIKELY (table->key_compare_function(key, slot_key)) {
-          ht_set_value(table, pos, value);
-          return table;
-        }
-      } else if SOLC_LIKELY (memcmp(key, slot_key, table->key_size) == 0) {
-        ht_set_value(table, pos, value);
-        return table;
-      }
-    }
+hashtable_t *__hashtable_put_hashed_impl(hashtable_t *table, const void *key,
+                                         hash_t hash, const void *value)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(table != nullptr && key != nullptr && value != nullptr);
 
-    if (ht_ctrl_flag_is_present(table->ctrl[pos])) {
-      ht_set_key(table, pos, key);
-      ht_set_value(table, pos, value);
+  sz pos;
+  if (ht_find(table, key, hash, &pos)) {
+    ht_set_value(table, pos, value);
+    return table;
+  }
 
-      table->ctrl[pos] = h2;
-      table->filled++;
+  pos = ht_find_free(table, hash);
+  ht_set_key(table, pos, key);
+  ht_set_value(table, pos, value);
 
-      float load_factor = (float)table->filled / table->size;
-      if SOLC_UNLIKELY (load_factor > HT_MAX_LOAD_FACTOR) {
-        table = ht_resize_and_rehash(table);
-      }
+  if (table->ctrl[pos] == SWISS_CTRL_DELETED)
+    table->deleted--;
+  table->ctrl[pos] = ht_h2(hash);
+  table->filled++;
 
-      return table;
-    }
+  if SOLC_UNLIKELY (table->filled + table->deleted >
+                    ht_max_filled(table->size))
+    ht_rehash(table);
 
-    pos = (pos + 1) % table->size;
-  }
+  // The table is rehashed in place, callers may keep using their pointer.
+  return table;
 }
 
 const void *__hashtable_get_impl(hashtable_t *table, const void *key)
 {
-  SOLC_ASSUME(table != nullptr && key != nullptr);
+  SOLC_ASSUME(table != nullptr);
+  return __hashtable_get_hashed_impl(table, key, table->hash_function(key));
+}
 
-  hash_t hash = table->hash_function(key);
-  sz pos = ht_h1(hash) % table->size;
-  ht_ctrl_t h2 = ht_h2(hash);
-
-  while (1) {
-    if (h2 == table->ctrl[pos]) {
-      void *slot_key = ht_get_key_slot_addr(table, pos);
-      if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
-        SOLC_ASSUME(table->key_compare_function != nullptr);
-
-        slot_key = *(void **)slot_key;
-        SOLC_ASSUME(slot_key != nullptr);
-
-        if SOLC_LIKELY (table->key_compare_function(key, slot_key)) {
-          void *value = ht_get_value_slot_addr(table, pos);
-          return table->value_size_policy == SIZE_POLICY_VARIABLE ?
-                   *(void **)value :
-                   value;
-        }
-      } else if SOLC_LIKELY (memcmp(key, slot_key, table->key_size) == 0) {
-        void *value = ht_get_value_slot_addr(table, pos);
-        return table->value_size_policy == SIZE_POLICY_VARIABLE ?
-                 *(void **)value :
-                 value;
-      }
-    }
+const void *__hashtable_get_hashed_impl(hashtable_t *table, const void *key,
+                                        hash_t hash)
+{
+  SOLC_ASSUME(table != nullptr && key != nullptr);
 
-    if SOLC_UNLIKELY (table->ctrl[pos] == HT_CTRL_FLAG_EMPTY)
-      return nullptr;
+  sz pos;
+  if (!ht_find(table, key, hash, &pos))
+    return nullptr;
 
-    pos = (pos + 1) % table->size;
-  }
+  return ht_get_value(table, pos);
 }
 
 void __hashtable_remove_impl(hashtable_t *table, const void *key)
 {
   SOLC_ASSUME(table != nullptr && key != nullptr);
 
-  hash_t hash = table->hash_function(key);
-  sz pos = ht_h1(hash) % table->size;
-  ht_ctrl_t h2 = ht_h2(hash);
-
-  while (1) {
-    if (h2 == table->ctrl[pos]) {
-      void *slot_key = ht_get_key_slot_addr(table, pos);
-      if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
-        SOLC_ASSUME(table->key_compare_function != nullptr);
-        if SOLC_LIKELY (table->key_compare_function(key, *(void **)slot_key)) {
-          void **key_slot_ptr = slot_key;
-          void **value_slot_ptr = ht_get_value_slot_addr(table, pos);
-
-          SOLC_ASSUME(value_slot_ptr != nullptr);
-
-          free(*key_slot_ptr);
-          *key_slot_ptr = 0;
-
-          if (table->value_size_policy == SIZE_POLICY_VARIABLE) {
-            free(*value_slot_ptr);
-            *value_slot_ptr = 0;
-          } else {
-            memset(value_slot_ptr, 0, table->value_size);
-          }
-
-          table->ctrl[pos] = HT_CTRL_FLAG_DELETED;
-          table->filled--;
-          return;
-        }
-      } else if SOLC_LIKELY (memcmp(key, slot_key, table->key_size) == 0) {
-        memset(slot_key, 0, table->key_size);
-
-        void **value_slot_ptr = ht_get_value_slot_addr(table, pos);
-        if (table->value_size_policy == SIZE_POLICY_VARIABLE) {
-          free(*value_slot_ptr);
-          *value_slot_ptr = 0;
-        } else {
-          memset(value_slot_ptr, 0, table->value_size);
-        }
-
-        table->ctrl[pos] = HT_CTRL_FLAG_DELETED;
-        table->filled--;
-        return;
-      }
-    }
+  sz pos;
+  if (!ht_find(table, key, table->hash_function(key), &pos))
+    return;
 
-    if (table->ctrl[pos] == HT_CTRL_FLAG_EMPTY)
-      return;
+  void **key_slot_ptr = ht_get_key_slot_addr(table, pos);
+  if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
+    ht_free_entry(table, *key_slot_ptr);
+    *key_slot_ptr = 0;
+  } else {
+    memset(key_slot_ptr, 0, table->key_size);
+  }
 
-    pos = (pos + 1) % table->size;
+  void **value_slot_ptr = ht_get_value_slot_addr(table, pos);
+  if (table->value_size_policy == SIZE_POLICY_VARIABLE) {
+    ht_free_entry(table, *value_slot_ptr);
+    *value_slot_ptr = 0;
+  } else {
+    memset(value_slot_ptr, 0, table->value_size);
   }
+
+  // A group that still has an empty slot ends every probe sequence reaching
+  // it, so no lookup depends on this slot and it needs no tombstone.
+  const sz base = pos & ~(sz)(SWISS_GROUP_WIDTH - 1);
+  if (swiss_group_match_empty(swiss_group_load(&table->ctrl[base])) != 0) {
+    table->ctrl[pos] = SWISS_CTRL_EMPTY;
+  } else {
+    table->ctrl[pos] = SWISS_CTRL_DELETED;
+    table->deleted++;
+  }
+  table->filled--;
 }
 
 b8 hashtable_is_empty(hashtable_t *table)
 {
   SOLC_ASSUME(table != nullptr);
-  return table->filled != 0;
+  return table->filled == 0;
 }
 
 sz hashtable_get_size(hashtable_t *table)
@@ -282,22 +240,94 @@ void hashtable_foreach(hashtable_t *table,
                        hashtable_foreach_function_t foreach_function)
 {
   SOLC_ASSUME(table != nullptr && foreach_function != nullptr);
-  for (sz i = 0; i < table->size; i++) {
-    if (ht_ctrl_flag_is_present(table->ctrl[i]))
-      continue;
+  hashtable_cursor_t cursor = hashtable_cursor_create(table);
+  while (hashtable_cursor_next(&cursor))
+    foreach_function(cursor.key, cursor.value);
+}
+
+void hashtable_foreach_ctx(hashtable_t *table,
+                           hashtable_foreach_ctx_function_t foreach_function,
+                           void *ctx)
+{
+  SOLC_ASSUME(table != nullptr && foreach_function != nullptr);
+  hashtable_cursor_t cursor = hashtable_cursor_create(table);
+  while (hashtable_cursor_next(&cursor))
+    foreach_function(cursor.key, cursor.value, ctx);
+}
+
+void hashtable_reserve(hashtable_t *table, sz n)
+{
+  SOLC_ASSUME(table != nullptr);
+
+  sz new_size = table->size;
+  while (ht_max_filled(new_size) < n)
+    new_size *= HT_RESIZE_FACTOR;
+
+  if (new_size != table->size)
+    ht_grow(table, new_size);
+}
+
+void hashtable_insert_many(hashtable_t *table, const void *keys,
+                           const void *values, sz n)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(table != nullptr &&
+              (n == 0 || (keys != nullptr && values != nullptr)));
+
+  hashtable_reserve(table, table->filled + n);
+  for (sz i = 0; i < n; i++) {
+    const char *key = (const char *)keys + table->key_size * i;
+    const char *value = (const char *)values + table->value_size * i;
+    __hashtable_put_impl(table,
+                         table->key_size_policy == SIZE_POLICY_VARIABLE ?
+                           *(const void *const *)key :
+                           key,
+                         table->value_size_policy == SIZE_POLICY_VARIABLE ?
+                           *(const void *const *)value :
+                           value);
+  }
+}
+
+void hashtable_clear(hashtable_t *table)
+{
+  SOLC_ASSUME(table != nullptr);
+
+  ht_free_entries(table);
+  memset(table->ctrl, SWISS_CTRL_EMPTY, CTRL_BLOCK_SIZE(table->size));
+  memset(table->slots, 0,
+         KEY_BLOCK_SIZE(table->key_size, table->size) +
+           VALUE_BLOCK_SIZE(table->value_size, table->size));
+  table->filled = 0;
+  table->deleted = 0;
+}
+
+hashtable_cursor_t hashtable_cursor_create(hashtable_t *table)
+{
+  SOLC_ASSUME(table != nullptr);
+  return (hashtable_cursor_t){
+    .table = table,
+    .pos = 0,
+    .key = nullptr,
+    .value = nullptr,
+  };
+}
 
-    void *key_slot = ht_get_key_slot_addr(table, i);
-    void *value_slot = ht_get_value_slot_addr(table, i);
+b8 hashtable_cursor_next(hashtable_cursor_t *cursor)
+{
+  SOLC_ASSUME(cursor != nullptr);
 
-    key_slot = table->key_size_policy == SIZE_POLICY_VARIABLE ?
-                 *(void **)key_slot :
-                 key_slot;
-    value_slot = table->value_size_policy == SIZE_POLICY_VARIABLE ?
-                   *(void **)value_slot :
-                   value_slot;
+  hashtable_t *table = cursor->table;
+  while (cursor->pos < table->size) {
+    const sz pos = cursor->pos++;
+    if (ht_ctrl_flag_is_present(table->ctrl[pos]))
+      continue;
 
-    foreach_function(key_slot, value_slot);
+    cursor->key = ht_get_key(table, pos);
+    cursor->value = ht_get_value(table, pos);
+    return true;
   }
+
+  return false;
 }
 
 static inline sz ht_h1(sz hash)
@@ -315,49 +345,188 @@ static inline b8 ht_ctrl_flag_is_present(ht_ctrl_t ctrl)
   return (ctrl & 0b10000000) != 0;
 }
 
-static hashtable_t *ht_resize_and_rehash(hashtable_t *table)
+// Probes a group at a time, a group with an empty slot ends the probe
+// sequence. Groups are visited in triangular steps, which reach every group of
+// a power of two sized table and break up clusters of full groups.
+static inline b8 ht_find(hashtable_t *table, const void *key, hash_t hash,
+                         sz *out_pos)
+{
+  const sz groups_mask = table->size / SWISS_GROUP_WIDTH - 1;
+  const ht_ctrl_t h2 = ht_h2(hash);
+  sz group_pos = ht_h1(hash) & groups_mask;
+
+  for (sz step = 1;; step++) {
+    const sz base = group_pos * SWISS_GROUP_WIDTH;
+    const swiss_group_t group = swiss_group_load(&table->ctrl[base]);
+
+    for (swiss_bitmask_t match = swiss_group_match(group, h2); match != 0;
+         match = swiss_bitmask_next(match)) {
+      const sz pos = base + swiss_bitmask_lowest(match);
+      if SOLC_LIKELY (ht_key_equals(table, pos, key)) {
+        *out_pos = pos;
+        return true;
+      }
+    }
+
+    if SOLC_LIKELY (swiss_group_match_empty(group) != 0)
+      return false;
+
+    group_pos = (group_pos + step) & groups_mask;
+  }
+}
+
+static inline sz ht_find_free(hashtable_t *table, hash_t hash)
+{
+  const sz groups_mask = table->size / SWISS_GROUP_WIDTH - 1;
+  sz group_pos = ht_h1(hash) & groups_mask;
+
+  for (sz step = 1;; step++) {
+    const sz base = group_pos * SWISS_GROUP_WIDTH;
+    const swiss_bitmask_t free_mask = swiss_group_match_empty_or_deleted(
+      swiss_group_load(&table->ctrl[base]));
+    if SOLC_LIKELY (free_mask != 0)
+      return base + swiss_bitmask_lowest(free_mask);
+
+    group_pos = (group_pos + step) & groups_mask;
+  }
+}
+
+static inline b8 ht_key_equals(hashtable_t *table, sz pos, const void *key)
+{
+  void *slot_key = ht_get_key_slot_addr(table, pos);
+  if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
+    SOLC_ASSUME(table->key_compare_function != nullptr);
+
+    slot_key = *(void **)slot_key;
+    SOLC_ASSUME(slot_key != nullptr);
+
+    return table->key_compare_function(key, slot_key);
+  }
+
+  // Fixed size keys such as `string_key_t' may point to what they compare.
+  if (table->key_compare_function != nullptr)
+    return table->key_compare_function(key, slot_key);
+  return memcmp(key, slot_key, table->key_size) == 0;
+}
+
+// At most 7/8 of the slots are full or deleted.
+static inline sz ht_max_filled(sz size)
+{
+  return size - size / 8;
+}
+
+static void ht_rehash(hashtable_t *table)
 {
   SOLC_ASSUME(table != nullptr);
 
-  sz new_size = table->size * HT_RESIZE_FACTOR;
+  // Mostly tombstones, dropping them makes enough room without growing.
+  if (table->filled <= ht_max_filled(table->size) / 2) {
+    ht_rehash_in_place(table);
+    return;
+  }
 
-  sz new_memreq = FULL_BLOCK_SIZE(table->key_size, table->value_size, new_size);
-  void *new_block = malloc(new_memreq);
+  ht_grow(table, table->size * HT_RESIZE_FACTOR);
+}
 
-  const sz ctrl_block_size = CTRL_BLOCK_SIZE(new_size);
+static void ht_rehash_in_place(hashtable_t *table)
+{
+  // Full slots are marked deleted until they are placed again, tombstones
+  // become empty.
+  for (sz i = 0; i < table->size; i++)
+    table->ctrl[i] = ht_ctrl_flag_is_present(table->ctrl[i]) ?
+                       SWISS_CTRL_EMPTY :
+                       SWISS_CTRL_DELETED;
+
+  for (sz i = 0; i < table->size;) {
+    if (table->ctrl[i] != SWISS_CTRL_DELETED) {
+      i++;
+      continue;
+    }
+
+    const hash_t hash = ht_hash_slot(table, i);
+    const sz new_pos = ht_find_free(table, hash);
+
+    // Still in the first group with room on its probe sequence.
+    if (new_pos / SWISS_GROUP_WIDTH == i / SWISS_GROUP_WIDTH) {
+      table->ctrl[i] = ht_h2(hash);
+      i++;
+      continue;
+    }
 
-  ht_ctrl_t *new_ctrl = new_block;
-  memset(new_ctrl, HT_CTRL_FLAG_EMPTY, ctrl_block_size);
+    ht_swap_bytes(ht_get_key_slot_addr(table, i),
+                  ht_get_key_slot_addr(table, new_pos), table->key_size);
+    ht_swap_bytes(ht_get_value_slot_addr(table, i),
+                  ht_get_value_slot_addr(table, new_pos), table->value_size);
 
-  void *new_slots = (char *)new_block + ctrl_block_size;
-  memset(new_slots, 0,
+    // An empty target got the slot's entry and left a zeroed one behind, a
+    // deleted one handed over an entry that has not been placed yet.
+    if (table->ctrl[new_pos] == SWISS_CTRL_EMPTY) {
+      table->ctrl[i] = SWISS_CTRL_EMPTY;
+      i++;
+    }
+    table->ctrl[new_pos] = ht_h2(hash);
+  }
+
+  table->deleted = 0;
+}
+
+static void ht_grow(hashtable_t *table, sz new_size)
+{
+  ht_ctrl_t *old_ctrl = table->ctrl;
+  const void *old_slots = table->slots;
+  const sz old_size = table->size;
+
+  void *new_block =
+    HT_ALLOC(FULL_BLOCK_SIZE(table->key_size, table->value_size, new_size));
+
+  const sz ctrl_block_size = CTRL_BLOCK_SIZE(new_size);
+  table->ctrl = new_block;
+  memset(table->ctrl, SWISS_CTRL_EMPTY, ctrl_block_size);
+
+  table->slots = (char *)new_block + ctrl_block_size;
+  memset(table->slots, 0,
          KEY_BLOCK_SIZE(table->key_size, new_size) +
            VALUE_BLOCK_SIZE(table->value_size, new_size));
+  table->size = new_size;
+  table->deleted = 0;
 
-  hashtable_t *new_table = malloc(sizeof(hashtable_t));
-  memcpy(new_table, table, sizeof(hashtable_t));
-  new_table->ctrl = new_ctrl;
-  new_table->slots = new_slots;
-  new_table->size = new_size;
-  new_table->filled = 0;
-
-  for (sz i = 0; i < table->size; i++) {
-    if (ht_ctrl_flag_is_present(table->ctrl[i]))
+  // Entries are moved as they are, variable-size keys and values keep their
+  // allocations.
+  for (sz i = 0; i < old_size; i++) {
+    if (ht_ctrl_flag_is_present(old_ctrl[i]))
       continue;
 
-    void *key = ht_get_key_slot_addr(table, i);
-    void *value = ht_get_value_slot_addr(table, i);
+    const char *key_slot = (const char *)old_slots + table->key_size * i;
+    const char *value_slot = (const char *)old_slots +
+                             KEY_BLOCK_SIZE(table->key_size, old_size) +
+                             table->value_size * i;
+    const void *key = table->key_size_policy == SIZE_POLICY_VARIABLE ?
+                        *(void *const *)key_slot :
+                        key_slot;
+
+    const hash_t hash = table->hash_function(key);
+    const sz pos = ht_find_free(table, hash);
+    memcpy(ht_get_key_slot_addr(table, pos), key_slot, table->key_size);
+    memcpy(ht_get_value_slot_addr(table, pos), value_slot, table->value_size);
+    table->ctrl[pos] = ht_h2(hash);
+  }
 
-    if (table->key_size_policy == SIZE_POLICY_VARIABLE)
-      key = *(void **)key;
+  alloc_heap_free(old_ctrl);
+}
 
-    if (table->value_size_policy == SIZE_POLICY_VARIABLE)
-      value = *(void **)value;
+static inline hash_t ht_hash_slot(hashtable_t *table, sz pos)
+{
+  return table->hash_function(ht_get_key(table, pos));
+}
 
-    __hashtable_put_impl(new_table, key, value);
+static void ht_swap_bytes(void *a, void *b, sz n)
+{
+  u8 *x = a, *y = b;
+  for (sz i = 0; i < n; i++) {
+    const u8 tmp = x[i];
+    x[i] = y[i];
+    y[i] = tmp;
   }
-
-  return new_table;
 }
 
 static inline void *ht_get_key_slot_addr(hashtable_t *table, sz pos)
@@ -373,6 +542,42 @@ static inline void *ht_get_value_slot_addr(hashtable_t *table, sz pos)
                                  (table->value_size * pos));
 }
 
+// Variable-size keys and values are stored as pointers to their copies.
+static inline const void *ht_get_key(hashtable_t *table, sz pos)
+{
+  void *key_slot = ht_get_key_slot_addr(table, pos);
+  return table->key_size_policy == SIZE_POLICY_VARIABLE ? *(void **)key_slot :
+                                                          key_slot;
+}
+
+static inline const void *ht_get_value(hashtable_t *table, sz pos)
+{
+  void *value_slot = ht_get_value_slot_addr(table, pos);
+  return table->value_size_policy == SIZE_POLICY_VARIABLE ?
+           *(void **)value_slot :
+           value_slot;
+}
+
+// Frees the copies of variable-size keys and values, arena copies are
+// released with the arena.
+static void ht_free_entries(hashtable_t *table)
+{
+  if (table->storage_arena != nullptr ||
+      (table->key_size_policy != SIZE_POLICY_VARIABLE &&
+       table->value_size_policy != SIZE_POLICY_VARIABLE))
+    return;
+
+  for (sz i = 0; i < table->size; i++) {
+    if (ht_ctrl_flag_is_present(table->ctrl[i]))
+      continue;
+
+    if (table->key_size_policy == SIZE_POLICY_VARIABLE)
+      alloc_heap_free(*(void **)ht_get_key_slot_addr(table, i));
+    if (table->value_size_policy == SIZE_POLICY_VARIABLE)
+      alloc_heap_free(*(void **)ht_get_value_slot_addr(table, i));
+  }
+}
+
 static void ht_set_key(hashtable_t *table, sz pos, const void *key)
 {
   SOLC_ASSUME(table != nullptr && key != nullptr);
@@ -380,13 +585,8 @@ static void ht_set_key(hashtable_t *table, sz pos, const void *key)
 
   if (table->key_size_policy == SIZE_POLICY_VARIABLE) {
     void **key_ptr = key_slot;
-    if (*key_ptr != nullptr)
-      free(*key_ptr);
-
-    sz key_size = table->get_key_size_function(key);
-    *key_ptr = malloc(key_size);
-    memcpy(*key_ptr, key, key_size);
-
+    *key_ptr = ht_copy_entry(table, *key_ptr, key,
+                             table->get_key_size_function(key));
     return;
   }
 
@@ -400,15 +600,31 @@ static void ht_set_value(hashtable_t *table, sz pos, const void *value)
 
   if (table->value_size_policy == SIZE_POLICY_VARIABLE) {
     void **value_ptr = value_slot;
-    if (*value_ptr != 0)
-      free(*value_ptr);
-
-    sz value_size = table->get_value_size_function(value);
-    *value_ptr = malloc(value_size);
-    memcpy(*value_ptr, value, value_size);
-
+    *value_ptr = ht_copy_entry(table, *value_ptr, value,
+                               table->get_value_size_function(value));
     return;
   }
 
   memcpy(value_slot, value, table->value_size);
 }
+
+// Copies a variable-size key or value, replacing `old_copy'.
+static void *ht_copy_entry(hashtable_t *table, void *old_copy, const void *data,
+                           sz size)
+{
+  ht_free_entry(table, old_copy);
+
+  void *copy = table->storage_arena != nullptr ?
+                 alloc_arena_allocate_aligned(table->storage_arena, size,
+                                              HT_STORAGE_ALIGNMENT) :
+                 HT_ALLOC(size);
+  memcpy(copy, data, size);
+  return copy;
+}
+
+// Arena copies are released with the arena.
+static void ht_free_entry(hashtable_t *table, void *copy)
+{
+  if (table->storage_arena == nullptr)
+    alloc_heap_free(copy);
+}
@@ -1,6 +1,7 @@
 #ifndef __SOLC_CONTAINER_HASHTABLE_H__
 #define __SOLC_CONTAINER_HASHTABLE_H__
 
+#include "allocs/alloc_arena.h"
 #include "solc/defs.h"
 
 #include "hash.h"
@@ -10,19 +11,54 @@ typedef struct __hashtable_t hashtable_t;
 
 typedef void (*hashtable_foreach_function_t)(const void *key,
                                              const void *value);
+typedef void (*hashtable_foreach_ctx_function_t)(const void *key,
+                                                 const void *value, void *ctx);
+
+// Walks the entries in slot order:
+//
+//   hashtable_cursor_t cursor = hashtable_cursor_create(table);
+//   while (hashtable_cursor_next(&cursor))
+//     use(cursor.key, cursor.value);
+//
+// `key' and `value' point into the table, which must not change meanwhile.
+typedef struct {
+  hashtable_t *table;
+  sz pos;
+  const void *key;
+  const void *value;
+} hashtable_cursor_t;
+
+#define hashtable_create(_table_ptr, _key_type, _value_type)       \
+  {                                                                \
+    _key_type __hashtable_phantom_key__;                           \
+    _value_type __hashtable_phantom_value__;                       \
+    (_table_ptr) = __hashtable_create_impl(                        \
+      sizeof(_key_type), sizeof(_value_type),                      \
+      get_default_hash_function(__hashtable_phantom_key__),        \
+      get_default_size_policy(__hashtable_phantom_key__),          \
+      get_default_size_policy(__hashtable_phantom_value__),        \
+      get_default_get_size_function(__hashtable_phantom_key__),    \
+      get_default_get_size_function(__hashtable_phantom_value__),  \
+      get_default_key_compare_function(__hashtable_phantom_key__), \
+      nullptr);                                                    \
+  }
 
-#define hashtable_create(_table_ptr, _key_type, _value_type)        \
-  {                                                                 \
-    _key_type __hashtable_phantom_key__;                            \
-    _value_type __hashtable_phantom_value__;                        \
-    (_table_ptr) = __hashtable_create_impl(                         \
-      sizeof(_key_type), sizeof(_value_type),                       \
-      get_default_hash_function(__hashtable_phantom_key__),         \
-      get_default_size_policy(__hashtable_phantom_key__),           \
-      get_default_size_policy(__hashtable_phantom_value__),         \
-      get_default_get_size_function(__hashtable_phantom_key__),     \
-      get_default_get_size_function(__hashtable_phantom_value__),   \
-      get_default_key_compare_function(__hashtable_phantom_key__)); \
+// Variable-size keys and values are copied into `_arena' instead of being
+// allocated one by one. They live as long as the arena, destroying the table
+// only frees its slots.
+#define hashtable_create_in_arena(_table_ptr, _key_type, _value_type, _arena) \
+  {                                                                           \
+    _key_type __hashtable_phantom_key__;                                      \
+    _value_type __hashtable_phantom_value__;                                  \
+    (_table_ptr) = __hashtable_create_impl(                                   \
+      sizeof(_key_type), sizeof(_value_type),                                 \
+      get_default_hash_function(__hashtable_phantom_key__),                   \
+      get_default_size_policy(__hashtable_phantom_key__),                     \
+      get_default_size_policy(__hashtable_phantom_value__),                   \
+      get_default_get_size_function(__hashtable_phantom_key__),               \
+      get_default_get_size_function(__hashtable_phantom_value__),             \
+      get_default_key_compare_function(__hashtable_phantom_key__),            \
+      (_arena));                                                              \
   }
 
 #define hashtable_create_raw(_key_type, _value_type, _hash_function_ptr, \
@@ -30,11 +66,11 @@ typedef void (*hashtable_foreach_function_t)(const void *key,
                              _get_key_size_function_ptr,                 \
                              _get_value_size_function_ptr,               \
                              _key_compare_function_ptr)                  \
-  hashtable_create(sizeof(_key_type), sizeof(_value_type),               \
-                   (_hash_function_ptr), (_key_size_policy),             \
-                   (_value_size_policy), (_get_key_size_function_ptr),   \
-                   (_get_value_size_function_ptr),                       \
-                   (_key_compare_function_ptr))
+  __hashtable_create_impl(                                               \
+    sizeof(_key_type), sizeof(_value_type), (_hash_function_ptr),        \
+    (_key_size_policy), (_value_size_policy),                            \
+    (_get_key_size_function_ptr), (_get_value_size_function_ptr),        \
+    (_key_compare_function_ptr), nullptr)
 
 #define hashtable_put(_table, _key, _value)                                  \
   {                                                                          \
@@ -63,16 +99,34 @@ b8 hashtable_is_empty(hashtable_t *table);
 sz hashtable_get_size(hashtable_t *table);
 void hashtable_foreach(hashtable_t *table,
                        hashtable_foreach_function_t foreach_function);
+void hashtable_foreach_ctx(hashtable_t *table,
+                           hashtable_foreach_ctx_function_t foreach_function,
+                           void *ctx);
+// Makes room for `n' entries in total, so inserting them never rehashes.
+void hashtable_reserve(hashtable_t *table, sz n);
+// `keys' and `values' are arrays of `n' elements of the table's types, for
+// variable-size keys or values that is an array of pointers.
+void hashtable_insert_many(hashtable_t *table, const void *keys,
+                           const void *values, sz n);
+// Removes every entry but keeps the capacity.
+void hashtable_clear(hashtable_t *table);
+hashtable_cursor_t hashtable_cursor_create(hashtable_t *table);
+b8 hashtable_cursor_next(hashtable_cursor_t *cursor);
 
 hashtable_t *__hashtable_create_impl(
   sz key_size, sz value_size, hash_function_t hash_function,
   size_policy_t key_size_policy, size_policy_t value_size_policy,
   get_size_function_t get_key_size_function,
   get_size_function_t get_value_size_function,
-  compare_function_t key_compare_function);
+  compare_function_t key_compare_function, alloc_arena_t *storage_arena);
 hashtable_t *__hashtable_put_impl(hashtable_t *table, const void *key,
                                   const void *value);
 const void *__hashtable_get_impl(hashtable_t *table, const void *key);
+// For callers that already hashed `key' with the table's hash function.
+hashtable_t *__hashtable_put_hashed_impl(hashtable_t *table, const void *key,
+                                         hash_t hash, const void *value);
+const void *__hashtable_get_hashed_impl(hashtable_t *table, const void *key,
+                                        hash_t hash);
 void __hashtable_remove_impl(hashtable_t *table, const void *key);
 
 #define __hashtable_arg_macro(_X) \
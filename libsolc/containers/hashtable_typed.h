@@ -0,0 +1,193 @@
+#ifndef __SOLC_CONTAINERS_HASHTABLE_TYPED_H__
+#define __SOLC_CONTAINERS_HASHTABLE_TYPED_H__
+
+#include "allocs/alloc_heap.h"
+#include "containers/swiss_group.h"
+#include "hash.h"
+#include "solc/defs.h"
+#include <string.h>
+
+// Generates a hashtable specialized for `_K' keys and `_V' values, both stored
+// by value. `_hash(key)' returns a `hash_t' and `_eq(a, b)' compares two keys,
+// either may be a function or a function-like macro, so lookups have no
+// indirect calls and every copy has a fixed size:
+//
+//   #define symbol_id_eq(_a, _b) ((_a) == (_b))
+//   SOLC_DEFINE_HASHTABLE(symbol_table, u64, solc_ast_t *, hash_u64,
+//                         symbol_id_eq)
+//
+//   symbol_table_t table = symbol_table_create();
+//   symbol_table_put(&table, id, node);
+//   solc_ast_t **node = symbol_table_get(&table, id);
+//   symbol_table_destroy(&table);
+//
+// Pointers returned by `_get()' and `_put()' stay valid until the next
+// `_put()' or `_remove()'. Keys and values own nothing, a table of pointers
+// does not free what they point to.
+#define SOLC_DEFINE_HASHTABLE(_name, _K, _V, _hash, _eq)                      \
+  typedef struct {                                                            \
+    swiss_ctrl_t *ctrl;                                                       \
+    _K *keys;                                                                 \
+    _V *values;                                                               \
+    sz size;                                                                  \
+    sz filled;                                                                \
+    sz deleted;                                                               \
+  } _name##_t;                                                                \
+                                                                              \
+  static inline void _name##__alloc(_name##_t *table, sz size)                \
+  {                                                                           \
+    /* Control bytes come in whole groups, so the slots stay 16 aligned. */   \
+    char *block = alloc_heap_malloc(SOLC_MEM_TAG_HASHTABLE,                   \
+                                    size * (1 + sizeof(_K) + sizeof(_V)));    \
+    memset(block, SWISS_CTRL_EMPTY, size);                                    \
+    table->ctrl = (swiss_ctrl_t *)block;                                      \
+    table->keys = (_K *)(block + size);                                       \
+    table->values = (_V *)(block + size + size * sizeof(_K));                 \
+    table->size = size;                                                       \
+    table->deleted = 0;                                                       \
+  }                                                                           \
+                                                                              \
+  static inline _name##_t _name##_create(void)                                \
+  {                                                                           \
+    _name##_t table = { 0 };                                                  \
+    _name##__alloc(&table, SOLC_HASHTABLE_TYPED_INITIAL_SIZE);                \
+    return table;                                                             \
+  }                                                                           \
+                                                                              \
+  static inline void _name##_destroy(_name##_t *table)                        \
+  {                                                                           \
+    SOLC_ASSUME(table != nullptr);                                            \
+    alloc_heap_free(table->ctrl);                                             \
+    memset(table, 0, sizeof(_name##_t));                                      \
+  }                                                                           \
+                                                                              \
+  static inline sz _name##_get_size(const _name##_t *table)                   \
+  {                                                                           \
+    return table->filled;                                                     \
+  }                                                                           \
+                                                                              \
+  static inline b8 _name##__find(const _name##_t *table, _K key, hash_t hash, \
+                                 sz *out_pos)                                 \
+  {                                                                           \
+    const sz groups_mask = table->size / SWISS_GROUP_WIDTH - 1;               \
+    const swiss_ctrl_t h2 = hash & 0x7F;                                      \
+    sz group_pos = (hash >> 7) & groups_mask;                                 \
+                                                                              \
+    for (sz step = 1;; step++) {                                              \
+      const sz base = group_pos * SWISS_GROUP_WIDTH;                          \
+      const swiss_group_t group = swiss_group_load(&table->ctrl[base]);       \
+                                                                              \
+      for (swiss_bitmask_t match = swiss_group_match(group, h2); match != 0;  \
+           match = swiss_bitmask_next(match)) {                               \
+        const sz pos = base + swiss_bitmask_lowest(match);                    \
+        if SOLC_LIKELY (_eq(table->keys[pos], key)) {                         \
+          *out_pos = pos;                                                     \
+          return true;                                                        \
+        }                                                                     \
+      }                                                                       \
+                                                                              \
+      if SOLC_LIKELY (swiss_group_match_empty(group) != 0)                    \
+        return false;                                                         \
+                                                                              \
+      group_pos = (group_pos + step) & groups_mask;                           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static inline sz _name##__find_free(const _name##_t *table, hash_t hash)    \
+  {                                                                           \
+    const sz groups_mask = table->size / SWISS_GROUP_WIDTH - 1;               \
+    sz group_pos = (hash >> 7) & groups_mask;                                 \
+                                                                              \
+    for (sz step = 1;; step++) {                                              \
+      const sz base = group_pos * SWISS_GROUP_WIDTH;                          \
+      const swiss_bitmask_t free_mask = swiss_group_match_empty_or_deleted(   \
+        swiss_group_load(&table->ctrl[base]));                                \
+      if SOLC_LIKELY (free_mask != 0)                                         \
+        return base + swiss_bitmask_lowest(free_mask);                        \
+                                                                              \
+      group_pos = (group_pos + step) & groups_mask;                           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* Grows, or only drops tombstones when they are most of the load. */       \
+  static inline void _name##__rehash(_name##_t *table)                        \
+  {                                                                           \
+    const _name##_t old = *table;                                             \
+    const sz max_filled = old.size - old.size / 8;                            \
+    _name##__alloc(table, table->filled <= max_filled / 2 ? old.size :        \
+                                                            old.size * 2);    \
+                                                                              \
+    for (sz i = 0; i < old.size; i++) {                                       \
+      if ((old.ctrl[i] & SWISS_CTRL_EMPTY) != 0)                              \
+        continue;                                                             \
+                                                                              \
+      const sz pos = _name##__find_free(table, _hash(old.keys[i]));           \
+      table->ctrl[pos] = old.ctrl[i];                                         \
+      table->keys[pos] = old.keys[i];                                         \
+      table->values[pos] = old.values[i];                                     \
+    }                                                                         \
+                                                                              \
+    alloc_heap_free(old.ctrl);                                                \
+  }                                                                           \
+                                                                              \
+  static inline _V *_name##_get(const _name##_t *table, _K key)               \
+  {                                                                           \
+    SOLC_ASSUME(table != nullptr);                                            \
+    sz pos;                                                                   \
+    if (!_name##__find(table, key, _hash(key), &pos))                         \
+      return nullptr;                                                         \
+    return &table->values[pos];                                               \
+  }                                                                           \
+                                                                              \
+  /* Inserts or overwrites, returns where the value is stored. */             \
+  static inline _V *_name##_put(_name##_t *table, _K key, _V value)           \
+  {                                                                           \
+    SOLC_ASSUME(table != nullptr);                                            \
+    const hash_t hash = _hash(key);                                           \
+    sz pos;                                                                   \
+    if (_name##__find(table, key, hash, &pos)) {                              \
+      table->values[pos] = value;                                             \
+      return &table->values[pos];                                             \
+    }                                                                         \
+                                                                              \
+    if SOLC_UNLIKELY (table->filled + table->deleted + 1 >                    \
+                      table->size - table->size / 8)                          \
+      _name##__rehash(table);                                                 \
+                                                                              \
+    pos = _name##__find_free(table, hash);                                    \
+    if (table->ctrl[pos] == SWISS_CTRL_DELETED)                               \
+      table->deleted--;                                                       \
+    table->ctrl[pos] = hash & 0x7F;                                           \
+    table->keys[pos] = key;                                                   \
+    table->values[pos] = value;                                               \
+    table->filled++;                                                          \
+    return &table->values[pos];                                               \
+  }                                                                           \
+                                                                              \
+  static inline b8 _name##_remove(_name##_t *table, _K key)                   \
+  {                                                                           \
+    SOLC_ASSUME(table != nullptr);                                            \
+    sz pos;                                                                   \
+    if (!_name##__find(table, key, _hash(key), &pos))                         \
+      return false;                                                           \
+                                                                              \
+    const sz base = pos & ~(sz)(SWISS_GROUP_WIDTH - 1);                       \
+    if (swiss_group_match_empty(swiss_group_load(&table->ctrl[base])) != 0) { \
+      table->ctrl[pos] = SWISS_CTRL_EMPTY;                                    \
+    } else {                                                                  \
+      table->ctrl[pos] = SWISS_CTRL_DELETED;                                  \
+      table->deleted++;                                                       \
+    }                                                                         \
+    table->filled--;                                                          \
+    return true;                                                              \
+  }
+
+#define SOLC_HASHTABLE_TYPED_INITIAL_SIZE 64
+
+_Static_assert((SOLC_HASHTABLE_TYPED_INITIAL_SIZE &
+                (SOLC_HASHTABLE_TYPED_INITIAL_SIZE - 1)) == 0 &&
+                 SOLC_HASHTABLE_TYPED_INITIAL_SIZE >= SWISS_GROUP_WIDTH,
+               "SOLC_HASHTABLE_TYPED_INITIAL_SIZE must be a power of two of "
+               "whole groups");
+
+#endif // __SOLC_CONTAINERS_HASHTABLE_TYPED_H__
@@ -0,0 +1,29 @@
+#include "containers/small_vector.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
+#include "solc/defs.h"
+#include <string.h>
+
+#define SMALL_VECTOR_GROWTH_FACTOR 2
+
+void __small_vector_grow(u32 *capacity, void *storage, sz inline_size,
+                         sz stride, u32 length, solc_mem_tag_t tag)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(capacity != nullptr && storage != nullptr && stride > 0);
+
+  const b8 is_inline = *capacity == 0;
+  const sz old_capacity = is_inline ? inline_size / stride : *capacity;
+  const sz new_capacity =
+    SOLC_MAX(old_capacity * SMALL_VECTOR_GROWTH_FACTOR, (sz)1);
+  SOLC_ASSERT(new_capacity <= UINT32_MAX);
+
+  void *old_data = is_inline ? storage : *(void **)storage;
+  void *new_data = alloc_heap_malloc(tag, new_capacity * stride);
+  memcpy(new_data, old_data, (sz)length * stride);
+  if (!is_inline)
+    alloc_heap_free(old_data);
+
+  *(void **)storage = new_data;
+  *capacity = (u32)new_capacity;
+}
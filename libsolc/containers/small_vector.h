@@ -0,0 +1,70 @@
+#ifndef __SOLC_CONTAINER_SMALL_VECTOR_H__
+#define __SOLC_CONTAINER_SMALL_VECTOR_H__
+
+#include "allocs/alloc_heap.h"
+#include "solc/defs.h"
+#include "solc/mem_stats.h"
+
+// A vector whose first `_n' elements live inside the struct itself, it only
+// allocates once it outgrows them:
+//
+//   small_vector_t(solc_ast_t *, 2) children;
+//   small_vector_init(&children);
+//   small_vector_push(&children, child_ast, SOLC_MEM_TAG_AST);
+//   solc_ast_t **child_asts = small_vector_data(&children);
+//   small_vector_destroy(&children);
+//
+// Inline elements move along with the struct, so pointers returned by
+// `small_vector_data()' do not survive a copy of it or a push.
+#define small_vector_t(_type, _n)                                     \
+  struct {                                                            \
+    u32 length;                                                       \
+    /* Elements that fit without growing, 0 while they are inline. */ \
+    u32 capacity;                                                     \
+    union {                                                           \
+      _type *heap_data;                                               \
+      _type inline_data[_n];                                          \
+    };                                                                \
+  }
+
+#define small_vector_init(_sv) \
+  {                            \
+    (_sv)->length = 0;         \
+    (_sv)->capacity = 0;       \
+  }
+
+#define small_vector_destroy(_sv)        \
+  {                                      \
+    if ((_sv)->capacity != 0)            \
+      alloc_heap_free((_sv)->heap_data); \
+    small_vector_init((_sv));            \
+  }
+
+#define small_vector_data(_sv) \
+  ((_sv)->capacity == 0 ? (_sv)->inline_data : (_sv)->heap_data)
+
+#define small_vector_get_length(_sv) ((sz)(_sv)->length)
+
+#define small_vector_get_capacity(_sv)                            \
+  ((_sv)->capacity == 0 ?                                         \
+     sizeof((_sv)->inline_data) / sizeof((_sv)->inline_data[0]) : \
+     (sz)(_sv)->capacity)
+
+// Spills to the heap under `_tag' once the inline elements are full.
+#define small_vector_push(_sv, _val, _tag)                              \
+  {                                                                     \
+    if SOLC_UNLIKELY (small_vector_get_length((_sv)) ==                 \
+                      small_vector_get_capacity((_sv)))                 \
+      __small_vector_grow(&(_sv)->capacity, &(_sv)->heap_data,          \
+                          sizeof((_sv)->inline_data),                   \
+                          sizeof((_sv)->inline_data[0]), (_sv)->length, \
+                          (_tag));                                      \
+    small_vector_data((_sv))[(_sv)->length++] = (_val);                 \
+  }
+
+// `storage' is the union of the heap pointer and the `inline_size' bytes of
+// inline elements.
+void __small_vector_grow(u32 *capacity, void *storage, sz inline_size,
+                         sz stride, u32 length, solc_mem_tag_t tag);
+
+#endif // __SOLC_CONTAINER_SMALL_VECTOR_H__
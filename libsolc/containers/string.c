@@ -1,98 +1,185 @@
 #include "containers/string.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
 #include "solc/defs.h"
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define STRING_ALLOC(_size) alloc_heap_malloc(SOLC_MEM_TAG_STRING, (_size))
+#define STRING_GROWTH_FACTOR 2
+
+static inline char *string_data(string_t *str);
+static inline sz string_get_capacity(const string_t *str);
+static char *string_grow(const string_t *str, sz length, sz *new_capacity);
+static void string_adopt(string_t *str, char *data, sz capacity);
+static void string_append_len(string_t *dst, const char *src, sz len);
+
 string_t string_create(void)
 {
-  char *data = malloc(sizeof(char) * 1);
-  data[0] = 0;
   string_t out = {
-    .size = 1,
-    .data = data,
+    .length = 0,
+    .capacity = 0,
   };
+  out.inline_data[0] = 0;
   return out;
 }
 
 string_t string_create_from(const char *c_str)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(c_str != nullptr);
-  const sz c_str_size = strlen(c_str) + 1;
-  char *data = malloc(sizeof(char) * c_str_size);
-  memcpy(data, c_str, sizeof(char) * c_str_size);
-  string_t out = {
-    .size = c_str_size,
-    .data = data,
-  };
+  string_t out = string_create();
+  string_append_len(&out, c_str, strlen(c_str));
   return out;
 }
 
 string_t string_copy(const string_t *str)
 {
-  SOLC_ASSUME(str != nullptr && str->data != nullptr && str->size > 0);
-  char *data = malloc(sizeof(char) * str->size);
-  memcpy(data, str->data, sizeof(char) * str->size);
-  string_t out = {
-    .size = str->size,
-    .data = data,
-  };
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(str != nullptr);
+  string_t out = string_create();
+  string_append_len(&out, string_cstr(str), str->length);
   return out;
 }
 
 void string_destroy(string_t *str)
 {
-  SOLC_ASSUME(str != nullptr && str->data != nullptr);
-  free(str->data);
-  str->size = 0;
-  str->data = nullptr;
+  SOLC_ASSUME(str != nullptr);
+  if (str->capacity != 0)
+    alloc_heap_free(str->heap_data);
+  *str = string_create();
+}
+
+const char *string_cstr(const string_t *str)
+{
+  SOLC_ASSUME(str != nullptr);
+  return str->capacity != 0 ? str->heap_data : str->inline_data;
 }
 
 char string_at(string_t *str, sz pos)
 {
   SOLC_ASSUME(str != nullptr);
-  return pos < str->size ? str->data[pos] : 0;
+  return pos < str->length ? string_cstr(str)[pos] : 0;
+}
+
+void string_reserve(string_t *str, sz length)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(str != nullptr);
+
+  if (length <= string_get_capacity(str))
+    return;
+
+  sz new_capacity;
+  char *new_data = string_grow(str, length, &new_capacity);
+  string_adopt(str, new_data, new_capacity);
 }
 
 void string_append(string_t *dst, string_t *src)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(dst != nullptr && src != nullptr);
-  char *new_data = malloc(sizeof(char) * (dst->size - 1 + src->size));
-  if (dst->size > 1) {
-    memcpy(new_data, dst->data, sizeof(char) * (dst->size - 1));
-  }
-  memcpy(new_data + (dst->size - 1), src->data, src->size);
-  free(dst->data);
-  dst->data = new_data;
-  dst->size += src->size - 1;
+  string_append_len(dst, string_cstr(src), src->length);
 }
 
 void string_append_cstr(string_t *dst, const char *c_str)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(dst != nullptr && c_str != nullptr);
-
-  const sz c_str_len = strlen(c_str);
-  char *new_data = malloc(sizeof(char) * (dst->size + c_str_len));
-  memcpy(new_data, dst->data, sizeof(char) * (dst->size - 1));
-  memcpy(new_data + (dst->size - 1), c_str, c_str_len + 1);
-  free(dst->data);
-  dst->data = new_data;
-  dst->size += c_str_len;
+  string_append_len(dst, c_str, strlen(c_str));
 }
 
 void string_append_char(string_t *dst, char c)
 {
+  ALLOC_TRACE_SITE();
   SOLC_ASSUME(dst != nullptr);
-  char *new_data = malloc(sizeof(char) * (dst->size + 1));
-  memcpy(new_data, dst->data, sizeof(char) * (dst->size - 1));
-  new_data[dst->size - 1] = c;
-  new_data[dst->size] = 0;
-  free(dst->data);
-  dst->data = new_data;
-  dst->size++;
+  string_append_len(dst, &c, 1);
+}
+
+void string_append_fmt(string_t *dst, const char *fmt, ...)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(dst != nullptr && fmt != nullptr);
+
+  va_list args;
+  va_start(args, fmt);
+  va_list retry_args;
+  va_copy(retry_args, args);
+
+  // Most of the time the spare capacity is enough and this is the only pass.
+  char *data = string_data(dst);
+  const sz spare = string_get_capacity(dst) - dst->length;
+  const s32 len = vsnprintf(data + dst->length, spare + 1, fmt, args);
+  va_end(args);
+  SOLC_ASSERT(len >= 0);
+
+  if ((sz)len > spare) {
+    // The arguments may point into the old buffer, it is left as it was
+    // until the second pass has read them.
+    data[dst->length] = 0;
+    sz new_capacity;
+    char *new_data = string_grow(dst, dst->length + (sz)len, &new_capacity);
+    vsnprintf(new_data + dst->length, (sz)len + 1, fmt, retry_args);
+    string_adopt(dst, new_data, new_capacity);
+  }
+  va_end(retry_args);
+
+  dst->length += (sz)len;
 }
 
 sz string_length(const string_t *str)
 {
-  SOLC_ASSUME(str != nullptr && str->size > 0);
-  return str->size - 1;
+  SOLC_ASSUME(str != nullptr);
+  return str->length;
+}
+
+static inline char *string_data(string_t *str)
+{
+  return str->capacity != 0 ? str->heap_data : str->inline_data;
+}
+
+static inline sz string_get_capacity(const string_t *str)
+{
+  return str->capacity != 0 ? str->capacity : STRING_INLINE_CAPACITY - 1;
+}
+
+// A copy of the characters with room for `length' of them, `str' itself is
+// left untouched.
+static char *string_grow(const string_t *str, sz length, sz *new_capacity)
+{
+  const sz capacity = string_get_capacity(str);
+  *new_capacity = SOLC_MAX(length, capacity * STRING_GROWTH_FACTOR);
+  char *new_data = STRING_ALLOC(*new_capacity + 1);
+  memcpy(new_data, string_cstr(str), str->length + 1);
+  return new_data;
+}
+
+static void string_adopt(string_t *str, char *data, sz capacity)
+{
+  if (str->capacity != 0)
+    alloc_heap_free(str->heap_data);
+  str->heap_data = data;
+  str->capacity = capacity;
+}
+
+// `src' may point into `dst', it is copied before the old buffer is freed.
+static void string_append_len(string_t *dst, const char *src, sz len)
+{
+  const sz length = dst->length + len;
+  if (length <= string_get_capacity(dst)) {
+    char *data = string_data(dst);
+    memcpy(data + dst->length, src, len);
+    data[length] = 0;
+    dst->length = length;
+    return;
+  }
+
+  sz new_capacity;
+  char *new_data = string_grow(dst, length, &new_capacity);
+  memcpy(new_data + dst->length, src, len);
+  new_data[length] = 0;
+  string_adopt(dst, new_data, new_capacity);
+  dst->length = length;
 }
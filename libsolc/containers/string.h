@@ -3,19 +3,40 @@
 
 #include "solc/defs.h"
 
+// Strings shorter than this are kept inside `string_t' itself.
+#define STRING_INLINE_CAPACITY 24
+
+// A NUL-terminated string that grows its buffer geometrically. The inline
+// buffer moves along with the struct, so the characters are only reachable
+// through `string_cstr()', never through a pointer kept from before a copy.
 typedef struct {
-  sz size;
-  char *data;
+  sz length;
+  // Characters that fit without growing (not counting the NUL), 0 while they
+  // are stored in `inline_data'.
+  sz capacity;
+  union {
+    char *heap_data;
+    char inline_data[STRING_INLINE_CAPACITY];
+  };
 } string_t;
 
 string_t string_create(void);
 string_t string_create_from(const char *c_str);
 string_t string_copy(const string_t *str);
 void string_destroy(string_t *str);
+const char *string_cstr(const string_t *str);
 char string_at(string_t *str, sz pos);
+// Makes room for `length' characters, so appending up to them never
+// reallocates.
+void string_reserve(string_t *str, sz length);
 void string_append(string_t *dst, string_t *src);
 void string_append_cstr(string_t *dst, const char *c_str);
 void string_append_char(string_t *dst, char c);
+// Formats like `printf()' straight into the end of `dst'. The text of `dst'
+// itself may only be read by a leading `%s', the output is written over its
+// terminator.
+__attribute__((format(printf, 2, 3))) void
+string_append_fmt(string_t *dst, const char *fmt, ...);
 sz string_length(const string_t *str);
 
 #endif // __SOLC_CONTAINER_STRING_H__
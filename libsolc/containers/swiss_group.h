@@ -0,0 +1,105 @@
+#ifndef __SOLC_CONTAINERS_SWISS_GROUP_H__
+#define __SOLC_CONTAINERS_SWISS_GROUP_H__
+
+#include "solc/defs.h"
+#include <string.h>
+
+// Control bytes shared by `hashtable_t' and `hashset_t'. A full slot stores
+// the 7 bit `h2' of its key's hash, so the high bit is only ever set for free
+// slots.
+typedef u8 swiss_ctrl_t;
+typedef enum {
+  SWISS_CTRL_EMPTY = 0b10000000,
+  SWISS_CTRL_DELETED = 0b11111111,
+} swiss_ctrl_flags_t;
+
+// Slots are probed a group at a time: the control bytes of a group are
+// compared at once and the result is a bitmask with one entry per slot.
+// With SSE2 a group is 16 slots and an entry is a bit, the portable fallback
+// works on 8 slots packed in a `u64' and an entry is the high bit of a byte.
+#ifdef __SSE2__
+#include <emmintrin.h>
+
+#define SWISS_GROUP_WIDTH 16
+#define SWISS_BITMASK_SHIFT 0
+
+typedef __m128i swiss_group_t;
+typedef u32 swiss_bitmask_t;
+#else
+#define SWISS_GROUP_WIDTH 8
+#define SWISS_BITMASK_SHIFT 3
+
+typedef u64 swiss_group_t;
+typedef u64 swiss_bitmask_t;
+
+#define SWISS_SWAR_LSBS 0x0101010101010101ULL
+#define SWISS_SWAR_MSBS 0x8080808080808080ULL
+#endif
+
+static inline swiss_group_t swiss_group_load(const swiss_ctrl_t *ctrl)
+{
+#ifdef __SSE2__
+  return _mm_loadu_si128((const __m128i *)ctrl);
+#else
+  u64 group;
+  memcpy(&group, ctrl, sizeof(group));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  group = __builtin_bswap64(group);
+#endif
+  return group;
+#endif
+}
+
+// Slots whose control byte is `h2'. The fallback may report a false positive
+// right after a real match, keys are compared anyway.
+static inline swiss_bitmask_t swiss_group_match(swiss_group_t group,
+                                                swiss_ctrl_t h2)
+{
+#ifdef __SSE2__
+  return (swiss_bitmask_t)_mm_movemask_epi8(
+    _mm_cmpeq_epi8(_mm_set1_epi8((char)h2), group));
+#else
+  const u64 x = group ^ (SWISS_SWAR_LSBS * h2);
+  return (x - SWISS_SWAR_LSBS) & ~x & SWISS_SWAR_MSBS;
+#endif
+}
+
+static inline swiss_bitmask_t swiss_group_match_empty(swiss_group_t group)
+{
+#ifdef __SSE2__
+  return (swiss_bitmask_t)_mm_movemask_epi8(
+    _mm_cmpeq_epi8(_mm_set1_epi8((char)SWISS_CTRL_EMPTY), group));
+#else
+  // Empty is the only control byte with the high bit set and the next one
+  // clear.
+  return group & ~(group << 1) & SWISS_SWAR_MSBS;
+#endif
+}
+
+static inline swiss_bitmask_t
+swiss_group_match_empty_or_deleted(swiss_group_t group)
+{
+#ifdef __SSE2__
+  return (swiss_bitmask_t)_mm_movemask_epi8(group);
+#else
+  return group & SWISS_SWAR_MSBS;
+#endif
+}
+
+// Index of the first matching slot in the group, `mask' must not be 0.
+static inline sz swiss_bitmask_lowest(swiss_bitmask_t mask)
+{
+  SOLC_ASSUME(mask != 0);
+#ifdef __SSE2__
+  return (sz)__builtin_ctz(mask) >> SWISS_BITMASK_SHIFT;
+#else
+  return (sz)__builtin_ctzll(mask) >> SWISS_BITMASK_SHIFT;
+#endif
+}
+
+static inline swiss_bitmask_t swiss_bitmask_next(swiss_bitmask_t mask)
+{
+  return mask & (mask - 1);
+}
+
+#endif // __SOLC_CONTAINERS_SWISS_GROUP_H__
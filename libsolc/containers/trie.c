@@ -1,50 +1,183 @@
 #include "containers/trie.h"
 #include "allocs/alloc_arena.h"
+#include "containers/vector.h"
 #include "global.h"
 #include "solc/defs.h"
 #include <stdlib.h>
+#include <string.h>
 
-typedef struct __trie_node_t {
-  struct __trie_node_t *children[0x100];
+// A radix trie: every edge is labelled with a run of characters, so a node
+// only exists where two keys part ways or one ends. The children of a node
+// are a contiguous block of `nodes', and `firsts' holds the first character
+// of every node's label at the same index, so picking a child is a scan over
+// a few bytes. The root is node 0, it has the widest fan-out and sees every
+// lookup, so its children are also indexed by their first character.
+typedef struct {
   void *data_ptr;
+  // `labels[label]' up to `label_len' characters, never empty below the root.
+  u32 label;
+  u16 label_len;
+  // Labels never start with NUL, so there are at most 255 children.
+  u8 children_num;
+  u32 children;
 } trie_node_t;
 
 typedef struct __trie_t {
-  trie_node_t *root;
+  trie_node_t *nodes;
+  u8 *firsts;
+  char *labels;
+  // One past the position of the root's child in its block, 0 for none.
+  u8 root_children[0x100];
 } trie_t;
 
+static inline u32 trie_find_child(const trie_t *trie, u32 parent, char c);
+static u32 trie_add_child(trie_t *trie, u32 parent, trie_node_t child,
+                          u8 first);
+static u32 trie_add_label(trie_t *trie, const char *str, sz len);
+
 trie_t *trie_create(void)
 {
   trie_t *out_trie = alloc_arena_allocate(global_arena_alloc(), sizeof(trie_t));
-  out_trie->root =
-    alloc_arena_allocate(global_arena_alloc(), sizeof(trie_node_t));
+  out_trie->nodes = vector_create_in_arena(trie_node_t, global_arena_alloc());
+  out_trie->firsts = vector_create_in_arena(u8, global_arena_alloc());
+  out_trie->labels = vector_create_in_arena(char, global_arena_alloc());
+  vector_push(out_trie->nodes, (trie_node_t){ 0 });
+  vector_push(out_trie->firsts, (u8)0);
+  memset(out_trie->root_children, 0, sizeof(out_trie->root_children));
   return out_trie;
 }
 
 void trie_insert(trie_t *trie, const char *str, void *data_ptr)
 {
   SOLC_ASSUME(trie != nullptr && str != nullptr && data_ptr != nullptr);
-  trie_node_t *cur = trie->root;
-  for (; *str; str++) {
-    if (cur->children[(sz)*str] == nullptr) {
-      trie_node_t *new_node =
-        alloc_arena_allocate(global_arena_alloc(), sizeof(trie_node_t));
-      cur->children[(sz)*str] = new_node;
+
+  u32 cur = 0;
+  while (*str) {
+    const u32 child = trie_find_child(trie, cur, *str);
+    if (child == 0) {
+      const sz len = strlen(str);
+      SOLC_ASSERT(len <= UINT16_MAX);
+      trie_add_child(trie, cur,
+                     (trie_node_t){
+                       .data_ptr = data_ptr,
+                       .label = trie_add_label(trie, str, len),
+                       .label_len = (u16)len,
+                     },
+                     (u8)*str);
+      return;
     }
-    cur = cur->children[(sz)*str];
+
+    const trie_node_t node = trie->nodes[child];
+    const char *label = &trie->labels[node.label];
+    u16 common = 1;
+    while (common < node.label_len && label[common] == str[common])
+      common++;
+
+    // The key leaves the label half way, its tail moves into a new node that
+    // takes over the children and the data.
+    if (common < node.label_len) {
+      trie->nodes[child] = (trie_node_t){
+        .label = node.label,
+        .label_len = common,
+      };
+      trie_add_child(trie, child,
+                     (trie_node_t){
+                       .data_ptr = node.data_ptr,
+                       .label = node.label + common,
+                       .label_len = node.label_len - common,
+                       .children_num = node.children_num,
+                       .children = node.children,
+                     },
+                     (u8)label[common]);
+    }
+
+    cur = child;
+    str += common;
   }
 
-  cur->data_ptr = data_ptr;
+  trie->nodes[cur].data_ptr = data_ptr;
 }
 
 void *trie_get(trie_t *trie, const char *str)
 {
   SOLC_ASSUME(trie != nullptr && str != nullptr);
-  trie_node_t *cur = trie->root;
-  for (; *str; str++) {
-    if (cur->children[(sz)*str] == nullptr)
+
+  u32 cur = 0;
+  const trie_node_t *node = &trie->nodes[cur];
+  while (*str) {
+    cur = trie_find_child(trie, cur, *str);
+    if (cur == 0)
       return nullptr;
-    cur = cur->children[(sz)*str];
+
+    // Labels hold no NUL, so a key that ends early mismatches here too.
+    node = &trie->nodes[cur];
+    const char *label = &trie->labels[node->label];
+    for (u16 i = 1; i < node->label_len; i++)
+      if (label[i] != str[i])
+        return nullptr;
+    str += node->label_len;
   }
-  return cur->data_ptr;
+
+  return node->data_ptr;
+}
+
+sz trie_get_memory_usage(trie_t *trie)
+{
+  SOLC_ASSUME(trie != nullptr);
+  return sizeof(trie_t) +
+         vector_get_capacity(trie->nodes) * sizeof(trie_node_t) +
+         vector_get_capacity(trie->firsts) + vector_get_capacity(trie->labels);
+}
+
+// Keywords fan out to a handful of children, a linear scan over their first
+// characters beats any lookup structure at that size. Returns 0 (the root)
+// if there is no such child.
+static inline u32 trie_find_child(const trie_t *trie, u32 parent, char c)
+{
+  const trie_node_t *node = &trie->nodes[parent];
+  if (parent == 0) {
+    const u8 pos = trie->root_children[(u8)c];
+    return pos != 0 ? node->children + pos - 1 : 0;
+  }
+
+  const u8 *firsts = &trie->firsts[node->children];
+  for (u32 i = 0; i < node->children_num; i++)
+    if (firsts[i] == (u8)c)
+      return node->children + i;
+  return 0;
+}
+
+// Appends `child' to the block of `parent'. A block that does not end the
+// vectors is copied to the end first, the old copy is left unused.
+static u32 trie_add_child(trie_t *trie, u32 parent, trie_node_t child,
+                          u8 first)
+{
+  const trie_node_t node = trie->nodes[parent];
+  const u32 nodes_num = (u32)vector_get_length(trie->nodes);
+  SOLC_ASSERT(nodes_num + node.children_num < UINT32_MAX);
+
+  if (node.children_num == 0 ||
+      node.children + node.children_num != nodes_num) {
+    trie->nodes[parent].children = nodes_num;
+    for (u32 i = 0; i < node.children_num; i++) {
+      vector_push(trie->nodes, trie->nodes[node.children + i]);
+      vector_push(trie->firsts, trie->firsts[node.children + i]);
+    }
+  }
+
+  vector_push(trie->nodes, child);
+  vector_push(trie->firsts, first);
+  if (parent == 0)
+    trie->root_children[first] = trie->nodes[parent].children_num + 1;
+  trie->nodes[parent].children_num++;
+  return (u32)vector_get_length(trie->nodes) - 1;
+}
+
+static u32 trie_add_label(trie_t *trie, const char *str, sz len)
+{
+  const sz label = vector_get_length(trie->labels);
+  SOLC_ASSERT(label + len <= UINT32_MAX);
+  for (sz i = 0; i < len; i++)
+    vector_push(trie->labels, str[i]);
+  return (u32)label;
 }
@@ -1,6 +1,8 @@
 #ifndef __SOLC_CONTAINER_TRIE_H__
 #define __SOLC_CONTAINER_TRIE_H__
 
+#include "solc/defs.h"
+
 typedef struct __trie_t trie_t;
 
 trie_t *trie_create(void);
@@ -8,4 +10,7 @@ trie_t *trie_create(void);
 void trie_insert(trie_t *trie, const char *str, void *data_ptr);
 void *trie_get(trie_t *trie, const char *str);
 
+// Bytes held by the nodes and their labels.
+sz trie_get_memory_usage(trie_t *trie);
+
 #endif // __SOLC_CONTAINER_TRIE_H__
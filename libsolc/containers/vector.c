@@ -1,107 +1,167 @@
 #include "containers/vector.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct {
-  sz capacity;
-  sz stride;
-  sz len;
-} vector_header_t;
+#define VECTOR_GROWTH_FACTOR 2
 
-static inline vector_header_t *get_vector_header(const void *v);
-static inline void *vector_resize(void *v);
+static inline void *vector_init(__vector_header_t *header, sz cap, sz stride,
+                                alloc_arena_t *arena);
+static void *vector_set_capacity(void *v, sz capacity);
 
 void *__vector_create(sz cap, sz stride)
 {
-  void *v = malloc(sizeof(vector_header_t) + (cap * stride));
-  vector_header_t *header = v;
+  ALLOC_TRACE_SITE();
+  return __vector_create_tagged(cap, stride, SOLC_MEM_TAG_VECTOR);
+}
 
-  header->capacity = cap;
-  header->stride = stride;
-  header->len = 0;
+void *__vector_create_tagged(sz cap, sz stride, solc_mem_tag_t tag)
+{
+  ALLOC_TRACE_SITE();
+  __vector_header_t *header =
+    alloc_heap_malloc(tag, sizeof(__vector_header_t) + (cap * stride));
+  return vector_init(header, cap, stride, nullptr);
+}
 
-  v += sizeof(vector_header_t);
-  return v;
+void *__vector_create_in_arena(sz cap, sz stride, alloc_arena_t *arena)
+{
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(arena != nullptr);
+  __vector_header_t *header =
+    alloc_arena_allocate(arena, sizeof(__vector_header_t) + (cap * stride));
+  return vector_init(header, cap, stride, arena);
 }
 
 void __vector_destroy(void *v)
 {
-  v -= sizeof(vector_header_t);
-  free(v);
+  __vector_header_t *header = __vector_header(v);
+  if (header->arena != nullptr)
+    return;
+  alloc_heap_free(header);
 }
 
-void *__vector_push(void *v, const void *val)
+void *__vector_grow(void *v, sz additional)
 {
-  vector_header_t *header = get_vector_header(v);
-  if (header->len >= header->capacity) {
-    v = vector_resize(v);
-    header = get_vector_header(v);
-  }
-
-  memcpy(v + (header->len * header->stride), val, header->stride);
-  header->len++;
-
-  return v;
+  ALLOC_TRACE_SITE();
+  const __vector_header_t *header = __vector_header(v);
+  const sz needed = header->len + additional;
+  if (needed <= header->capacity)
+    return v;
+
+  return vector_set_capacity(
+    v, SOLC_MAX(needed, header->capacity * VECTOR_GROWTH_FACTOR));
 }
 
 void __vector_pop(void *v, void *out)
 {
-  if (vector_get_length(v) == 0) {
+  __vector_header_t *header = __vector_header(v);
+  if (header->len == 0)
     return;
-  }
 
-  vector_header_t *header = get_vector_header(v);
-  memcpy(out, v + ((header->len - 1) * header->stride), header->stride);
   header->len--;
+  memcpy(out, (char *)v + header->len * header->stride, header->stride);
 }
 
-void *vector_copy(const void *v)
+void *__vector_insert_gap(void *v, sz pos)
 {
-  vector_header_t *header = get_vector_header(v);
-
-  const sz n = sizeof(vector_header_t) + header->stride * header->capacity;
-  vector_header_t *new_vec = malloc(n);
-
-  memcpy(new_vec, header, n);
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(pos <= vector_get_length(v));
 
-  return (char *)new_vec + sizeof(vector_header_t);
+  v = __vector_grow(v, 1);
+  __vector_header_t *header = __vector_header(v);
+  char *at = (char *)v + pos * header->stride;
+  memmove(at + header->stride, at, (header->len - pos) * header->stride);
+  header->len++;
+  return v;
 }
 
-sz vector_get_capacity(const void *v)
+void *__vector_extend(void *v, const void *elements, sz n)
 {
-  return get_vector_header(v)->capacity;
+  ALLOC_TRACE_SITE();
+  SOLC_ASSUME(n == 0 || elements != nullptr);
+
+  v = __vector_grow(v, n);
+  __vector_header_t *header = __vector_header(v);
+  memcpy((char *)v + header->len * header->stride, elements,
+         n * header->stride);
+  header->len += n;
+  return v;
 }
 
-sz vector_get_stride(const void *v)
+void *__vector_ensure_capacity(void *v, sz capacity)
 {
-  return get_vector_header(v)->stride;
+  ALLOC_TRACE_SITE();
+  if (capacity <= vector_get_capacity(v))
+    return v;
+  return vector_set_capacity(v, capacity);
 }
 
-sz vector_get_length(const void *v)
+void *__vector_resize(void *v, sz len)
 {
-  return get_vector_header(v)->len;
+  ALLOC_TRACE_SITE();
+  const sz old_len = vector_get_length(v);
+  if (len > old_len) {
+    v = __vector_grow(v, len - old_len);
+    const sz stride = vector_get_stride(v);
+    memset((char *)v + old_len * stride, 0, (len - old_len) * stride);
+  }
+
+  __vector_header(v)->len = len;
+  return v;
 }
 
-void vector_clear(void *v)
+void *__vector_shrink_to_fit(void *v)
 {
-  vector_header_t *header = get_vector_header(v);
-  header->len = 0;
+  ALLOC_TRACE_SITE();
+  const __vector_header_t *header = __vector_header(v);
+  if (header->arena != nullptr || header->len == header->capacity)
+    return v;
+  return vector_set_capacity(v, header->len);
 }
 
-static inline vector_header_t *get_vector_header(const void *v)
+void *vector_copy(const void *v)
 {
-  return (vector_header_t *)(v - sizeof(vector_header_t));
+  ALLOC_TRACE_SITE();
+  const __vector_header_t *header = __vector_header(v);
+
+  const solc_mem_tag_t tag = header->arena != nullptr ?
+                               SOLC_MEM_TAG_VECTOR :
+                               alloc_heap_get_tag(header);
+  void *out_v = __vector_create_tagged(header->len, header->stride, tag);
+  memcpy(out_v, v, header->len * header->stride);
+  __vector_header(out_v)->len = header->len;
+
+  return out_v;
 }
 
-static inline void *vector_resize(void *v)
+static inline void *vector_init(__vector_header_t *header, sz cap, sz stride,
+                                alloc_arena_t *arena)
 {
-  vector_header_t *old_header = get_vector_header(v);
+  header->capacity = cap;
+  header->stride = stride;
+  header->len = 0;
+  header->arena = arena;
 
-  void *newv = __vector_create(old_header->capacity * 2, old_header->stride);
-  memcpy(newv, v, old_header->capacity * old_header->stride);
-  vector_header_t *newv_header = get_vector_header(newv);
-  newv_header->len = old_header->len;
+  return header + 1;
+}
+
+// Heap vectors are reallocated in place when the allocator can, arena vectors
+// move to a new allocation and leave the old one to the arena.
+static void *vector_set_capacity(void *v, sz capacity)
+{
+  __vector_header_t *header = __vector_header(v);
+  const sz size = sizeof(__vector_header_t) + capacity * header->stride;
+
+  if (header->arena == nullptr) {
+    header = alloc_heap_realloc(header, size);
+  } else {
+    __vector_header_t *new_header = alloc_arena_allocate(header->arena, size);
+    memcpy(new_header, header,
+           sizeof(__vector_header_t) + header->len * header->stride);
+    header = new_header;
+  }
 
-  vector_destroy(v);
-  return newv;
+  header->capacity = capacity;
+  return header + 1;
 }
@@ -1,29 +1,109 @@
 #ifndef __SOLC_CONTAINER_VECTOR_H__
 #define __SOLC_CONTAINER_VECTOR_H__
 
+#include "allocs/alloc_arena.h"
 #include <solc/defs.h>
+#include <solc/mem_stats.h>
+
+// Stored right before the elements, a vector is a pointer to its first
+// element. Macros that may grow the vector assign the new pointer to `v'.
+typedef struct {
+  sz capacity;
+  sz stride;
+  sz len;
+  // nullptr for heap vectors.
+  alloc_arena_t *arena;
+} __vector_header_t;
+
+#define __vector_header(v) ((__vector_header_t *)(v) - 1)
 
 #define vector_create(type) __vector_create(16, sizeof(type))
 #define vector_reserve(type, n) __vector_create(n, sizeof(type))
+#define vector_create_tagged(type, tag) \
+  __vector_create_tagged(16, sizeof(type), (tag))
+#define vector_reserve_tagged(type, n, tag) \
+  __vector_create_tagged(n, sizeof(type), (tag))
+// Arena vectors grow inside `arena' and are never freed on their own,
+// `vector_destroy()' is a no-op for them and the memory comes back with
+// `alloc_arena_clear()'.
+#define vector_create_in_arena(type, arena) \
+  __vector_create_in_arena(16, sizeof(type), (arena))
+#define vector_reserve_in_arena(type, n, arena) \
+  __vector_create_in_arena(n, sizeof(type), (arena))
 #define vector_destroy(v) __vector_destroy(v)
-#define vector_push(v, val)     \
-  {                             \
-    __auto_type tmp = val;      \
-    v = __vector_push(v, &tmp); \
+// `val' is assigned to the element, so pushing is a store unless the vector
+// has to grow. It is evaluated before growing, so it may be an element of `v'.
+#define vector_push(v, val)                         \
+  {                                                 \
+    __auto_type __val = (val);                      \
+    if SOLC_UNLIKELY (__vector_header(v)->len ==    \
+                      __vector_header(v)->capacity) \
+      (v) = __vector_grow((v), 1);                  \
+    (v)[__vector_header(v)->len++] = __val;         \
   }
 #define vector_pop(v, out) __vector_pop(v, out)
+// Shifts the elements from `pos' on to make room for `val'.
+#define vector_insert(v, pos, val)         \
+  {                                        \
+    __auto_type __val = (val);             \
+    (v) = __vector_insert_gap((v), (pos)); \
+    (v)[(pos)] = __val;                    \
+  }
+// Appends `n' elements copied from the array `elements'.
+#define vector_extend(v, elements, n)            \
+  {                                              \
+    (v) = __vector_extend((v), (elements), (n)); \
+  }
+// Makes room for `n' elements in total.
+#define vector_ensure_capacity(v, n)          \
+  {                                           \
+    (v) = __vector_ensure_capacity((v), (n)); \
+  }
+// Truncates to `n' elements or appends zeroed ones up to it.
+#define vector_resize(v, n)          \
+  {                                  \
+    (v) = __vector_resize((v), (n)); \
+  }
+// Gives the unused capacity of a heap vector back.
+#define vector_shrink_to_fit(v)        \
+  {                                    \
+    (v) = __vector_shrink_to_fit((v)); \
+  }
 
 void *__vector_create(sz cap, sz stride);
+void *__vector_create_tagged(sz cap, sz stride, solc_mem_tag_t tag);
+void *__vector_create_in_arena(sz cap, sz stride, alloc_arena_t *arena);
 void __vector_destroy(void *v);
-void *__vector_push(void *v, const void *val);
+void *__vector_grow(void *v, sz additional);
 void __vector_pop(void *v, void *out);
+void *__vector_insert_gap(void *v, sz pos);
+void *__vector_extend(void *v, const void *elements, sz n);
+void *__vector_ensure_capacity(void *v, sz capacity);
+void *__vector_resize(void *v, sz len);
+void *__vector_shrink_to_fit(void *v);
 
+// The copy always lives on the heap, even if `v' lives in an arena, and its
+// capacity is its length.
 void *vector_copy(const void *v);
 
-sz vector_get_capacity(const void *v);
-sz vector_get_stride(const void *v);
-sz vector_get_length(const void *v);
+static inline sz vector_get_capacity(const void *v)
+{
+  return __vector_header(v)->capacity;
+}
+
+static inline sz vector_get_stride(const void *v)
+{
+  return __vector_header(v)->stride;
+}
+
+static inline sz vector_get_length(const void *v)
+{
+  return __vector_header(v)->len;
+}
 
-void vector_clear(void *v);
+static inline void vector_clear(void *v)
+{
+  __vector_header(v)->len = 0;
+}
 
 #endif // __SOLC_CONTAINER_VECTOR_H__
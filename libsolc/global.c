@@ -1,14 +1,27 @@
 #include "global.h"
 #include "allocs/alloc_arena.h"
+#include "allocs/mem_budget.h"
 
 alloc_arena_t __global_arena_alloc;
+alloc_arena_t __global_tree_arena_alloc;
 b8 initialized = false;
 
+static void trim_global_arenas(void *ctx);
+
 void global_init(void)
 {
   SOLC_ASSERT(!initialized);
 
-  __global_arena_alloc = alloc_arena_create();
+  // Big translation units get huge pages, between translation units the arena
+  // is cleared and keeps at most `release_threshold' bytes of it resident.
+  __global_arena_alloc = alloc_arena_create_with_policy((alloc_arena_policy_t){
+    .backend = ALLOC_ARENA_BACKEND_VM,
+    .reserve_size = 64 * 1024 * 1024,
+    .huge_page_threshold = 8 * 1024 * 1024,
+    .release_threshold = 16 * 1024 * 1024,
+  });
+  __global_tree_arena_alloc = alloc_arena_create();
+  mem_budget_add_pressure_func(trim_global_arenas, nullptr);
 
   initialized = true;
 }
@@ -17,7 +30,24 @@ void global_deinit(void)
 {
   SOLC_ASSERT(initialized);
 
+  mem_budget_remove_pressure_func(trim_global_arenas, nullptr);
   alloc_arena_destroy(&__global_arena_alloc);
+  alloc_arena_destroy(&__global_tree_arena_alloc);
 
   initialized = false;
 }
+
+void global_reset(void)
+{
+  SOLC_ASSERT(initialized);
+
+  alloc_arena_clear(&__global_arena_alloc);
+  alloc_arena_clear(&__global_tree_arena_alloc);
+}
+
+static void trim_global_arenas(void *ctx)
+{
+  SOLC_UNUSED_PERMIT(ctx);
+  alloc_arena_trim(&__global_arena_alloc);
+  alloc_arena_trim(&__global_tree_arena_alloc);
+}
@@ -5,12 +5,22 @@
 
 void global_init(void);
 void global_deinit(void);
+// Clears both arenas, the global one keeps at most its `release_threshold'
+// resident.
+void global_reset(void);
 
 extern alloc_arena_t __global_arena_alloc;
+extern alloc_arena_t __global_tree_arena_alloc;
 
 static inline alloc_arena_t *global_arena_alloc(void)
 {
   return &__global_arena_alloc;
 }
 
+// Scratch memory of `solc_ast_print()', cleared after every printed tree.
+static inline alloc_arena_t *global_tree_arena_alloc(void)
+{
+  return &__global_tree_arena_alloc;
+}
+
 #endif // __SOLC_GLOBAL_H__
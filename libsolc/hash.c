@@ -1,22 +1,80 @@
 #include "hash.h"
 #include "solc/defs.h"
+#include <string.h>
 
-hash_t hash_function_fnv_1a_cstr(const void *key)
+#define WYHASH_SECRET_0 0xa0761d6478bd642fULL
+#define WYHASH_SECRET_1 0xe7037ed1a0b428dbULL
+#define WYHASH_SECRET_2 0x8ebc6af09c88c6e3ULL
+#define WYHASH_SECRET_3 0x589965cc75374cc3ULL
+
+static inline void wy_mum(u64 *a, u64 *b);
+static inline u64 wy_mix(u64 a, u64 b);
+static inline u64 wy_read8(const u8 *p);
+static inline u64 wy_read4(const u8 *p);
+static inline u64 wy_read3(const u8 *p, sz len);
+
+hash_t hash_bytes(const void *data, sz len)
 {
-#if IS_64BIT == 1
-#define FNV_PRIME 0x00000100000001b3ULL
-#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
-#else
-#define FNV_PRIME 0x01000193U
-#define FNV_OFFSET_BASIS 0x811c9dc5U
-#endif
-  hash_t hash = FNV_OFFSET_BASIS;
-  const char *s = key;
-  for (; *s; s++) {
-    hash ^= *s;
-    hash *= FNV_PRIME;
+  SOLC_ASSUME(data != nullptr || len == 0);
+
+  const u8 *p = data;
+  u64 seed = wy_mix(WYHASH_SECRET_0, WYHASH_SECRET_1);
+  u64 a, b;
+
+  if SOLC_LIKELY (len <= 16) {
+    if (len >= 4) {
+      // Two overlapping reads from each end cover 4 to 16 bytes.
+      const sz mid = (len >> 3) << 2;
+      a = (wy_read4(p) << 32) | wy_read4(p + mid);
+      b = (wy_read4(p + len - 4) << 32) | wy_read4(p + len - 4 - mid);
+    } else if (len > 0) {
+      a = wy_read3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    sz left = len;
+    if SOLC_UNLIKELY (left > 48) {
+      u64 seed_1 = seed, seed_2 = seed;
+      do {
+        seed = wy_mix(wy_read8(p) ^ WYHASH_SECRET_1, wy_read8(p + 8) ^ seed);
+        seed_1 =
+          wy_mix(wy_read8(p + 16) ^ WYHASH_SECRET_2, wy_read8(p + 24) ^ seed_1);
+        seed_2 =
+          wy_mix(wy_read8(p + 32) ^ WYHASH_SECRET_3, wy_read8(p + 40) ^ seed_2);
+        p += 48;
+        left -= 48;
+      } while (left > 48);
+      seed ^= seed_1 ^ seed_2;
+    }
+
+    while (left > 16) {
+      seed = wy_mix(wy_read8(p) ^ WYHASH_SECRET_1, wy_read8(p + 8) ^ seed);
+      p += 16;
+      left -= 16;
+    }
+
+    a = wy_read8(p + left - 16);
+    b = wy_read8(p + left - 8);
   }
-  return hash;
+
+  a ^= WYHASH_SECRET_1;
+  b ^= seed;
+  wy_mum(&a, &b);
+  return (hash_t)wy_mix(a ^ WYHASH_SECRET_0 ^ len, b ^ WYHASH_SECRET_1);
+}
+
+hash_t hash_function_cstr(const void *key)
+{
+  SOLC_ASSUME(key != nullptr);
+  return hash_bytes(key, strlen(key));
+}
+
+hash_t hash_function_string_key(const void *key)
+{
+  SOLC_ASSUME(key != nullptr);
+  return ((const string_key_t *)key)->hash;
 }
 
 hash_t hash_function_i8(const void *key)
@@ -33,23 +91,12 @@ hash_t hash_function_i16(const void *key)
 
 hash_t hash_function_i32(const void *key)
 {
-#define HASH_I32_MUL 0x45d9f3bU
-  u32 key_32 = *(u32 *)key;
-  key_32 = ((key_32 >> 16) ^ key_32) * HASH_I32_MUL;
-  key_32 = ((key_32 >> 16) ^ key_32) * HASH_I32_MUL;
-  key_32 = (key_32 >> 16) ^ key_32;
-  return key_32;
+  return hash_u32(*(u32 *)key);
 }
 
 hash_t hash_function_i64(const void *key)
 {
-#define HASH_I64_MUL_1 0xbf58476d1ce4e5b9ULL
-#define HASH_I64_MUL_2 0x94d049bb133111ebULL
-  u64 key_64 = *(u64 *)key;
-  key_64 = (key_64 ^ (key_64 >> 30)) * HASH_I64_MUL_1;
-  key_64 = (key_64 ^ (key_64 >> 27)) * HASH_I64_MUL_2;
-  key_64 ^= key_64 >> 31;
-  return key_64;
+  return hash_u64(*(u64 *)key);
 }
 
 hash_t hash_function_UNDEFINED(const void *x)
@@ -57,3 +104,52 @@ hash_t hash_function_UNDEFINED(const void *x)
   SOLC_UNUSED_PERMIT(x);
   SOLC_NOREACH();
 }
+
+// 64x64 -> 128 bit multiplication, `a' gets the low and `b' the high half.
+static inline void wy_mum(u64 *a, u64 *b)
+{
+#ifdef __SIZEOF_INT128__
+  const __uint128_t r = (__uint128_t)*a * *b;
+  *a = (u64)r;
+  *b = (u64)(r >> 64);
+#else
+  const u64 ha = *a >> 32, hb = *b >> 32, la = (u32)*a, lb = (u32)*b;
+  const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const u64 t = rl + (rm0 << 32);
+  u64 lo = t + (rm1 << 32);
+  u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+  *a = lo;
+  *b = hi;
+#endif
+}
+
+static inline u64 wy_mix(u64 a, u64 b)
+{
+  wy_mum(&a, &b);
+  return a ^ b;
+}
+
+static inline u64 wy_read8(const u8 *p)
+{
+  u64 v;
+  memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+static inline u64 wy_read4(const u8 *p)
+{
+  u32 v;
+  memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap32(v);
+#endif
+  return v;
+}
+
+static inline u64 wy_read3(const u8 *p, sz len)
+{
+  return ((u64)p[0] << 16) | ((u64)p[len >> 1] << 8) | p[len - 1];
+}
@@ -2,12 +2,50 @@
 #define __SOLC_HASH_H__
 
 #include "solc/defs.h"
+#include <string.h>
 
 typedef sz hash_t;
 
 typedef hash_t (*hash_function_t)(const void *key);
 
-hash_t hash_function_fnv_1a_cstr(const void *key);
+// Hashes `len' bytes 8 at a time (wyhash), `data' needs no terminator.
+hash_t hash_bytes(const void *data, sz len);
+
+// A string hashed once, e.g. an identifier. Keys are compared by hash and
+// length before any byte is, the characters are not owned.
+typedef struct {
+  const char *data;
+  sz len;
+  hash_t hash;
+} string_key_t;
+
+static inline string_key_t string_key_create(const char *data, sz len)
+{
+  return (string_key_t){
+    .data = data,
+    .len = len,
+    .hash = hash_bytes(data, len),
+  };
+}
+
+static inline string_key_t string_key_from_cstr(const char *c_str)
+{
+  return string_key_create(c_str, strlen(c_str));
+}
+
+static inline hash_t string_key_hash(string_key_t key)
+{
+  return key.hash;
+}
+
+static inline b8 string_key_equals(string_key_t a, string_key_t b)
+{
+  return a.hash == b.hash && a.len == b.len &&
+         (a.data == b.data || memcmp(a.data, b.data, a.len) == 0);
+}
+
+hash_t hash_function_cstr(const void *key);
+hash_t hash_function_string_key(const void *key);
 hash_t hash_function_i8(const void *key);
 hash_t hash_function_i16(const void *key);
 hash_t hash_function_i32(const void *key);
@@ -23,10 +61,34 @@ hash_t hash_function_i64(const void *key);
     u16: hash_function_i16,                  \
     u32: hash_function_i32,                  \
     u64: hash_function_i64,                  \
-    char *: hash_function_fnv_1a_cstr,       \
-    const char *: hash_function_fnv_1a_cstr, \
+    char *: hash_function_cstr,              \
+    const char *: hash_function_cstr,        \
+    string_key_t: hash_function_string_key,  \
     default: hash_function_UNDEFINED)
 
 hash_t hash_function_UNDEFINED(const void *x);
 
+// Typed versions for code that knows its key type (`SOLC_DEFINE_HASHTABLE').
+static inline hash_t hash_u32(u32 key)
+{
+#define HASH_I32_MUL 0x45d9f3bU
+  key = ((key >> 16) ^ key) * HASH_I32_MUL;
+  key = ((key >> 16) ^ key) * HASH_I32_MUL;
+  key = (key >> 16) ^ key;
+  return key;
+#undef HASH_I32_MUL
+}
+
+static inline hash_t hash_u64(u64 key)
+{
+#define HASH_I64_MUL_1 0xbf58476d1ce4e5b9ULL
+#define HASH_I64_MUL_2 0x94d049bb133111ebULL
+  key = (key ^ (key >> 30)) * HASH_I64_MUL_1;
+  key = (key ^ (key >> 27)) * HASH_I64_MUL_2;
+  key ^= key >> 31;
+  return key;
+#undef HASH_I64_MUL_1
+#undef HASH_I64_MUL_2
+}
+
 #endif // __SOLC_HASH_H__
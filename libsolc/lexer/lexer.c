@@ -5,6 +5,7 @@
 #include <string.h>
 #include "global.h"
 #include "allocs/alloc_arena.h"
+#include "allocs/mem_budget.h"
 
 static inline solc_token_t process_id(solc_lexer_t *lexer);
 static inline solc_token_t process_num(solc_lexer_t *lexer);
@@ -31,7 +32,8 @@ solc_lexer_t *solc_lexer_create(const char *src)
   solc_lexer_t *lexer =
     alloc_arena_allocate(global_arena_alloc(), sizeof(solc_lexer_t));
   memset(lexer, 0, sizeof(solc_lexer_t));
-  lexer->tokens_v = vector_reserve(solc_token_t, 1024);
+  lexer->tokens_v =
+    vector_reserve_tagged(solc_token_t, 1024, SOLC_MEM_TAG_TOKENS);
   lexer->src = src;
   lexer->src_len = strlen(src);
 
@@ -50,6 +52,7 @@ void solc_lexer_destroy(solc_lexer_t *lexer)
 
 solc_token_t *solc_lexer_tokenize(solc_lexer_t *lexer, sz *out_token_num)
 {
+  const char *previous_phase = mem_budget_enter_phase("lexing");
   lexer->pos = 0;
   lexer->line = 0;
   lexer->llp = 0;
@@ -235,6 +238,7 @@ solc_token_t *solc_lexer_tokenize(solc_lexer_t *lexer, sz *out_token_num)
     alloc_arena_allocate(global_arena_alloc(), lexersize);
   memcpy(out_tokens, lexer->tokens_v, lexersize);
   vector_clear(lexer->tokens_v);
+  mem_budget_leave_phase(previous_phase);
   return out_tokens;
 }
 
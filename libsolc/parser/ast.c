@@ -1,11 +1,17 @@
 #include "solc/parser/ast.h"
+#include "allocs/mem_budget.h"
 #include "containers/string.h"
 #include "containers/vector.h"
+#include "global.h"
 #include "parser/ast_op_types.h"
 #include "solc/defs.h"
+#include <string.h>
 
 #include "parser/ast_private.h"
 
+// Prefix codes of the tree lines, see `ast_build_tree()'.
+static const char *const tree_prefixes[] = { "├─", "╰─", "│ ", "  " };
+
 solc_ast_group_t solc_ast_type_get_group(solc_ast_type_t type)
 {
   return (solc_ast_group_t)((type >> 8) & 0xFF);
@@ -33,16 +39,24 @@ solc_ast_destroy_func_t solc_ast_get_destroy_func(solc_ast_type_t ast_type)
 void solc_ast_print(solc_ast_t *ast)
 {
   SOLC_ASSUME(ast != nullptr);
+  const char *previous_phase = mem_budget_enter_phase("printing the AST");
 
   solc_ast_build_tree_func_t build_tree_func =
     ast_get_build_tree_func(ast->type);
   string_t *strs_v = build_tree_func(ast);
   sz strs_v_size = vector_get_length(strs_v);
   for (sz i = 0; i < strs_v_size; i++) {
-    printf("%s\n", strs_v[i].data);
+    // The prefix codes after the text are innermost first.
+    const char *str = string_cstr(&strs_v[i]);
+    const sz text_len = strlen(str);
+    for (sz pos = string_length(&strs_v[i]); pos > text_len + 1; pos--)
+      fputs(tree_prefixes[(u8)str[pos - 1]], stdout);
+    printf("%s\n", str);
     string_destroy(&strs_v[i]);
   }
   vector_destroy(strs_v);
+  alloc_arena_clear(global_tree_arena_alloc());
+  mem_budget_leave_phase(previous_phase);
 }
 
 solc_ast_build_tree_func_t ast_get_build_tree_func(solc_ast_type_t ast_type)
@@ -59,33 +73,32 @@ solc_ast_build_tree_func_t ast_get_build_tree_func(solc_ast_type_t ast_type)
 #undef __SOLC_AST_TYPE_X
 }
 
+// Lines are not copied with their prefix at every level. Each level appends
+// the index of its prefix in `tree_prefixes' behind a NUL after the text, and
+// `solc_ast_print()' writes them out. The first line of every vector is the
+// heading of its node and never has prefix codes yet, so it gets the NUL.
 string_t *ast_build_tree(string_t *heading, string_t **children_vs_v)
 {
-  string_t *out_v = vector_create(string_t);
+  const sz children_vs_v_size = vector_get_length(children_vs_v);
+  sz lines_num = 1;
+  for (sz i = 0; i < children_vs_v_size; i++)
+    lines_num += vector_get_length(children_vs_v[i]);
+
+  string_t *out_v = vector_reserve(string_t, lines_num);
   vector_push(out_v, *heading);
 
-  for (sz i = 0, children_vs_v_size = vector_get_length(children_vs_v);
-       i < children_vs_v_size; i++) {
+  for (sz i = 0; i < children_vs_v_size; i++) {
     string_t *children_v = children_vs_v[i];
+    const b8 is_last = i == children_vs_v_size - 1;
     for (sz j = 0, children_v_size = vector_get_length(children_v);
          j < children_v_size; j++) {
-      string_t str;
-
       if (j == 0) {
-        if (i == children_vs_v_size - 1) {
-          str = string_create_from("╰─");
-        } else {
-          str = string_create_from("├─");
-        }
-      } else if (i < children_vs_v_size - 1) {
-        str = string_create_from("│ ");
+        string_append_char(&children_v[j], 0);
+        string_append_char(&children_v[j], is_last ? 1 : 0);
       } else {
-        str = string_create_from("  ");
+        string_append_char(&children_v[j], is_last ? 3 : 2);
       }
-
-      string_append(&str, &children_v[j]);
-      string_destroy(&children_v[j]);
-      vector_push(out_v, str);
+      vector_push(out_v, children_v[j]);
     }
     vector_destroy(children_v);
   }
@@ -101,8 +114,9 @@ expr_operator_group_t expr_operator_type_get_group(expr_operator_type_t type)
 
 const char *ast_expr_operator_type_to_string(expr_operator_type_t t)
 {
-#define __EXPR_OPERATORS_X(type_name, group_name, id, display_val) \
-  case __EXPR_OPERATOR_TYPE_FULL_NAME(type_name, group_name):      \
+#define __EXPR_OPERATORS_X(type_name, group_name, id, display_val, \
+                           binding_power)                         \
+  case __EXPR_OPERATOR_TYPE_FULL_NAME(type_name, group_name):     \
     return display_val;
 
   switch (t) {
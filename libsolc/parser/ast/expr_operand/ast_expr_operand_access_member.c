@@ -14,7 +14,8 @@ solc_ast_t *solc_ast_expr_operand_access_member_create(sz pos,
                                                        solc_ast_t *what_ast)
 {
   ast_expr_operand_access_member_t *out_expr_operand_access_member =
-    malloc(sizeof(ast_expr_operand_access_member_t));
+    SOLC_AST_ALLOC(sizeof(ast_expr_operand_access_member_t),
+                   SOLC_AST_TYPE_EXPR_OPERAND_ACCESS_MEMBER);
   SOLC_AST_INIT_HEADER(out_expr_operand_access_member, pos,
                        SOLC_AST_TYPE_EXPR_OPERAND_ACCESS_MEMBER);
   out_expr_operand_access_member->from_ast = from_ast;
@@ -32,7 +33,7 @@ void solc_ast_expr_operand_access_member_destroy(
                 ast_expr_operand_access_member_t);
   solc_ast_destroy_if_exists(access_member_expr_operand_data->from_ast);
   solc_ast_destroy_if_exists(access_member_expr_operand_data->what_ast);
-  free(access_member_expr_operand_data);
+  SOLC_AST_FREE(access_member_expr_operand_data);
 }
 
 string_t *solc_ast_expr_operand_access_member_build_tree(
@@ -45,7 +46,7 @@ string_t *solc_ast_expr_operand_access_member_build_tree(
                 ast_expr_operand_access_member_t);
 
   string_t header = string_create_from("EXPR_OPERAND_ACCESS_MEMBER");
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  access_member_expr_operand_data->from_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v,
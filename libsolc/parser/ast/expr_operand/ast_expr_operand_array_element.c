@@ -15,7 +15,8 @@ solc_ast_expr_operand_array_element_create(sz pos, solc_ast_t *index_expr_ast,
                                            solc_ast_t *parent_ast)
 {
   ast_expr_operand_array_element_t *out_expr_operand_array_element =
-    malloc(sizeof(ast_expr_operand_array_element_t));
+    SOLC_AST_ALLOC(sizeof(ast_expr_operand_array_element_t),
+                   SOLC_AST_TYPE_EXPR_OPERAND_ARRAY_ELEMENT);
   SOLC_AST_INIT_HEADER(out_expr_operand_array_element, pos,
                        SOLC_AST_TYPE_EXPR_OPERAND_ARRAY_ELEMENT);
   out_expr_operand_array_element->index_expr_ast = index_expr_ast;
@@ -33,7 +34,7 @@ void solc_ast_expr_operand_array_element_destroy(
                 ast_expr_operand_array_element_t);
   solc_ast_destroy_if_exists(array_element_expr_operand_data->index_expr_ast);
   solc_ast_destroy_if_exists(array_element_expr_operand_data->parent_ast);
-  free(array_element_expr_operand_data);
+  SOLC_AST_FREE(array_element_expr_operand_data);
 }
 
 string_t *solc_ast_expr_operand_array_element_build_tree(
@@ -44,7 +45,7 @@ string_t *solc_ast_expr_operand_array_element_build_tree(
                 SOLC_AST_TYPE_EXPR_OPERAND_ARRAY_ELEMENT);
   SOLC_AST_CAST(array_element_expr_operand_data, array_element_expr_operand_ast,
                 ast_expr_operand_array_element_t);
-  string_t **children_vs_v = vector_create(string_t *);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_CREATE();
   solc_ast_add_to_tree_if_exists(
     children_vs_v, array_element_expr_operand_data->index_expr_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v,
@@ -8,7 +8,7 @@
 
 typedef struct {
   SOLC_AST_HEADER;
-  solc_ast_t **arg_asts_v;
+  ast_children_t arg_asts;
   solc_ast_t *generic_type_list_ast;
   char *callee_name;
 } ast_expr_operand_generic_call_t;
@@ -20,10 +20,11 @@ solc_ast_expr_operand_generic_call_create(sz pos, const char *callee_name,
   SOLC_ASSUME(callee_name != nullptr);
   const sz callee_name_len = strlen(callee_name) + 1;
   ast_expr_operand_generic_call_t *out_expr_operand_generic_call =
-    malloc(sizeof(ast_expr_operand_generic_call_t) + callee_name_len);
+    SOLC_AST_ALLOC(sizeof(ast_expr_operand_generic_call_t) + callee_name_len,
+                   SOLC_AST_TYPE_EXPR_OPERAND_GENERIC_CALL);
   SOLC_AST_INIT_HEADER(out_expr_operand_generic_call, pos,
                        SOLC_AST_TYPE_EXPR_OPERAND_GENERIC_CALL);
-  out_expr_operand_generic_call->arg_asts_v = vector_create(solc_ast_t *);
+  small_vector_init(&out_expr_operand_generic_call->arg_asts);
   out_expr_operand_generic_call->generic_type_list_ast = generic_type_list_ast;
   out_expr_operand_generic_call->callee_name =
     (char *)out_expr_operand_generic_call +
@@ -41,16 +42,10 @@ void solc_ast_expr_operand_generic_call_destroy(
                 SOLC_AST_TYPE_EXPR_OPERAND_GENERIC_CALL);
   SOLC_AST_CAST(generic_call_expr_operand_data, generic_call_expr_operand_ast,
                 ast_expr_operand_generic_call_t);
-  SOLC_ASSUME(generic_call_expr_operand_data->arg_asts_v != nullptr);
-  for (sz i = 0, arg_asts_v_size = vector_get_length(
-                   generic_call_expr_operand_data->arg_asts_v);
-       i < arg_asts_v_size; i++) {
-    solc_ast_destroy_if_exists(generic_call_expr_operand_data->arg_asts_v[i]);
-  }
-  vector_destroy(generic_call_expr_operand_data->arg_asts_v);
+  ast_children_destroy(&generic_call_expr_operand_data->arg_asts);
   solc_ast_destroy_if_exists(
     generic_call_expr_operand_data->generic_type_list_ast);
-  free(generic_call_expr_operand_data);
+  SOLC_AST_FREE(generic_call_expr_operand_data);
 }
 
 void solc_ast_expr_operand_generic_call_add_argument(
@@ -61,9 +56,8 @@ void solc_ast_expr_operand_generic_call_add_argument(
                 SOLC_AST_TYPE_EXPR_OPERAND_GENERIC_CALL);
   SOLC_AST_CAST(generic_call_expr_operand_data, generic_call_expr_operand_ast,
                 ast_expr_operand_generic_call_t);
-  SOLC_ASSUME(generic_call_expr_operand_data->arg_asts_v != nullptr);
 
-  vector_push(generic_call_expr_operand_data->arg_asts_v, argument_ast);
+  ast_children_push(&generic_call_expr_operand_data->arg_asts, argument_ast);
 }
 
 string_t *solc_ast_expr_operand_generic_call_build_tree(
@@ -74,24 +68,24 @@ string_t *solc_ast_expr_operand_generic_call_build_tree(
                 SOLC_AST_TYPE_EXPR_OPERAND_GENERIC_CALL);
   SOLC_AST_CAST(generic_call_expr_operand_data, generic_call_expr_operand_ast,
                 ast_expr_operand_generic_call_t);
-  SOLC_ASSUME(generic_call_expr_operand_data->arg_asts_v != nullptr &&
-              generic_call_expr_operand_data->callee_name != nullptr);
+  SOLC_ASSUME(generic_call_expr_operand_data->callee_name != nullptr);
 
   string_t header =
     string_create_from("EXPR_OPERAND_GENERIC_CALL { callee_name: \"");
   string_append_cstr(&header, generic_call_expr_operand_data->callee_name);
   string_append_cstr(&header, "\" }");
 
-  sz arg_asts_v_size =
-    vector_get_length(generic_call_expr_operand_data->arg_asts_v);
+  sz arg_asts_num =
+    small_vector_get_length(&generic_call_expr_operand_data->arg_asts);
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1 + arg_asts_v_size);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1 + arg_asts_num);
   solc_ast_add_to_tree_if_exists(
     children_vs_v, generic_call_expr_operand_data->generic_type_list_ast);
 
-  for (sz i = 0; i < arg_asts_v_size; i++) {
-    solc_ast_add_to_tree_if_exists(
-      children_vs_v, generic_call_expr_operand_data->arg_asts_v[i]);
+  solc_ast_t **child_asts =
+    small_vector_data(&generic_call_expr_operand_data->arg_asts);
+  for (sz i = 0; i < arg_asts_num; i++) {
+    solc_ast_add_to_tree_if_exists(children_vs_v, child_asts[i]);
   }
 
   return ast_build_tree(&header, children_vs_v);
@@ -128,8 +122,8 @@ solc_ast_t **solc_ast_expr_operand_generic_call_get_argument_asts(
                 SOLC_AST_TYPE_EXPR_OPERAND_GENERIC_CALL);
   SOLC_AST_CAST(generic_call_expr_operand_data, generic_call_expr_operand_ast,
                 ast_expr_operand_generic_call_t);
-  SOLC_ASSUME(generic_call_expr_operand_data->arg_asts_v != nullptr);
   if SOLC_LIKELY (out_n != nullptr)
-    *out_n = vector_get_length(generic_call_expr_operand_data->arg_asts_v);
-  return generic_call_expr_operand_data->arg_asts_v;
+    *out_n =
+      small_vector_get_length(&generic_call_expr_operand_data->arg_asts);
+  return small_vector_data(&generic_call_expr_operand_data->arg_asts);
 }
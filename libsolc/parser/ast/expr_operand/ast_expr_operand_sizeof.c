@@ -12,7 +12,8 @@ typedef struct {
 solc_ast_t *solc_ast_expr_operand_sizeof_create(sz pos, solc_ast_t *type_ast)
 {
   ast_expr_operand_sizeof_t *out_expr_operand_sizeof =
-    malloc(sizeof(ast_expr_operand_sizeof_t));
+    SOLC_AST_ALLOC(sizeof(ast_expr_operand_sizeof_t),
+                   SOLC_AST_TYPE_EXPR_OPERAND_SIZEOF);
   SOLC_AST_INIT_HEADER(out_expr_operand_sizeof, pos,
                        SOLC_AST_TYPE_EXPR_OPERAND_SIZEOF);
   out_expr_operand_sizeof->type_ast = type_ast;
@@ -27,7 +28,7 @@ void solc_ast_expr_operand_sizeof_destroy(solc_ast_t *sizeof_expr_operand_ast)
   SOLC_AST_CAST(sizeof_expr_operand_data, sizeof_expr_operand_ast,
                 ast_expr_operand_sizeof_t);
   solc_ast_destroy_if_exists(sizeof_expr_operand_data->type_ast);
-  free(sizeof_expr_operand_data);
+  SOLC_AST_FREE(sizeof_expr_operand_data);
 }
 
 string_t *
@@ -39,7 +40,7 @@ solc_ast_expr_operand_sizeof_build_tree(solc_ast_t *sizeof_expr_operand_ast)
   SOLC_AST_CAST(sizeof_expr_operand_data, sizeof_expr_operand_ast,
                 ast_expr_operand_sizeof_t);
   string_t header = string_create_from("EXPR_OPERAND_SIZEOF");
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  sizeof_expr_operand_data->type_ast);
 
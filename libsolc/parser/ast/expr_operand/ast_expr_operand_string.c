@@ -15,7 +15,8 @@ solc_ast_t *solc_ast_expr_operand_string_create(sz pos, const char *value)
   SOLC_ASSUME(value != nullptr);
   const sz value_len = strlen(value) + 1;
   ast_expr_operand_string_t *out_expr_operand_string =
-    malloc(sizeof(ast_expr_operand_string_t) + value_len);
+    SOLC_AST_ALLOC(sizeof(ast_expr_operand_string_t) + value_len,
+                   SOLC_AST_TYPE_EXPR_OPERAND_STRING);
   SOLC_AST_INIT_HEADER(out_expr_operand_string, pos,
                        SOLC_AST_TYPE_EXPR_OPERAND_STRING);
   out_expr_operand_string->value =
@@ -29,7 +30,7 @@ void solc_ast_expr_operand_string_destroy(solc_ast_t *string_expr_operand_ast)
   SOLC_ASSUME(string_expr_operand_ast != nullptr &&
               string_expr_operand_ast->type ==
                 SOLC_AST_TYPE_EXPR_OPERAND_STRING);
-  free(string_expr_operand_ast);
+  SOLC_AST_FREE(string_expr_operand_ast);
 }
 
 string_t *
@@ -14,7 +14,8 @@ typedef struct {
 solc_ast_t *solc_ast_expr_operand_symbol_create(sz pos, char value)
 {
   ast_expr_operand_symbol_t *out_expr_operand_symbol =
-    malloc(sizeof(ast_expr_operand_symbol_t));
+    SOLC_AST_ALLOC(sizeof(ast_expr_operand_symbol_t),
+                   SOLC_AST_TYPE_EXPR_OPERAND_SYMBOL);
   SOLC_AST_INIT_HEADER(out_expr_operand_symbol, pos,
                        SOLC_AST_TYPE_EXPR_OPERAND_SYMBOL);
   out_expr_operand_symbol->value = value;
@@ -26,7 +27,7 @@ void solc_ast_expr_operand_symbol_destroy(solc_ast_t *symbol_expr_operand_ast)
   SOLC_ASSUME(symbol_expr_operand_ast != nullptr &&
               symbol_expr_operand_ast->type ==
                 SOLC_AST_TYPE_EXPR_OPERAND_SYMBOL);
-  free(symbol_expr_operand_ast);
+  SOLC_AST_FREE(symbol_expr_operand_ast);
 }
 
 string_t *
@@ -66,12 +67,7 @@ solc_ast_expr_operand_symbol_build_tree(solc_ast_t *symbol_expr_operand_ast)
     }
   }
 
-  string_append_char(&header, '(');
-  char *buf = malloc(sizeof(char) * 3);
-  snprintf(buf, 3, "%02X", symbol_expr_operand_data->value);
-  string_append_cstr(&header, buf);
-  free(buf);
-  string_append_cstr(&header, ") }");
+  string_append_fmt(&header, "(%02X) }", (u8)symbol_expr_operand_data->value);
 
   string_t *out_v = vector_reserve(string_t, 1);
   vector_push(out_v, header);
@@ -6,7 +6,8 @@
 
 solc_ast_t *solc_ast_expr_operand_void_create(sz pos)
 {
-  solc_ast_t *out_void_expr_operand = malloc(sizeof(solc_ast_t));
+  solc_ast_t *out_void_expr_operand =
+    SOLC_AST_ALLOC(sizeof(solc_ast_t), SOLC_AST_TYPE_EXPR_OPERAND_VOID);
   out_void_expr_operand->token_pos = pos;
   out_void_expr_operand->type = SOLC_AST_TYPE_EXPR_OPERAND_VOID;
   return out_void_expr_operand;
@@ -16,7 +17,7 @@ void solc_ast_expr_operand_void_destroy(solc_ast_t *void_expr_operand_ast)
 {
   SOLC_ASSUME(void_expr_operand_ast != nullptr &&
               void_expr_operand_ast->type == SOLC_AST_TYPE_EXPR_OPERAND_VOID);
-  free(void_expr_operand_ast);
+  SOLC_AST_FREE(void_expr_operand_ast);
 }
 
 string_t *
@@ -26,7 +26,8 @@ solc_ast_t *solc_ast_generic_func_create(
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_generic_func_t *out_generic_func =
-    malloc(sizeof(ast_generic_func_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_generic_func_t) + name_len,
+                   SOLC_AST_TYPE_GENERIC_FUNC);
   SOLC_AST_INIT_HEADER(out_generic_func, pos, SOLC_AST_TYPE_GENERIC_FUNC);
   out_generic_func->name =
     (char *)out_generic_func + sizeof(ast_generic_func_t);
@@ -52,7 +53,7 @@ void solc_ast_generic_func_destroy(solc_ast_t *generic_func_ast)
   solc_ast_destroy_if_exists(generic_func_data->block_ast);
   solc_ast_destroy_if_exists(
     generic_func_data->generic_placeholder_type_list_ast);
-  free(generic_func_data);
+  SOLC_AST_FREE(generic_func_data);
 }
 
 string_t *solc_ast_generic_func_build_tree(solc_ast_t *generic_func_ast)
@@ -62,13 +63,12 @@ string_t *solc_ast_generic_func_build_tree(solc_ast_t *generic_func_ast)
   SOLC_AST_CAST(generic_func_data, generic_func_ast, ast_generic_func_t);
   SOLC_ASSUME(generic_func_data->name != nullptr);
 
-  char header_cstr[1024] = { 0 };
-  snprintf(header_cstr, 1023, "GENERIC_FUNC { name: \"%s\", type: %s }",
-           generic_func_data->name,
-           solc_ast_func_type_to_string(generic_func_data->func_type));
-  string_t header = string_create_from(header_cstr);
+  string_t header = string_create();
+  string_append_fmt(&header, "GENERIC_FUNC { name: \"%s\", type: %s }",
+                    generic_func_data->name,
+                    solc_ast_func_type_to_string(generic_func_data->func_type));
 
-  string_t **children_vs_v = vector_reserve(string_t *, 5);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(5);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  generic_func_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, generic_func_data->type_ast);
@@ -20,7 +20,8 @@ solc_ast_t *solc_ast_generic_namespace_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_generic_namespace_t *out_generic_namespace =
-    malloc(sizeof(ast_generic_namespace_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_generic_namespace_t) + name_len,
+                   SOLC_AST_TYPE_GENERIC_NAMESPACE);
   SOLC_AST_INIT_HEADER(out_generic_namespace, pos,
                        SOLC_AST_TYPE_GENERIC_NAMESPACE);
   out_generic_namespace->generic_type_list_ast = generic_type_list_ast;
@@ -39,7 +40,7 @@ void solc_ast_generic_namespace_destroy(solc_ast_t *generic_namespace_ast)
                 ast_generic_namespace_t);
   solc_ast_destroy_if_exists(generic_namespace_data->generic_type_list_ast);
   solc_ast_destroy_if_exists(generic_namespace_data->subobject_ast);
-  free(generic_namespace_ast);
+  SOLC_AST_FREE(generic_namespace_ast);
 }
 
 void solc_ast_generic_namespace_set_subobject(solc_ast_t *generic_namespace_ast,
@@ -69,7 +70,7 @@ solc_ast_generic_namespace_build_tree(solc_ast_t *generic_namespace_ast)
   string_append_cstr(&header, generic_namespace_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  generic_namespace_data->generic_type_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v,
@@ -18,7 +18,8 @@ solc_ast_generic_placeholder_type_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_generic_placeholder_type_t *out_generic_placeholder =
-    malloc(sizeof(ast_generic_placeholder_type_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_generic_placeholder_type_t) + name_len,
+                   SOLC_AST_TYPE_GENERIC_PLACEHOLDER_TYPE);
   SOLC_AST_INIT_HEADER(out_generic_placeholder, pos,
                        SOLC_AST_TYPE_GENERIC_PLACEHOLDER_TYPE);
   out_generic_placeholder->default_type_ast = default_type_ast;
@@ -37,7 +38,7 @@ void solc_ast_generic_placeholder_type_destroy(
   SOLC_AST_CAST(generic_placeholder_type_data, generic_placeholder_type_ast,
                 ast_generic_placeholder_type_t);
   solc_ast_destroy_if_exists(generic_placeholder_type_data->default_type_ast);
-  free(generic_placeholder_type_ast);
+  SOLC_AST_FREE(generic_placeholder_type_ast);
 }
 
 string_t *solc_ast_generic_placeholder_type_build_tree(
@@ -54,7 +55,7 @@ string_t *solc_ast_generic_placeholder_type_build_tree(
   string_append_cstr(&header, generic_placeholder_type_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(
     children_vs_v, generic_placeholder_type_data->default_type_ast);
 
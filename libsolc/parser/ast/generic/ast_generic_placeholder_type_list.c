@@ -7,17 +7,17 @@
 
 typedef struct {
   SOLC_AST_HEADER;
-  solc_ast_t **placeholder_types_v;
+  ast_children_t placeholder_types;
 } ast_generic_placeholder_type_list_t;
 
 solc_ast_t *solc_ast_generic_placeholder_type_list_create(sz pos)
 {
   ast_generic_placeholder_type_list_t *out_generic_placeholder_type_list =
-    malloc(sizeof(ast_generic_placeholder_type_list_t));
+    SOLC_AST_ALLOC(sizeof(ast_generic_placeholder_type_list_t),
+                   SOLC_AST_TYPE_GENERIC_PLACEHOLDER_TYPE_LIST);
   SOLC_AST_INIT_HEADER(out_generic_placeholder_type_list, pos,
                        SOLC_AST_TYPE_GENERIC_PLACEHOLDER_TYPE_LIST);
-  out_generic_placeholder_type_list->placeholder_types_v =
-    vector_create(solc_ast_t *);
+  small_vector_init(&out_generic_placeholder_type_list->placeholder_types);
   return SOLC_AST(out_generic_placeholder_type_list);
 }
 
@@ -30,15 +30,8 @@ void solc_ast_generic_placeholder_type_list_destroy(
   SOLC_AST_CAST(generic_placeholder_type_list_data,
                 generic_placeholder_type_list_ast,
                 ast_generic_placeholder_type_list_t);
-  SOLC_ASSUME(generic_placeholder_type_list_data->placeholder_types_v !=
-              nullptr);
-  for (sz i = 0, placeholder_types_v_size = vector_get_length(
-                   generic_placeholder_type_list_data->placeholder_types_v);
-       i < placeholder_types_v_size; i++)
-    solc_ast_destroy_if_exists(
-      generic_placeholder_type_list_data->placeholder_types_v[i]);
-  vector_destroy(generic_placeholder_type_list_data->placeholder_types_v);
-  free(generic_placeholder_type_list_data);
+  ast_children_destroy(&generic_placeholder_type_list_data->placeholder_types);
+  SOLC_AST_FREE(generic_placeholder_type_list_data);
 }
 
 void solc_ast_generic_placeholder_type_list_add_placeholder_type(
@@ -51,10 +44,8 @@ void solc_ast_generic_placeholder_type_list_add_placeholder_type(
   SOLC_AST_CAST(generic_placeholder_type_list_data,
                 generic_placeholder_type_list_ast,
                 ast_generic_placeholder_type_list_t);
-  SOLC_ASSUME(generic_placeholder_type_list_data->placeholder_types_v !=
-              nullptr);
-  vector_push(generic_placeholder_type_list_data->placeholder_types_v,
-              generic_placeholder_type_ast);
+  ast_children_push(&generic_placeholder_type_list_data->placeholder_types,
+                    generic_placeholder_type_ast);
 }
 
 string_t *solc_ast_generic_placeholder_type_list_build_tree(
@@ -66,13 +57,11 @@ string_t *solc_ast_generic_placeholder_type_list_build_tree(
   SOLC_AST_CAST(generic_placeholder_type_list_data,
                 generic_placeholder_type_list_ast,
                 ast_generic_placeholder_type_list_t);
-  SOLC_ASSUME(generic_placeholder_type_list_data->placeholder_types_v !=
-              nullptr);
 
   string_t header = string_create_from("GENERIC_PLACEHOLDER_TYPE_LIST");
-  sz placeholder_types_v_size =
-    vector_get_length(generic_placeholder_type_list_data->placeholder_types_v);
-  if SOLC_UNLIKELY (placeholder_types_v_size == 0) {
+  sz placeholder_types_num = small_vector_get_length(
+    &generic_placeholder_type_list_data->placeholder_types);
+  if SOLC_UNLIKELY (placeholder_types_num == 0) {
     // NOTE: I don't think that this case is valid
     // but will keep it here for now.
     string_t *out_v = vector_reserve(string_t, 1);
@@ -80,12 +69,11 @@ string_t *solc_ast_generic_placeholder_type_list_build_tree(
     return out_v;
   }
 
-  string_t **children_vs_v =
-    vector_reserve(string_t *, placeholder_types_v_size);
-  for (sz i = 0; i < placeholder_types_v_size; i++)
-    solc_ast_add_to_tree_if_exists(
-      children_vs_v,
-      generic_placeholder_type_list_data->placeholder_types_v[i]);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(placeholder_types_num);
+  solc_ast_t **child_asts =
+    small_vector_data(&generic_placeholder_type_list_data->placeholder_types);
+  for (sz i = 0; i < placeholder_types_num; i++)
+    solc_ast_add_to_tree_if_exists(children_vs_v, child_asts[i]);
 
   return ast_build_tree(&header, children_vs_v);
 }
@@ -100,10 +88,9 @@ solc_ast_generic_placeholder_type_list_get_generic_placeholder_type_asts(
   SOLC_AST_CAST(generic_placeholder_type_list_data,
                 generic_placeholder_type_list_ast,
                 ast_generic_placeholder_type_list_t);
-  SOLC_ASSUME(generic_placeholder_type_list_data->placeholder_types_v !=
-              nullptr);
   if SOLC_LIKELY (out_n != nullptr)
-    *out_n = vector_get_length(
-      generic_placeholder_type_list_data->placeholder_types_v);
-  return generic_placeholder_type_list_data->placeholder_types_v;
+    *out_n = small_vector_get_length(
+      &generic_placeholder_type_list_data->placeholder_types);
+  return small_vector_data(
+    &generic_placeholder_type_list_data->placeholder_types);
 }
@@ -10,7 +10,7 @@ typedef struct {
   SOLC_AST_HEADER;
   solc_ast_t *generic_placeholder_type_list_ast;
   solc_ast_t *attribute_list_ast;
-  solc_ast_t **children_v;
+  ast_children_t children;
   char *name;
 } ast_generic_struct_t;
 
@@ -22,12 +22,13 @@ solc_ast_generic_struct_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_generic_struct_t *out_generic_struct =
-    malloc(sizeof(ast_generic_struct_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_generic_struct_t) + name_len,
+                   SOLC_AST_TYPE_GENERIC_STRUCT);
   SOLC_AST_INIT_HEADER(out_generic_struct, pos, SOLC_AST_TYPE_GENERIC_STRUCT);
   out_generic_struct->generic_placeholder_type_list_ast =
     generic_placeholder_type_list_ast;
   out_generic_struct->attribute_list_ast = attribute_list_ast;
-  out_generic_struct->children_v = vector_create(solc_ast_t *);
+  small_vector_init(&out_generic_struct->children);
   out_generic_struct->name =
     (char *)out_generic_struct + sizeof(ast_generic_struct_t);
   memcpy(out_generic_struct->name, name, name_len);
@@ -39,16 +40,11 @@ void solc_ast_generic_struct_destroy(solc_ast_t *generic_struct_ast)
   SOLC_ASSUME(generic_struct_ast != nullptr &&
               generic_struct_ast->type == SOLC_AST_TYPE_GENERIC_STRUCT);
   SOLC_AST_CAST(generic_struct_data, generic_struct_ast, ast_generic_struct_t);
-  SOLC_ASSUME(generic_struct_data->children_v != nullptr);
   solc_ast_destroy_if_exists(
     generic_struct_data->generic_placeholder_type_list_ast);
   solc_ast_destroy_if_exists(generic_struct_data->attribute_list_ast);
-  for (sz i = 0,
-          children_v_size = vector_get_length(generic_struct_data->children_v);
-       i < children_v_size; i++)
-    solc_ast_destroy_if_exists(generic_struct_data->children_v[i]);
-  vector_destroy(generic_struct_data->children_v);
-  free(generic_struct_data);
+  ast_children_destroy(&generic_struct_data->children);
+  SOLC_AST_FREE(generic_struct_data);
 }
 
 void solc_ast_generic_struct_add_child(solc_ast_t *generic_struct_ast,
@@ -57,8 +53,7 @@ void solc_ast_generic_struct_add_child(solc_ast_t *generic_struct_ast,
   SOLC_ASSUME(generic_struct_ast != nullptr &&
               generic_struct_ast->type == SOLC_AST_TYPE_GENERIC_STRUCT);
   SOLC_AST_CAST(generic_struct_data, generic_struct_ast, ast_generic_struct_t);
-  SOLC_ASSUME(generic_struct_data->children_v != nullptr);
-  vector_push(generic_struct_data->children_v, child_ast);
+  ast_children_push(&generic_struct_data->children, child_ast);
 }
 
 string_t *solc_ast_generic_struct_build_tree(solc_ast_t *generic_struct_ast)
@@ -66,22 +61,21 @@ string_t *solc_ast_generic_struct_build_tree(solc_ast_t *generic_struct_ast)
   SOLC_ASSUME(generic_struct_ast != nullptr &&
               generic_struct_ast->type == SOLC_AST_TYPE_GENERIC_STRUCT);
   SOLC_AST_CAST(generic_struct_data, generic_struct_ast, ast_generic_struct_t);
-  SOLC_ASSUME(generic_struct_data->children_v != nullptr &&
-              generic_struct_data->name != nullptr);
+  SOLC_ASSUME(generic_struct_data->name != nullptr);
 
   string_t header = string_create_from("GENERIC_STRUCT { name: \"");
   string_append_cstr(&header, generic_struct_data->name);
   string_append_cstr(&header, "\" }");
 
-  sz children_v_size = vector_get_length(generic_struct_data->children_v);
-  string_t **children_vs_v = vector_reserve(string_t *, children_v_size + 2);
+  sz children_num = small_vector_get_length(&generic_struct_data->children);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(children_num + 2);
   solc_ast_add_to_tree_if_exists(
     children_vs_v, generic_struct_data->generic_placeholder_type_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  generic_struct_data->attribute_list_ast);
-  for (sz i = 0; i < children_v_size; i++)
-    solc_ast_add_to_tree_if_exists(children_vs_v,
-                                   generic_struct_data->children_v[i]);
+  solc_ast_t **child_asts = small_vector_data(&generic_struct_data->children);
+  for (sz i = 0; i < children_num; i++)
+    solc_ast_add_to_tree_if_exists(children_vs_v, child_asts[i]);
 
   return ast_build_tree(&header, children_vs_v);
 }
@@ -110,10 +104,9 @@ solc_ast_generic_struct_get_children(solc_ast_t *generic_struct_ast, sz *out_n)
   SOLC_ASSUME(generic_struct_ast != nullptr &&
               generic_struct_ast->type == SOLC_AST_TYPE_GENERIC_STRUCT);
   SOLC_AST_CAST(generic_struct_data, generic_struct_ast, ast_generic_struct_t);
-  SOLC_ASSUME(generic_struct_data->children_v != nullptr);
   if SOLC_LIKELY (out_n != nullptr)
-    *out_n = vector_get_length(generic_struct_data->children_v);
-  return generic_struct_data->children_v;
+    *out_n = small_vector_get_length(&generic_struct_data->children);
+  return small_vector_data(&generic_struct_data->children);
 }
 
 solc_ast_t *
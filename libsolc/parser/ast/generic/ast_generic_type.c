@@ -17,7 +17,8 @@ solc_ast_t *solc_ast_generic_type_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_generic_type_t *out_generic_type =
-    malloc(sizeof(ast_generic_type_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_generic_type_t) + name_len,
+                   SOLC_AST_TYPE_GENERIC_TYPE);
   SOLC_AST_INIT_HEADER(out_generic_type, pos, SOLC_AST_TYPE_GENERIC_TYPE);
   out_generic_type->generic_type_list_ast = generic_type_list_ast;
   out_generic_type->name =
@@ -32,7 +33,7 @@ void solc_ast_generic_type_destroy(solc_ast_t *generic_type_ast)
               generic_type_ast->type == SOLC_AST_TYPE_GENERIC_TYPE);
   SOLC_AST_CAST(generic_type_data, generic_type_ast, ast_generic_type_t);
   solc_ast_destroy_if_exists(generic_type_data->generic_type_list_ast);
-  free(generic_type_ast);
+  SOLC_AST_FREE(generic_type_ast);
 }
 
 string_t *solc_ast_generic_type_build_tree(solc_ast_t *generic_type_ast)
@@ -46,7 +47,7 @@ string_t *solc_ast_generic_type_build_tree(solc_ast_t *generic_type_ast)
   string_append_cstr(&header, generic_type_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  generic_type_data->generic_type_list_ast);
 
@@ -18,7 +18,8 @@ solc_ast_t *solc_ast_initlist_entry_explicit_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_initlist_entry_explicit_t *out_initlist_entry_explicit =
-    malloc(sizeof(ast_initlist_entry_explicit_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_initlist_entry_explicit_t) + name_len,
+                   SOLC_AST_TYPE_INITLIST_ENTRY_EXPLICIT);
   SOLC_AST_INIT_HEADER(out_initlist_entry_explicit, pos,
                        SOLC_AST_TYPE_INITLIST_ENTRY_EXPLICIT);
   out_initlist_entry_explicit->expr_ast = expr_ast;
@@ -37,7 +38,7 @@ void solc_ast_initlist_entry_explicit_destroy(
   SOLC_AST_CAST(initlist_entry_explicit_data, initlist_entry_explicit_ast,
                 ast_initlist_entry_explicit_t);
   solc_ast_destroy_if_exists(initlist_entry_explicit_data->expr_ast);
-  free(initlist_entry_explicit_ast);
+  SOLC_AST_FREE(initlist_entry_explicit_ast);
 }
 
 string_t *solc_ast_initlist_entry_explicit_build_tree(
@@ -54,7 +55,7 @@ string_t *solc_ast_initlist_entry_explicit_build_tree(
   string_append_cstr(&header, initlist_entry_explicit_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  initlist_entry_explicit_data->expr_ast);
 
@@ -20,7 +20,9 @@ solc_ast_t *solc_ast_initlist_entry_explicit_array_element_create(
 
   ast_initlist_entry_explicit_array_element_t
     *out_initlist_entry_explicit_array_element =
-      malloc(sizeof(ast_initlist_entry_explicit_array_element_t) + name_len);
+      SOLC_AST_ALLOC(sizeof(ast_initlist_entry_explicit_array_element_t) +
+                       name_len,
+                     SOLC_AST_TYPE_INITLIST_ENTRY_EXPLICIT_ARRAY_ELEMENT);
   SOLC_AST_INIT_HEADER(out_initlist_entry_explicit_array_element, pos,
                        SOLC_AST_TYPE_INITLIST_ENTRY_EXPLICIT_ARRAY_ELEMENT);
   out_initlist_entry_explicit_array_element->index_expr_ast = index_expr_ast;
@@ -45,7 +47,7 @@ void solc_ast_initlist_entry_explicit_array_element_destroy(
     initlist_entry_explicit_array_element_data->index_expr_ast);
   solc_ast_destroy_if_exists(
     initlist_entry_explicit_array_element_data->expr_ast);
-  free(initlist_entry_explicit_array_element_data);
+  SOLC_AST_FREE(initlist_entry_explicit_array_element_data);
 }
 
 string_t *solc_ast_initlist_entry_explicit_array_element_build_tree(
@@ -64,7 +66,7 @@ string_t *solc_ast_initlist_entry_explicit_array_element_build_tree(
   string_append_cstr(&header, initlist_entry_explicit_array_element_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(
     children_vs_v, initlist_entry_explicit_array_element_data->index_expr_ast);
   solc_ast_add_to_tree_if_exists(
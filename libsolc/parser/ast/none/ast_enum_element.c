@@ -16,7 +16,8 @@ solc_ast_t *solc_ast_enum_element_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_enum_element_t *out_enum_element =
-    malloc(sizeof(ast_enum_element_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_enum_element_t) + name_len,
+                   SOLC_AST_TYPE_NONE_ENUM_ELEMENT);
   SOLC_AST_INIT_HEADER(out_enum_element, pos, SOLC_AST_TYPE_NONE_ENUM_ELEMENT);
   out_enum_element->expr_ast = expr_ast;
   out_enum_element->name =
@@ -31,7 +32,7 @@ void solc_ast_enum_element_destroy(solc_ast_t *enum_element_ast)
               enum_element_ast->type == SOLC_AST_TYPE_NONE_ENUM_ELEMENT);
   SOLC_AST_CAST(enum_element_data, enum_element_ast, ast_enum_element_t);
   solc_ast_destroy_if_exists(enum_element_data->expr_ast);
-  free(enum_element_data);
+  SOLC_AST_FREE(enum_element_data);
 }
 
 string_t *solc_ast_enum_element_build_tree(solc_ast_t *enum_element_ast)
@@ -41,18 +42,16 @@ string_t *solc_ast_enum_element_build_tree(solc_ast_t *enum_element_ast)
   SOLC_AST_CAST(enum_element_data, enum_element_ast, ast_enum_element_t);
   SOLC_ASSUME(enum_element_data->name != nullptr);
   string_t *out_v;
-  sz n = strlen(enum_element_data->name) + 128;
-  char *buf = malloc(sizeof(char) * n);
-  snprintf(buf, n, "ENUM_ELEMENT { name: \"%s\" }", enum_element_data->name);
-  string_t header = string_create_from(buf);
-  free(buf);
+  string_t header = string_create();
+  string_append_fmt(&header, "ENUM_ELEMENT { name: \"%s\" }",
+                    enum_element_data->name);
   if (enum_element_data->expr_ast == nullptr) {
     out_v = vector_reserve(string_t, 1);
     vector_push(out_v, header);
     return out_v;
   }
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   vector_push(children_vs_v,
               ast_get_build_tree_func(enum_element_data->expr_ast->type)(
                 enum_element_data->expr_ast));
@@ -19,7 +19,8 @@ solc_ast_t *solc_ast_err_create(sz pos, const char *reason)
 
   const sz reason_len = strlen(reason) + 1;
 
-  ast_err_t *out_err = malloc(sizeof(ast_err_t) + reason_len);
+  ast_err_t *out_err =
+    SOLC_AST_ALLOC(sizeof(ast_err_t) + reason_len, SOLC_AST_TYPE_NONE_ERR);
   SOLC_AST_INIT_HEADER(out_err, pos, SOLC_AST_TYPE_NONE_ERR);
   out_err->reason = (char *)out_err + sizeof(ast_err_t);
   memcpy(out_err->reason, reason, reason_len);
@@ -30,7 +31,7 @@ solc_ast_t *solc_ast_err_create(sz pos, const char *reason)
 void solc_ast_err_destroy(solc_ast_t *err_ast)
 {
   SOLC_ASSUME(err_ast != nullptr && err_ast->type == SOLC_AST_TYPE_NONE_ERR);
-  free(err_ast);
+  SOLC_AST_FREE(err_ast);
 }
 
 string_t *solc_ast_err_build_tree(solc_ast_t *err_ast)
@@ -38,12 +39,10 @@ string_t *solc_ast_err_build_tree(solc_ast_t *err_ast)
   SOLC_ASSUME(err_ast != nullptr && err_ast->type == SOLC_AST_TYPE_NONE_ERR);
   SOLC_AST_CAST(err_data, err_ast, ast_err_t);
   SOLC_ASSUME(err_data->reason != nullptr);
-  const sz n = strlen(err_data->reason) + 32;
-  char *buf = malloc(sizeof(char) * n);
-  snprintf(buf, n, "ERR { reason: \"%s\" }", err_data->reason);
+  string_t header = string_create();
+  string_append_fmt(&header, "ERR { reason: \"%s\" }", err_data->reason);
   string_t *out_v = vector_reserve(string_t, 1);
-  vector_push(out_v, string_create_from(buf));
-  free(buf);
+  vector_push(out_v, header);
   return out_v;
 }
 
@@ -17,7 +17,8 @@ solc_ast_t *solc_ast_expr_create(sz pos, solc_ast_t *lhs_ast,
                                  solc_ast_t *rhs_ast,
                                  expr_operator_type_t operator_type)
 {
-  ast_expr_t *out_expr = malloc(sizeof(ast_expr_t));
+  ast_expr_t *out_expr =
+    SOLC_AST_ALLOC(sizeof(ast_expr_t), SOLC_AST_TYPE_NONE_EXPR);
   SOLC_AST_INIT_HEADER(out_expr, pos, SOLC_AST_TYPE_NONE_EXPR);
   out_expr->lhs_ast = lhs_ast;
   out_expr->rhs_ast = rhs_ast;
@@ -33,14 +34,14 @@ void solc_ast_expr_destroy(solc_ast_t *expr_ast)
   solc_ast_destroy_if_exists(expr_data->lhs_ast);
   solc_ast_destroy_if_exists(expr_data->rhs_ast);
 
-  free(expr_ast);
+  SOLC_AST_FREE(expr_ast);
 }
 
 string_t *solc_ast_expr_build_tree(solc_ast_t *expr_ast)
 {
   SOLC_ASSUME(expr_ast != nullptr && expr_ast->type == SOLC_AST_TYPE_NONE_EXPR);
   SOLC_AST_CAST(expr_data, expr_ast, ast_expr_t);
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v, expr_data->lhs_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, expr_data->rhs_ast);
   string_t header = string_create_from("EXPR { operator: \"");
@@ -21,7 +21,8 @@ solc_ast_t *solc_ast_extern_func_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_extern_func_t *out_extern_func =
-    malloc(sizeof(ast_extern_func_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_extern_func_t) + name_len,
+                   SOLC_AST_TYPE_NONE_EXTERN_FUNC);
   SOLC_AST_INIT_HEADER(out_extern_func, pos, SOLC_AST_TYPE_NONE_EXTERN_FUNC);
   out_extern_func->type_ast = type_ast;
   out_extern_func->arg_list_ast = arg_list_ast;
@@ -37,7 +38,7 @@ void solc_ast_extern_func_destroy(solc_ast_t *extern_func_ast)
   SOLC_AST_CAST(extern_func_data, extern_func_ast, ast_extern_func_t);
   solc_ast_destroy_if_exists(extern_func_data->type_ast);
   solc_ast_destroy_if_exists(extern_func_data->arg_list_ast);
-  free(extern_func_data);
+  SOLC_AST_FREE(extern_func_data);
 }
 
 string_t *solc_ast_extern_func_build_tree(solc_ast_t *extern_func_ast)
@@ -51,7 +52,7 @@ string_t *solc_ast_extern_func_build_tree(solc_ast_t *extern_func_ast)
   string_append_cstr(&header, extern_func_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v, extern_func_data->type_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, extern_func_data->arg_list_ast);
 
@@ -28,7 +28,8 @@ solc_ast_t *solc_ast_func_create(sz pos, const char *name, solc_ast_t *type_ast,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_func_t *out_func = malloc(sizeof(ast_func_t) + name_len);
+  ast_func_t *out_func =
+    SOLC_AST_ALLOC(sizeof(ast_func_t) + name_len, SOLC_AST_TYPE_NONE_FUNC);
   SOLC_AST_INIT_HEADER(out_func, pos, SOLC_AST_TYPE_NONE_FUNC);
   out_func->name = (char *)out_func + sizeof(ast_func_t);
   memcpy(out_func->name, name, name_len);
@@ -50,7 +51,7 @@ void solc_ast_func_destroy(solc_ast_t *func_ast)
   solc_ast_destroy_if_exists(func_data->arg_list_ast);
   solc_ast_destroy_if_exists(func_data->block_ast);
 
-  free(func_ast);
+  SOLC_AST_FREE(func_ast);
 }
 
 string_t *solc_ast_func_build_tree(solc_ast_t *func_ast)
@@ -59,12 +60,12 @@ string_t *solc_ast_func_build_tree(solc_ast_t *func_ast)
   SOLC_AST_CAST(func_data, func_ast, ast_func_t);
   SOLC_ASSUME(func_data->name != nullptr);
 
-  char header_cstr[1024] = { 0 };
-  snprintf(header_cstr, 1023, "FUNC { name: \"%s\", type: %s }",
-           func_data->name, solc_ast_func_type_to_string(func_data->func_type));
+  string_t header = string_create();
+  string_append_fmt(&header, "FUNC { name: \"%s\", type: %s }",
+                    func_data->name,
+                    solc_ast_func_type_to_string(func_data->func_type));
 
-  string_t header = string_create_from(header_cstr);
-  string_t **children_vs_v = vector_reserve(string_t *, 4);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(4);
   solc_ast_add_to_tree_if_exists(children_vs_v, func_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, func_data->type_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, func_data->arg_list_ast);
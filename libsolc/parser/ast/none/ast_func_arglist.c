@@ -7,15 +7,16 @@
 
 typedef struct {
   SOLC_AST_HEADER;
-  solc_ast_t **elements_v;
+  ast_children_t elements;
 } ast_func_arglist_t;
 
 solc_ast_t *solc_ast_func_arglist_create(sz pos)
 {
-  ast_func_arglist_t *out_func_arglist = malloc(sizeof(ast_func_arglist_t));
+  ast_func_arglist_t *out_func_arglist =
+    SOLC_AST_ALLOC(sizeof(ast_func_arglist_t), SOLC_AST_TYPE_NONE_FUNC_ARGLIST);
   SOLC_AST_INIT_HEADER(out_func_arglist, pos, SOLC_AST_TYPE_NONE_FUNC_ARGLIST);
 
-  out_func_arglist->elements_v = vector_create(solc_ast_t *);
+  small_vector_init(&out_func_arglist->elements);
 
   return SOLC_AST(out_func_arglist);
 }
@@ -26,14 +27,9 @@ void solc_ast_func_arglist_destroy(solc_ast_t *arg_list_ast)
               arg_list_ast->type == SOLC_AST_TYPE_NONE_FUNC_ARGLIST);
 
   SOLC_AST_CAST(arg_list_data, arg_list_ast, ast_func_arglist_t);
-  SOLC_ASSUME(arg_list_data->elements_v != nullptr);
-  for (sz i = 0, elements_v_size = vector_get_length(arg_list_data->elements_v);
-       i < elements_v_size; i++)
-    solc_ast_destroy_if_exists(arg_list_data->elements_v[i]);
+  ast_children_destroy(&arg_list_data->elements);
 
-  vector_destroy(arg_list_data->elements_v);
-
-  free(arg_list_ast);
+  SOLC_AST_FREE(arg_list_ast);
 }
 
 void solc_ast_func_arglist_add_element(solc_ast_t *arg_list_ast,
@@ -42,8 +38,7 @@ void solc_ast_func_arglist_add_element(solc_ast_t *arg_list_ast,
   SOLC_ASSUME(arg_list_ast != nullptr &&
               arg_list_ast->type == SOLC_AST_TYPE_NONE_FUNC_ARGLIST);
   SOLC_AST_CAST(arg_list_data, arg_list_ast, ast_func_arglist_t);
-  SOLC_ASSUME(arg_list_data->elements_v != nullptr);
-  vector_push(arg_list_data->elements_v, arg_list_element_ast);
+  ast_children_push(&arg_list_data->elements, arg_list_element_ast);
 }
 
 string_t *solc_ast_func_arglist_build_tree(solc_ast_t *arg_list_ast)
@@ -51,19 +46,19 @@ string_t *solc_ast_func_arglist_build_tree(solc_ast_t *arg_list_ast)
   SOLC_ASSUME(arg_list_ast != nullptr &&
               arg_list_ast->type == SOLC_AST_TYPE_NONE_FUNC_ARGLIST);
   SOLC_AST_CAST(arg_list_data, arg_list_ast, ast_func_arglist_t);
-  SOLC_ASSUME(arg_list_data->elements_v != nullptr);
 
-  sz elements_v_size = vector_get_length(arg_list_data->elements_v);
-  if (elements_v_size == 0) {
+  sz elements_num = small_vector_get_length(&arg_list_data->elements);
+  if (elements_num == 0) {
     string_t *out_v = vector_reserve(string_t, 1);
     vector_push(out_v, string_create_from("FUNC_ARGLIST"));
     return out_v;
   }
 
   string_t header = string_create_from("FUNC_ARGLIST");
-  string_t **children_vs_v = vector_reserve(string_t *, elements_v_size);
-  for (sz i = 0; i < elements_v_size; i++)
-    solc_ast_add_to_tree_if_exists(children_vs_v, arg_list_data->elements_v[i]);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(elements_num);
+  solc_ast_t **child_asts = small_vector_data(&arg_list_data->elements);
+  for (sz i = 0; i < elements_num; i++)
+    solc_ast_add_to_tree_if_exists(children_vs_v, child_asts[i]);
 
   return ast_build_tree(&header, children_vs_v);
 }
@@ -74,8 +69,7 @@ solc_ast_t **solc_ast_func_arglist_get_element_asts(solc_ast_t *arg_list_ast,
   SOLC_ASSUME(arg_list_ast != nullptr &&
               arg_list_ast->type == SOLC_AST_TYPE_NONE_FUNC_ARGLIST);
   SOLC_AST_CAST(arg_list_data, arg_list_ast, ast_func_arglist_t);
-  SOLC_ASSUME(arg_list_data->elements_v != nullptr);
   if SOLC_LIKELY (out_n != nullptr)
-    *out_n = vector_get_length(arg_list_data->elements_v);
-  return arg_list_data->elements_v;
+    *out_n = small_vector_get_length(&arg_list_data->elements);
+  return small_vector_data(&arg_list_data->elements);
 }
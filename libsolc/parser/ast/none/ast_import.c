@@ -13,7 +13,8 @@ typedef struct {
 
 solc_ast_t *solc_ast_import_create(sz pos, solc_ast_t *module_ast)
 {
-  ast_import_t *out_import = malloc(sizeof(ast_import_t));
+  ast_import_t *out_import =
+    SOLC_AST_ALLOC(sizeof(ast_import_t), SOLC_AST_TYPE_NONE_IMPORT);
   SOLC_AST_INIT_HEADER(out_import, pos, SOLC_AST_TYPE_NONE_IMPORT);
   out_import->module_ast = module_ast;
   return SOLC_AST(out_import);
@@ -27,7 +28,7 @@ void solc_ast_import_destroy(solc_ast_t *import_ast)
 
   solc_ast_destroy_if_exists(import_data->module_ast);
 
-  free(import_ast);
+  SOLC_AST_FREE(import_ast);
 }
 
 string_t *solc_ast_import_build_tree(solc_ast_t *import_ast)
@@ -37,7 +38,7 @@ string_t *solc_ast_import_build_tree(solc_ast_t *import_ast)
   SOLC_AST_CAST(import_data, import_ast, ast_import_t);
 
   string_t header = string_create_from("IMPORT");
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v, import_data->module_ast);
   return ast_build_tree(&header, children_vs_v);
 }
@@ -17,7 +17,8 @@ solc_ast_t *solc_ast_module_create(sz pos, const char *name,
 {
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
-  ast_module_t *out_module = malloc(sizeof(ast_module_t) + name_len);
+  ast_module_t *out_module =
+    SOLC_AST_ALLOC(sizeof(ast_module_t) + name_len, SOLC_AST_TYPE_NONE_MODULE);
   SOLC_AST_INIT_HEADER(out_module, pos, SOLC_AST_TYPE_NONE_MODULE);
   out_module->submodule_ast = submodule_ast;
   out_module->name = (char *)out_module + sizeof(ast_module_t);
@@ -31,7 +32,7 @@ void solc_ast_module_destroy(solc_ast_t *module_ast)
               module_ast->type == SOLC_AST_TYPE_NONE_MODULE);
   SOLC_AST_CAST(module_data, module_ast, ast_module_t);
   solc_ast_destroy_if_exists(module_data->submodule_ast);
-  free(module_ast);
+  SOLC_AST_FREE(module_ast);
 }
 
 string_t *solc_ast_module_build_tree(solc_ast_t *module_ast)
@@ -50,7 +51,7 @@ string_t *solc_ast_module_build_tree(solc_ast_t *module_ast)
     return out_v;
   }
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v, module_data->submodule_ast);
   return ast_build_tree(&header, children_vs_v);
 }
@@ -18,7 +18,9 @@ solc_ast_t *solc_ast_namespace_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_namespace_t *out_namespace = malloc(sizeof(ast_namespace_t) + name_len);
+  ast_namespace_t *out_namespace =
+    SOLC_AST_ALLOC(sizeof(ast_namespace_t) + name_len,
+                   SOLC_AST_TYPE_NONE_NAMESPACE);
   SOLC_AST_INIT_HEADER(out_namespace, pos, SOLC_AST_TYPE_NONE_NAMESPACE);
   out_namespace->subobject_ast = subobject_ast;
   out_namespace->name = (char *)out_namespace + sizeof(ast_namespace_t);
@@ -32,7 +34,7 @@ void solc_ast_namespace_destroy(solc_ast_t *namespace_ast)
               namespace_ast->type == SOLC_AST_TYPE_NONE_NAMESPACE);
   SOLC_AST_CAST(namespace_data, namespace_ast, ast_namespace_t);
   solc_ast_destroy_if_exists(namespace_data->subobject_ast);
-  free(namespace_data);
+  SOLC_AST_FREE(namespace_data);
 }
 
 string_t *solc_ast_namespace_build_tree(solc_ast_t *namespace_ast)
@@ -46,7 +48,7 @@ string_t *solc_ast_namespace_build_tree(solc_ast_t *namespace_ast)
   string_append_cstr(&header, namespace_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v, namespace_data->subobject_ast);
 
   return ast_build_tree(&header, children_vs_v);
@@ -6,7 +6,8 @@
 
 solc_ast_t *solc_ast_none_create(sz pos)
 {
-  solc_ast_t *out_none = (solc_ast_t *)malloc(sizeof(solc_ast_t));
+  solc_ast_t *out_none = (solc_ast_t *)
+    SOLC_AST_ALLOC(sizeof(solc_ast_t), SOLC_AST_TYPE_NONE_NONE);
   out_none->token_pos = pos;
   out_none->type = SOLC_AST_TYPE_NONE_NONE;
   return out_none;
@@ -15,7 +16,7 @@ solc_ast_t *solc_ast_none_create(sz pos)
 void solc_ast_none_destroy(solc_ast_t *none_ast)
 {
   SOLC_ASSUME(none_ast != nullptr && none_ast->type == SOLC_AST_TYPE_NONE_NONE);
-  free(none_ast);
+  SOLC_AST_FREE(none_ast);
 }
 
 string_t *solc_ast_none_build_tree(solc_ast_t *none_ast)
@@ -15,7 +15,8 @@ solc_ast_t *solc_ast_prefix_expr_create(sz pos, solc_ast_t *operand_ast,
 {
   SOLC_ASSUME(operators_v != nullptr);
 
-  ast_prefix_expr_t *out_prefix_expr = malloc(sizeof(ast_prefix_expr_t));
+  ast_prefix_expr_t *out_prefix_expr =
+    SOLC_AST_ALLOC(sizeof(ast_prefix_expr_t), SOLC_AST_TYPE_NONE_PREFIX_EXPR);
   SOLC_AST_INIT_HEADER(out_prefix_expr, pos, SOLC_AST_TYPE_NONE_PREFIX_EXPR);
   out_prefix_expr->operand_ast = operand_ast;
   out_prefix_expr->operators_v = operators_v;
@@ -30,7 +31,7 @@ void solc_ast_prefix_expr_destroy(solc_ast_t *prefix_expr_ast)
   SOLC_ASSUME(prefix_expr_data->operators_v != nullptr);
   solc_ast_destroy_if_exists(prefix_expr_data->operand_ast);
   vector_destroy(prefix_expr_data->operators_v);
-  free(prefix_expr_ast);
+  SOLC_AST_FREE(prefix_expr_ast);
 }
 
 string_t *solc_ast_prefix_expr_build_tree(solc_ast_t *prefix_expr_ast)
@@ -48,7 +49,7 @@ string_t *solc_ast_prefix_expr_build_tree(solc_ast_t *prefix_expr_ast)
   }
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v, prefix_expr_data->operand_ast);
 
   return ast_build_tree(&header, children_vs_v);
@@ -18,7 +18,9 @@ solc_ast_t *solc_ast_qualifier_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_qualifier_t *out_qualifier = malloc(sizeof(ast_qualifier_t) + name_len);
+  ast_qualifier_t *out_qualifier =
+    SOLC_AST_ALLOC(sizeof(ast_qualifier_t) + name_len,
+                   SOLC_AST_TYPE_NONE_QUALIFIER);
   SOLC_AST_INIT_HEADER(out_qualifier, pos, SOLC_AST_TYPE_NONE_QUALIFIER);
   out_qualifier->qualified_ast = qualified_ast;
   out_qualifier->name = (char *)out_qualifier + sizeof(ast_qualifier_t);
@@ -32,7 +34,7 @@ void solc_ast_qualifier_destroy(solc_ast_t *qualifier_ast)
               qualifier_ast->type == SOLC_AST_TYPE_NONE_QUALIFIER);
   SOLC_AST_CAST(qualifier_data, qualifier_ast, ast_qualifier_t);
   solc_ast_destroy_if_exists(qualifier_data->qualified_ast);
-  free(qualifier_ast);
+  SOLC_AST_FREE(qualifier_ast);
 }
 
 string_t *solc_ast_qualifier_build_tree(solc_ast_t *qualifier_ast)
@@ -46,7 +48,7 @@ string_t *solc_ast_qualifier_build_tree(solc_ast_t *qualifier_ast)
   string_append_cstr(&header, qualifier_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v, qualifier_data->qualified_ast);
 
   return ast_build_tree(&header, children_vs_v);
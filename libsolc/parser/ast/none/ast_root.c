@@ -12,7 +12,8 @@ typedef struct {
 
 solc_ast_t *solc_ast_root_create(void)
 {
-  ast_root_t *out_root = malloc(sizeof(ast_root_t));
+  ast_root_t *out_root =
+    SOLC_AST_ALLOC(sizeof(ast_root_t), SOLC_AST_TYPE_NONE_ROOT);
   SOLC_AST_INIT_HEADER(out_root, 0, SOLC_AST_TYPE_NONE_ROOT);
   out_root->top_stmts_v = vector_create(solc_ast_t *);
   return SOLC_AST(out_root);
@@ -28,7 +29,7 @@ void solc_ast_root_destroy(solc_ast_t *root_ast)
        i < top_stmts_v_size; i++)
     solc_ast_destroy_if_exists(root_data->top_stmts_v[i]);
   vector_destroy(root_data->top_stmts_v);
-  free(root_data);
+  SOLC_AST_FREE(root_data);
 }
 
 void solc_ast_root_add_top_statement(solc_ast_t *root_ast,
@@ -46,7 +47,7 @@ string_t *solc_ast_root_build_tree(solc_ast_t *root_ast)
   SOLC_AST_CAST(root_data, root_ast, ast_root_t);
   SOLC_ASSUME(root_data->top_stmts_v != nullptr);
   sz top_stmts_v_len = vector_get_length(root_data->top_stmts_v);
-  string_t **children_vs_v = vector_reserve(string_t *, top_stmts_v_len);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(top_stmts_v_len);
   for (sz i = 0; i < top_stmts_v_len; i++)
     solc_ast_add_to_tree_if_exists(children_vs_v, root_data->top_stmts_v[i]);
   string_t header = string_create_from("ROOT");
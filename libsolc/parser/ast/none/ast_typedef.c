@@ -20,7 +20,9 @@ solc_ast_t *solc_ast_typedef_create(sz pos, solc_ast_t *type_ast,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_typedef_t *out_typedef = malloc(sizeof(ast_typedef_t) + name_len);
+  ast_typedef_t *out_typedef =
+    SOLC_AST_ALLOC(sizeof(ast_typedef_t) + name_len,
+                   SOLC_AST_TYPE_NONE_TYPEDEF);
   SOLC_AST_INIT_HEADER(out_typedef, pos, SOLC_AST_TYPE_NONE_TYPEDEF);
   out_typedef->attribute_list_ast = attribute_list_ast;
   out_typedef->type_ast = type_ast;
@@ -36,7 +38,7 @@ void solc_ast_typedef_destroy(solc_ast_t *typedef_ast)
   SOLC_AST_CAST(typedef_data, typedef_ast, ast_typedef_t);
   solc_ast_destroy_if_exists(typedef_data->attribute_list_ast);
   solc_ast_destroy_if_exists(typedef_data->type_ast);
-  free(typedef_data);
+  SOLC_AST_FREE(typedef_data);
 }
 
 string_t *solc_ast_typedef_build_tree(solc_ast_t *typedef_ast)
@@ -49,7 +51,7 @@ string_t *solc_ast_typedef_build_tree(solc_ast_t *typedef_ast)
   string_append_cstr(&header, typedef_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  typedef_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, typedef_data->type_ast);
@@ -8,7 +8,7 @@
 typedef struct {
   SOLC_AST_HEADER;
   solc_ast_t *attribute_list_ast;
-  solc_ast_t **children_v;
+  ast_children_t children;
   char *name;
 } ast_union_t;
 
@@ -18,10 +18,11 @@ solc_ast_t *solc_ast_union_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_union_t *out_union = malloc(sizeof(ast_union_t) + name_len);
+  ast_union_t *out_union =
+    SOLC_AST_ALLOC(sizeof(ast_union_t) + name_len, SOLC_AST_TYPE_NONE_UNION);
   SOLC_AST_INIT_HEADER(out_union, pos, SOLC_AST_TYPE_NONE_UNION);
   out_union->attribute_list_ast = attribute_list_ast;
-  out_union->children_v = vector_create(solc_ast_t *);
+  small_vector_init(&out_union->children);
   out_union->name = (char *)out_union + sizeof(ast_union_t);
   memcpy(out_union->name, name, name_len);
   return SOLC_AST(out_union);
@@ -32,13 +33,9 @@ void solc_ast_union_destroy(solc_ast_t *union_ast)
   SOLC_ASSUME(union_ast != nullptr &&
               union_ast->type == SOLC_AST_TYPE_NONE_UNION);
   SOLC_AST_CAST(union_data, union_ast, ast_union_t);
-  SOLC_ASSUME(union_data->children_v != nullptr);
-  for (sz i = 0, children_v_size = vector_get_length(union_data->children_v);
-       i < children_v_size; i++)
-    solc_ast_destroy_if_exists(union_data->children_v[i]);
-  vector_destroy(union_data->children_v);
+  ast_children_destroy(&union_data->children);
   solc_ast_destroy_if_exists(union_data->attribute_list_ast);
-  free(union_data);
+  SOLC_AST_FREE(union_data);
 }
 
 void solc_ast_union_add_child(solc_ast_t *union_ast, solc_ast_t *child_ast)
@@ -46,8 +43,7 @@ void solc_ast_union_add_child(solc_ast_t *union_ast, solc_ast_t *child_ast)
   SOLC_ASSUME(union_ast != nullptr &&
               union_ast->type == SOLC_AST_TYPE_NONE_UNION);
   SOLC_AST_CAST(union_data, union_ast, ast_union_t);
-  SOLC_ASSUME(union_data->children_v != nullptr);
-  vector_push(union_data->children_v, child_ast);
+  ast_children_push(&union_data->children, child_ast);
 }
 
 string_t *solc_ast_union_build_tree(solc_ast_t *union_ast)
@@ -55,17 +51,18 @@ string_t *solc_ast_union_build_tree(solc_ast_t *union_ast)
   SOLC_ASSUME(union_ast != nullptr &&
               union_ast->type == SOLC_AST_TYPE_NONE_UNION);
   SOLC_AST_CAST(union_data, union_ast, ast_union_t);
-  SOLC_ASSUME(union_data->children_v != nullptr && union_data->name != nullptr);
+  SOLC_ASSUME(union_data->name != nullptr);
 
   string_t header = string_create_from("UNION { name: \"");
   string_append_cstr(&header, union_data->name);
   string_append_cstr(&header, "\" }");
 
-  sz children_v_size = vector_get_length(union_data->children_v);
-  string_t **children_vs_v = vector_reserve(string_t *, children_v_size + 1);
+  sz children_num = small_vector_get_length(&union_data->children);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(children_num + 1);
   solc_ast_add_to_tree_if_exists(children_vs_v, union_data->attribute_list_ast);
-  for (sz i = 0; i < children_v_size; i++)
-    solc_ast_add_to_tree_if_exists(children_vs_v, union_data->children_v[i]);
+  solc_ast_t **child_asts = small_vector_data(&union_data->children);
+  for (sz i = 0; i < children_num; i++)
+    solc_ast_add_to_tree_if_exists(children_vs_v, child_asts[i]);
 
   return ast_build_tree(&header, children_vs_v);
 }
@@ -84,10 +81,9 @@ solc_ast_t **solc_ast_union_get_child_asts(solc_ast_t *union_ast, sz *out_n)
   SOLC_ASSUME(union_ast != nullptr &&
               union_ast->type == SOLC_AST_TYPE_NONE_UNION);
   SOLC_AST_CAST(union_data, union_ast, ast_union_t);
-  SOLC_ASSUME(union_data->children_v != nullptr);
   if SOLC_LIKELY (out_n != nullptr)
-    *out_n = vector_get_length(union_data->children_v);
-  return union_data->children_v;
+    *out_n = small_vector_get_length(&union_data->children);
+  return small_vector_data(&union_data->children);
 }
 
 solc_ast_t *solc_ast_union_get_attribute_list_ast(solc_ast_t *union_ast)
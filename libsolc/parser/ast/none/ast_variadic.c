@@ -6,7 +6,8 @@
 
 solc_ast_t *solc_ast_variadic_create(sz pos)
 {
-  solc_ast_t *out_variadic = (solc_ast_t *)malloc(sizeof(solc_ast_t));
+  solc_ast_t *out_variadic = (solc_ast_t *)
+    SOLC_AST_ALLOC(sizeof(solc_ast_t), SOLC_AST_TYPE_NONE_VARIADIC);
   out_variadic->token_pos = pos;
   out_variadic->type = SOLC_AST_TYPE_NONE_VARIADIC;
   return out_variadic;
@@ -16,7 +17,7 @@ void solc_ast_variadic_destroy(solc_ast_t *variadic_ast)
 {
   SOLC_ASSUME(variadic_ast != nullptr &&
               variadic_ast->type == SOLC_AST_TYPE_NONE_VARIADIC);
-  free(variadic_ast);
+  SOLC_AST_FREE(variadic_ast);
 }
 
 string_t *solc_ast_variadic_build_tree(solc_ast_t *variadic_ast)
@@ -16,7 +16,9 @@ solc_ast_t *solc_ast_vismarker_create(sz pos, const char *name)
 {
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
-  ast_vismarker_t *out_vismarker = malloc(sizeof(ast_vismarker_t) + name_len);
+  ast_vismarker_t *out_vismarker =
+    SOLC_AST_ALLOC(sizeof(ast_vismarker_t) + name_len,
+                   SOLC_AST_TYPE_NONE_VISMARKER);
   SOLC_AST_INIT_HEADER(out_vismarker, pos, SOLC_AST_TYPE_NONE_VISMARKER);
   out_vismarker->name = (char *)out_vismarker + sizeof(ast_vismarker_t);
   memcpy(out_vismarker->name, name, name_len);
@@ -27,7 +29,7 @@ void solc_ast_vismarker_destroy(solc_ast_t *vismarker_ast)
 {
   SOLC_ASSUME(vismarker_ast != nullptr &&
               vismarker_ast->type == SOLC_AST_TYPE_NONE_VISMARKER);
-  free(vismarker_ast);
+  SOLC_AST_FREE(vismarker_ast);
 }
 
 string_t *solc_ast_vismarker_build_tree(solc_ast_t *vismarker_ast)
@@ -37,15 +39,12 @@ string_t *solc_ast_vismarker_build_tree(solc_ast_t *vismarker_ast)
   SOLC_AST_CAST(vismarker_data, vismarker_ast, ast_vismarker_t);
   SOLC_ASSUME(vismarker_data->name != nullptr);
 
-  const sz n =
-    sizeof("VISMARKER { name: \"\" }") + strlen(vismarker_data->name);
-  char *buf = malloc(sizeof(char) * (n + 1));
-  snprintf(buf, n, "VISMARKER { name: \"%s\" }", vismarker_data->name);
+  string_t header = string_create();
+  string_append_fmt(&header, "VISMARKER { name: \"%s\" }",
+                    vismarker_data->name);
 
   string_t *out = vector_reserve(string_t, 1);
-  vector_push(out, string_create_from(buf));
-
-  free(buf);
+  vector_push(out, header);
   return out;
 }
 
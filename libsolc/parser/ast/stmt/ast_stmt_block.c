@@ -6,14 +6,15 @@
 
 typedef struct {
   SOLC_AST_HEADER;
-  solc_ast_t **stmt_asts_v;
+  ast_children_t stmt_asts;
 } ast_block_stmt_t;
 
 solc_ast_t *solc_ast_stmt_block_create(sz pos)
 {
-  ast_block_stmt_t *out_block_stmt = malloc(sizeof(ast_block_stmt_t));
+  ast_block_stmt_t *out_block_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_block_stmt_t), SOLC_AST_TYPE_STMT_BLOCK);
   SOLC_AST_INIT_HEADER(out_block_stmt, pos, SOLC_AST_TYPE_STMT_BLOCK);
-  out_block_stmt->stmt_asts_v = vector_create(solc_ast_t *);
+  small_vector_init(&out_block_stmt->stmt_asts);
   return SOLC_AST(out_block_stmt);
 }
 
@@ -22,12 +23,8 @@ void solc_ast_stmt_block_destroy(solc_ast_t *block_ast)
   SOLC_ASSUME(block_ast != nullptr &&
               block_ast->type == SOLC_AST_TYPE_STMT_BLOCK);
   SOLC_AST_CAST(block_data, block_ast, ast_block_stmt_t);
-  SOLC_ASSUME(block_data->stmt_asts_v != nullptr);
-  for (sz i = 0, stmt_asts_v_size = vector_get_length(block_data->stmt_asts_v);
-       i < stmt_asts_v_size; i++)
-    solc_ast_destroy_if_exists(block_data->stmt_asts_v[i]);
-  vector_destroy(block_data->stmt_asts_v);
-  free(block_ast);
+  ast_children_destroy(&block_data->stmt_asts);
+  SOLC_AST_FREE(block_ast);
 }
 
 void solc_ast_stmt_block_add_stmt(solc_ast_t *block_ast, solc_ast_t *stmt_ast)
@@ -35,8 +32,7 @@ void solc_ast_stmt_block_add_stmt(solc_ast_t *block_ast, solc_ast_t *stmt_ast)
   SOLC_ASSUME(block_ast != nullptr &&
               block_ast->type == SOLC_AST_TYPE_STMT_BLOCK);
   SOLC_AST_CAST(block_data, block_ast, ast_block_stmt_t);
-  SOLC_ASSUME(block_data->stmt_asts_v != nullptr);
-  vector_push(block_data->stmt_asts_v, stmt_ast);
+  ast_children_push(&block_data->stmt_asts, stmt_ast);
 }
 
 string_t *solc_ast_stmt_block_build_tree(solc_ast_t *block_ast)
@@ -44,19 +40,19 @@ string_t *solc_ast_stmt_block_build_tree(solc_ast_t *block_ast)
   SOLC_ASSUME(block_ast != nullptr &&
               block_ast->type == SOLC_AST_TYPE_STMT_BLOCK);
   SOLC_AST_CAST(block_data, block_ast, ast_block_stmt_t);
-  SOLC_ASSUME(block_data->stmt_asts_v != nullptr);
 
   string_t header = string_create_from("STMT_BLOCK");
-  sz stmt_asts_v_size = vector_get_length(block_data->stmt_asts_v);
-  if SOLC_UNLIKELY (stmt_asts_v_size == 0) {
+  sz stmt_asts_num = small_vector_get_length(&block_data->stmt_asts);
+  if SOLC_UNLIKELY (stmt_asts_num == 0) {
     string_t *out_v = vector_reserve(string_t, 1);
     vector_push(out_v, header);
     return out_v;
   }
 
-  string_t **children_vs_v = vector_reserve(string_t *, stmt_asts_v_size);
-  for (sz i = 0; i < stmt_asts_v_size; i++)
-    solc_ast_add_to_tree_if_exists(children_vs_v, block_data->stmt_asts_v[i]);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(stmt_asts_num);
+  solc_ast_t **child_asts = small_vector_data(&block_data->stmt_asts);
+  for (sz i = 0; i < stmt_asts_num; i++)
+    solc_ast_add_to_tree_if_exists(children_vs_v, child_asts[i]);
 
   return ast_build_tree(&header, children_vs_v);
 }
@@ -66,8 +62,7 @@ solc_ast_t **solc_ast_stmt_block_get_stmt_asts(solc_ast_t *block_ast, sz *out_n)
   SOLC_ASSUME(block_ast != nullptr &&
               block_ast->type == SOLC_AST_TYPE_STMT_BLOCK);
   SOLC_AST_CAST(block_data, block_ast, ast_block_stmt_t);
-  SOLC_ASSUME(block_data->stmt_asts_v != nullptr);
   if SOLC_LIKELY (out_n != nullptr)
-    *out_n = vector_get_length(block_data->stmt_asts_v);
-  return block_data->stmt_asts_v;
+    *out_n = small_vector_get_length(&block_data->stmt_asts);
+  return small_vector_data(&block_data->stmt_asts);
 }
@@ -7,7 +7,8 @@
 
 solc_ast_t *solc_ast_stmt_break_create(sz pos)
 {
-  solc_ast_t *out_break_stmt = malloc(sizeof(solc_ast_t));
+  solc_ast_t *out_break_stmt =
+    SOLC_AST_ALLOC(sizeof(solc_ast_t), SOLC_AST_TYPE_STMT_BREAK);
   out_break_stmt->token_pos = pos;
   out_break_stmt->type = SOLC_AST_TYPE_STMT_BREAK;
   return out_break_stmt;
@@ -17,7 +18,7 @@ void solc_ast_stmt_break_destroy(solc_ast_t *break_ast)
 {
   SOLC_ASSUME(break_ast != nullptr &&
               break_ast->type == SOLC_AST_TYPE_STMT_BREAK);
-  free(break_ast);
+  SOLC_AST_FREE(break_ast);
 }
 
 string_t *solc_ast_stmt_break_build_tree(solc_ast_t *break_ast)
@@ -14,7 +14,8 @@ typedef struct {
 solc_ast_t *solc_ast_stmt_case_create(sz pos, solc_ast_t *expr_ast,
                                       solc_ast_t *block_ast)
 {
-  ast_case_stmt_t *out_case_stmt = malloc(sizeof(ast_case_stmt_t));
+  ast_case_stmt_t *out_case_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_case_stmt_t), SOLC_AST_TYPE_STMT_CASE);
   SOLC_AST_INIT_HEADER(out_case_stmt, pos, SOLC_AST_TYPE_STMT_CASE);
   out_case_stmt->expr_ast = expr_ast;
   out_case_stmt->block_ast = block_ast;
@@ -27,7 +28,7 @@ void solc_ast_stmt_case_destroy(solc_ast_t *case_ast)
   SOLC_AST_CAST(case_data, case_ast, ast_case_stmt_t);
   solc_ast_destroy_if_exists(case_data->expr_ast);
   solc_ast_destroy_if_exists(case_data->block_ast);
-  free(case_ast);
+  SOLC_AST_FREE(case_ast);
 }
 
 string_t *solc_ast_stmt_case_build_tree(solc_ast_t *case_ast)
@@ -35,7 +36,7 @@ string_t *solc_ast_stmt_case_build_tree(solc_ast_t *case_ast)
   SOLC_ASSUME(case_ast != nullptr && case_ast->type == SOLC_AST_TYPE_STMT_CASE);
   SOLC_AST_CAST(case_data, case_ast, ast_case_stmt_t);
   string_t header = string_create_from("STMT_CASE");
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v, case_data->expr_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, case_data->block_ast);
 
@@ -7,7 +7,8 @@
 
 solc_ast_t *solc_ast_stmt_continue_create(sz pos)
 {
-  solc_ast_t *out_continue_stmt = malloc(sizeof(solc_ast_t));
+  solc_ast_t *out_continue_stmt =
+    SOLC_AST_ALLOC(sizeof(solc_ast_t), SOLC_AST_TYPE_STMT_CONTINUE);
   out_continue_stmt->token_pos = pos;
   out_continue_stmt->type = SOLC_AST_TYPE_STMT_CONTINUE;
   return out_continue_stmt;
@@ -17,7 +18,7 @@ void solc_ast_stmt_continue_destroy(solc_ast_t *continue_ast)
 {
   SOLC_ASSUME(continue_ast != nullptr &&
               continue_ast->type == SOLC_AST_TYPE_STMT_CONTINUE);
-  free(continue_ast);
+  SOLC_AST_FREE(continue_ast);
 }
 
 string_t *solc_ast_stmt_continue_build_tree(solc_ast_t *continue_ast)
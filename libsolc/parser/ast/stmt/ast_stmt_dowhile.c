@@ -16,7 +16,8 @@ solc_ast_t *solc_ast_stmt_dowhile_create(sz pos, solc_ast_t *condition_expr_ast,
                                          solc_ast_t *stmt_ast,
                                          solc_ast_t *attribute_list_ast)
 {
-  ast_dowhile_t *out_dowhile_ast = malloc(sizeof(ast_dowhile_t));
+  ast_dowhile_t *out_dowhile_ast =
+    SOLC_AST_ALLOC(sizeof(ast_dowhile_t), SOLC_AST_TYPE_STMT_DOWHILE);
   SOLC_AST_INIT_HEADER(out_dowhile_ast, pos, SOLC_AST_TYPE_STMT_DOWHILE);
   out_dowhile_ast->attribute_list_ast = attribute_list_ast;
   out_dowhile_ast->condition_expr_ast = condition_expr_ast;
@@ -32,7 +33,7 @@ void solc_ast_stmt_dowhile_destroy(solc_ast_t *dowhile_ast)
   solc_ast_destroy_if_exists(dowhile_data->attribute_list_ast);
   solc_ast_destroy_if_exists(dowhile_data->condition_expr_ast);
   solc_ast_destroy_if_exists(dowhile_data->stmt_ast);
-  free(dowhile_data);
+  SOLC_AST_FREE(dowhile_data);
 }
 
 string_t *solc_ast_stmt_dowhile_build_tree(solc_ast_t *dowhile_ast)
@@ -41,7 +42,7 @@ string_t *solc_ast_stmt_dowhile_build_tree(solc_ast_t *dowhile_ast)
               dowhile_ast->type == SOLC_AST_TYPE_STMT_DOWHILE);
   SOLC_AST_CAST(dowhile_data, dowhile_ast, ast_dowhile_t);
   string_t header = string_create_from("STMT_DOWHILE");
-  string_t **children_vs_v = vector_reserve(string_t *, 3);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(3);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  dowhile_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v,
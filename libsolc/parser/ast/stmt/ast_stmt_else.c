@@ -11,7 +11,8 @@ typedef struct {
 
 solc_ast_t *solc_ast_stmt_else_create(sz pos, solc_ast_t *stmt_ast)
 {
-  ast_else_t *out_else_stmt = malloc(sizeof(ast_else_t));
+  ast_else_t *out_else_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_else_t), SOLC_AST_TYPE_STMT_ELSE);
   SOLC_AST_INIT_HEADER(out_else_stmt, pos, SOLC_AST_TYPE_STMT_ELSE);
   out_else_stmt->stmt_ast = stmt_ast;
   return SOLC_AST(out_else_stmt);
@@ -22,7 +23,7 @@ void solc_ast_stmt_else_destroy(solc_ast_t *else_ast)
   SOLC_ASSUME(else_ast != nullptr && else_ast->type == SOLC_AST_TYPE_STMT_ELSE);
   SOLC_AST_CAST(else_data, else_ast, ast_else_t);
   solc_ast_destroy_if_exists(else_data->stmt_ast);
-  free(else_ast);
+  SOLC_AST_FREE(else_ast);
 }
 
 string_t *solc_ast_stmt_else_build_tree(solc_ast_t *else_ast)
@@ -31,7 +32,7 @@ string_t *solc_ast_stmt_else_build_tree(solc_ast_t *else_ast)
   SOLC_AST_CAST(else_data, else_ast, ast_else_t);
 
   string_t header = string_create_from("STMT_ELSE");
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   solc_ast_add_to_tree_if_exists(children_vs_v, else_data->stmt_ast);
 
   return ast_build_tree(&header, children_vs_v);
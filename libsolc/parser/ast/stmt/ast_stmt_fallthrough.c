@@ -1,11 +1,13 @@
 #include "containers/string.h"
 #include "containers/vector.h"
+#include "parser/ast_private.h"
 #include "solc/parser/ast.h"
 #include <stdlib.h>
 
 solc_ast_t *solc_ast_stmt_fallthrough_create(sz pos)
 {
-  solc_ast_t *out_fallthrough_stmt = malloc(sizeof(solc_ast_t));
+  solc_ast_t *out_fallthrough_stmt =
+    SOLC_AST_ALLOC(sizeof(solc_ast_t), SOLC_AST_TYPE_STMT_FALLTHROUGH);
   out_fallthrough_stmt->token_pos = pos;
   out_fallthrough_stmt->type = SOLC_AST_TYPE_STMT_FALLTHROUGH;
   return out_fallthrough_stmt;
@@ -15,7 +17,7 @@ void solc_ast_stmt_fallthrough_destroy(solc_ast_t *fallthrough_ast)
 {
   SOLC_ASSUME(fallthrough_ast != nullptr &&
               fallthrough_ast->type == SOLC_AST_TYPE_STMT_FALLTHROUGH);
-  free(fallthrough_ast);
+  SOLC_AST_FREE(fallthrough_ast);
 }
 
 string_t *solc_ast_stmt_fallthrough_build_tree(solc_ast_t *fallthrough_ast)
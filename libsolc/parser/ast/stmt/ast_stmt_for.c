@@ -19,7 +19,8 @@ solc_ast_t *solc_ast_stmt_for_create(sz pos, solc_ast_t *init_stmt_ast,
                                      solc_ast_t *expr_ast, solc_ast_t *stmt_ast,
                                      solc_ast_t *attribute_list_ast)
 {
-  ast_for_stmt_t *out_for_stmt = malloc(sizeof(ast_for_stmt_t));
+  ast_for_stmt_t *out_for_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_for_stmt_t), SOLC_AST_TYPE_STMT_FOR);
   SOLC_AST_INIT_HEADER(out_for_stmt, pos, SOLC_AST_TYPE_STMT_FOR);
   out_for_stmt->attribute_list_ast = attribute_list_ast;
   out_for_stmt->init_stmt_ast = init_stmt_ast;
@@ -38,7 +39,7 @@ void solc_ast_stmt_for_destroy(solc_ast_t *for_ast)
   solc_ast_destroy_if_exists(for_data->condition_expr_ast);
   solc_ast_destroy_if_exists(for_data->expr_ast);
   solc_ast_destroy_if_exists(for_data->stmt_ast);
-  free(for_ast);
+  SOLC_AST_FREE(for_ast);
 }
 
 string_t *solc_ast_stmt_for_build_tree(solc_ast_t *for_ast)
@@ -46,7 +47,7 @@ string_t *solc_ast_stmt_for_build_tree(solc_ast_t *for_ast)
   SOLC_ASSUME(for_ast != nullptr && for_ast->type == SOLC_AST_TYPE_STMT_FOR);
   SOLC_AST_CAST(for_data, for_ast, ast_for_stmt_t);
   string_t header = string_create_from("STMT_FOR");
-  string_t **children_vs_v = vector_reserve(string_t *, 5);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(5);
   solc_ast_add_to_tree_if_exists(children_vs_v, for_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, for_data->init_stmt_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, for_data->condition_expr_ast);
@@ -16,7 +16,8 @@ solc_ast_t *solc_ast_stmt_goto_create(sz pos, const char *label_name)
   SOLC_ASSUME(label_name != nullptr);
   const sz label_name_len = strlen(label_name);
   ast_goto_stmt_t *out_goto_stmt =
-    malloc(sizeof(ast_goto_stmt_t) + label_name_len);
+    SOLC_AST_ALLOC(sizeof(ast_goto_stmt_t) + label_name_len,
+                   SOLC_AST_TYPE_STMT_GOTO);
   SOLC_AST_INIT_HEADER(out_goto_stmt, pos, SOLC_AST_TYPE_STMT_GOTO);
   out_goto_stmt->label_name = (char *)out_goto_stmt + sizeof(ast_goto_stmt_t);
   memcpy(out_goto_stmt->label_name, label_name, label_name_len);
@@ -26,7 +27,7 @@ solc_ast_t *solc_ast_stmt_goto_create(sz pos, const char *label_name)
 void solc_ast_stmt_goto_destroy(solc_ast_t *goto_ast)
 {
   SOLC_ASSUME(goto_ast != nullptr && goto_ast->type == SOLC_AST_TYPE_STMT_GOTO);
-  free(goto_ast);
+  SOLC_AST_FREE(goto_ast);
 }
 
 string_t *solc_ast_stmt_goto_build_tree(solc_ast_t *goto_ast)
@@ -17,7 +17,8 @@ solc_ast_t *solc_ast_stmt_if_create(sz pos, solc_ast_t *condition_expr_ast,
                                     solc_ast_t *attrib_list_ast,
                                     solc_ast_t *stmt_ast, solc_ast_t *else_ast)
 {
-  ast_if_stmt_t *out_if_stmt = malloc(sizeof(ast_if_stmt_t));
+  ast_if_stmt_t *out_if_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_if_stmt_t), SOLC_AST_TYPE_STMT_IF);
   SOLC_AST_INIT_HEADER(out_if_stmt, pos, SOLC_AST_TYPE_STMT_IF);
   out_if_stmt->condition_expr_ast = condition_expr_ast;
   out_if_stmt->attrib_list_ast = attrib_list_ast;
@@ -34,7 +35,7 @@ void solc_ast_stmt_if_destroy(solc_ast_t *if_ast)
   solc_ast_destroy_if_exists(if_data->attrib_list_ast);
   solc_ast_destroy_if_exists(if_data->stmt_ast);
   solc_ast_destroy_if_exists(if_data->else_ast);
-  free(if_ast);
+  SOLC_AST_FREE(if_ast);
 }
 
 string_t *solc_ast_stmt_if_build_tree(solc_ast_t *if_ast)
@@ -43,7 +44,7 @@ string_t *solc_ast_stmt_if_build_tree(solc_ast_t *if_ast)
   SOLC_AST_CAST(if_data, if_ast, ast_if_stmt_t);
 
   string_t header = string_create_from("STMT_IF");
-  string_t **children_vs_v = vector_reserve(string_t *, 4);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(4);
   solc_ast_add_to_tree_if_exists(children_vs_v, if_data->attrib_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, if_data->condition_expr_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, if_data->stmt_ast);
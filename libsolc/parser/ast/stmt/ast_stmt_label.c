@@ -18,7 +18,8 @@ solc_ast_t *solc_ast_stmt_label_create(sz pos, const char *name)
 
   const sz name_len = strlen(name) + 1;
   ast_label_stmt_t *out_label_stmt =
-    malloc(sizeof(ast_label_stmt_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_label_stmt_t) + name_len,
+                   SOLC_AST_TYPE_STMT_LABEL);
   SOLC_AST_INIT_HEADER(out_label_stmt, pos, SOLC_AST_TYPE_STMT_LABEL);
   out_label_stmt->name = (char *)out_label_stmt + sizeof(ast_label_stmt_t);
   memcpy(out_label_stmt->name, name, name_len);
@@ -30,7 +31,7 @@ void solc_ast_stmt_label_destroy(solc_ast_t *label_ast)
   SOLC_ASSUME(label_ast != nullptr &&
               label_ast->type == SOLC_AST_TYPE_STMT_LABEL);
 
-  free(label_ast);
+  SOLC_AST_FREE(label_ast);
 }
 
 string_t *solc_ast_stmt_label_build_tree(solc_ast_t *label_ast)
@@ -10,7 +10,8 @@ typedef struct {
 
 solc_ast_t *solc_ast_stmt_return_create(sz pos, solc_ast_t *expr_ast)
 {
-  ast_return_stmt_t *out_return_stmt = malloc(sizeof(ast_return_stmt_t));
+  ast_return_stmt_t *out_return_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_return_stmt_t), SOLC_AST_TYPE_STMT_RETURN);
   SOLC_AST_INIT_HEADER(out_return_stmt, pos, SOLC_AST_TYPE_STMT_RETURN);
   out_return_stmt->expr_ast = expr_ast;
   return SOLC_AST(out_return_stmt);
@@ -22,7 +23,7 @@ void solc_ast_stmt_return_destroy(solc_ast_t *return_ast)
               return_ast->type == SOLC_AST_TYPE_STMT_RETURN);
   SOLC_AST_CAST(return_data, return_ast, ast_return_stmt_t);
   solc_ast_destroy_if_exists(return_data->expr_ast);
-  free(return_ast);
+  SOLC_AST_FREE(return_ast);
 }
 
 string_t *solc_ast_stmt_return_build_tree(solc_ast_t *return_ast)
@@ -38,7 +39,7 @@ string_t *solc_ast_stmt_return_build_tree(solc_ast_t *return_ast)
     return out_v;
   }
 
-  string_t **children_vs_v = vector_reserve(string_t *, 1);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(1);
   vector_push(children_vs_v,
               ast_get_build_tree_func(return_data->expr_ast->type)(
                 return_data->expr_ast));
@@ -16,7 +16,8 @@ solc_ast_t *solc_ast_stmt_while_create(sz pos, solc_ast_t *condition_expr_ast,
                                        solc_ast_t *stmt_ast,
                                        solc_ast_t *attribute_list_ast)
 {
-  ast_while_t *out_while_stmt = malloc(sizeof(ast_while_t));
+  ast_while_t *out_while_stmt =
+    SOLC_AST_ALLOC(sizeof(ast_while_t), SOLC_AST_TYPE_STMT_WHILE);
   SOLC_AST_INIT_HEADER(out_while_stmt, pos, SOLC_AST_TYPE_STMT_WHILE);
   out_while_stmt->attribute_list_ast = attribute_list_ast;
   out_while_stmt->condition_expr_ast = condition_expr_ast;
@@ -32,7 +33,7 @@ void solc_ast_stmt_while_destroy(solc_ast_t *while_ast)
   solc_ast_destroy_if_exists(while_data->attribute_list_ast);
   solc_ast_destroy_if_exists(while_data->condition_expr_ast);
   solc_ast_destroy_if_exists(while_data->stmt_ast);
-  free(while_data);
+  SOLC_AST_FREE(while_data);
 }
 
 string_t *solc_ast_stmt_while_build_tree(solc_ast_t *while_ast)
@@ -41,7 +42,7 @@ string_t *solc_ast_stmt_while_build_tree(solc_ast_t *while_ast)
               while_ast->type == SOLC_AST_TYPE_STMT_WHILE);
   SOLC_AST_CAST(while_data, while_ast, ast_while_t);
   string_t header = string_create_from("STMT_WHILE");
-  string_t **children_vs_v = vector_reserve(string_t *, 3);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(3);
   solc_ast_add_to_tree_if_exists(children_vs_v, while_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, while_data->condition_expr_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, while_data->stmt_ast);
@@ -12,7 +12,8 @@ typedef struct {
 solc_ast_t *solc_ast_type_array_create(sz pos, solc_ast_t *size_expr_ast,
                                        solc_ast_t *type_ast)
 {
-  ast_type_array_t *out_array_type = malloc(sizeof(ast_type_array_t));
+  ast_type_array_t *out_array_type =
+    SOLC_AST_ALLOC(sizeof(ast_type_array_t), SOLC_AST_TYPE_TYPE_ARRAY);
   SOLC_AST_INIT_HEADER(out_array_type, pos, SOLC_AST_TYPE_TYPE_ARRAY);
   out_array_type->size_expr_ast = size_expr_ast;
   out_array_type->type_ast = type_ast;
@@ -26,7 +27,7 @@ void solc_ast_type_array_destroy(solc_ast_t *array_type_ast)
   SOLC_AST_CAST(array_type_data, array_type_ast, ast_type_array_t);
   solc_ast_destroy_if_exists(array_type_data->size_expr_ast);
   solc_ast_destroy_if_exists(array_type_data->type_ast);
-  free(array_type_ast);
+  SOLC_AST_FREE(array_type_ast);
 }
 
 string_t *solc_ast_type_array_build_tree(solc_ast_t *array_type_ast)
@@ -34,7 +35,7 @@ string_t *solc_ast_type_array_build_tree(solc_ast_t *array_type_ast)
   SOLC_ASSUME(array_type_ast != nullptr &&
               array_type_ast->type == SOLC_AST_TYPE_TYPE_ARRAY);
   SOLC_AST_CAST(array_type_data, array_type_ast, ast_type_array_t);
-  string_t **children_vs_v = vector_create(string_t *);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_CREATE();
   solc_ast_add_to_tree_if_exists(children_vs_v, array_type_data->type_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, array_type_data->size_expr_ast);
 
@@ -16,7 +16,8 @@ solc_ast_t *solc_ast_type_plain_create(sz pos, const char *name)
   SOLC_ASSUME(name != nullptr);
   const sz name_len = strlen(name) + 1;
   ast_plain_type_t *out_plain_type =
-    malloc(sizeof(ast_plain_type_t) + name_len);
+    SOLC_AST_ALLOC(sizeof(ast_plain_type_t) + name_len,
+                   SOLC_AST_TYPE_TYPE_PLAIN);
   SOLC_AST_INIT_HEADER(out_plain_type, pos, SOLC_AST_TYPE_TYPE_PLAIN);
   out_plain_type->name = (char *)out_plain_type + sizeof(ast_plain_type_t);
   memcpy(out_plain_type->name, name, name_len);
@@ -27,7 +28,7 @@ void solc_ast_type_plain_destroy(solc_ast_t *plain_type_ast)
 {
   SOLC_ASSUME(plain_type_ast != nullptr &&
               plain_type_ast->type == SOLC_AST_TYPE_TYPE_PLAIN);
-  free(plain_type_ast);
+  SOLC_AST_FREE(plain_type_ast);
 }
 
 string_t *solc_ast_type_plain_build_tree(solc_ast_t *plain_type_ast)
@@ -37,14 +38,12 @@ string_t *solc_ast_type_plain_build_tree(solc_ast_t *plain_type_ast)
   SOLC_AST_CAST(plain_type_data, plain_type_ast, ast_plain_type_t);
   SOLC_ASSUME(plain_type_data->name != nullptr);
 
-  const sz name_len = strlen(plain_type_data->name);
-  char *buf = malloc(sizeof(char) * (128 + name_len));
-  snprintf(buf, 128 + name_len, "TYPE_PLAIN { name: \"%s\" }",
-           plain_type_data->name);
+  string_t header = string_create();
+  string_append_fmt(&header, "TYPE_PLAIN { name: \"%s\" }",
+                    plain_type_data->name);
 
   string_t *out_v = vector_reserve(string_t, 1);
-  vector_push(out_v, string_create_from(buf));
-  free(buf);
+  vector_push(out_v, header);
 
   return out_v;
 }
@@ -11,7 +11,8 @@ typedef struct {
 
 solc_ast_t *solc_ast_type_pointer_create(sz pos, solc_ast_t *type_ast)
 {
-  ast_pointer_type_t *out_pointer_type = malloc(sizeof(ast_pointer_type_t));
+  ast_pointer_type_t *out_pointer_type =
+    SOLC_AST_ALLOC(sizeof(ast_pointer_type_t), SOLC_AST_TYPE_TYPE_POINTER);
   SOLC_AST_INIT_HEADER(out_pointer_type, pos, SOLC_AST_TYPE_TYPE_POINTER);
   out_pointer_type->type_ast = type_ast;
   return SOLC_AST(out_pointer_type);
@@ -23,7 +24,7 @@ void solc_ast_type_pointer_destroy(solc_ast_t *pointer_type_ast)
               pointer_type_ast->type == SOLC_AST_TYPE_TYPE_POINTER);
   SOLC_AST_CAST(pointer_type_data, pointer_type_ast, ast_pointer_type_t);
   solc_ast_destroy_if_exists(pointer_type_data->type_ast);
-  free(pointer_type_data);
+  SOLC_AST_FREE(pointer_type_data);
 }
 
 string_t *solc_ast_type_pointer_build_tree(solc_ast_t *pointer_type_ast)
@@ -31,7 +32,7 @@ string_t *solc_ast_type_pointer_build_tree(solc_ast_t *pointer_type_ast)
   SOLC_ASSUME(pointer_type_ast != nullptr &&
               pointer_type_ast->type == SOLC_AST_TYPE_TYPE_POINTER);
   SOLC_AST_CAST(pointer_type_data, pointer_type_ast, ast_pointer_type_t);
-  string_t **children_vs_v = vector_create(string_t *);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_CREATE();
   solc_ast_add_to_tree_if_exists(children_vs_v, pointer_type_data->type_ast);
   string_t header = string_create_from("TYPE_POINTER");
   return ast_build_tree(&header, children_vs_v);
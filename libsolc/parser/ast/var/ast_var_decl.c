@@ -20,7 +20,8 @@ solc_ast_t *solc_ast_var_decl_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_vardecl_t *out_vardecl = malloc(sizeof(ast_vardecl_t) + name_len);
+  ast_vardecl_t *out_vardecl =
+    SOLC_AST_ALLOC(sizeof(ast_vardecl_t) + name_len, SOLC_AST_TYPE_VAR_DECL);
   SOLC_AST_INIT_HEADER(out_vardecl, pos, SOLC_AST_TYPE_VAR_DECL);
   out_vardecl->attribute_list_ast = attribute_list_ast;
   out_vardecl->type_ast = type_ast;
@@ -36,7 +37,7 @@ void solc_ast_var_decl_destroy(solc_ast_t *var_decl_ast)
   SOLC_AST_CAST(vardecl_data, var_decl_ast, ast_vardecl_t);
   solc_ast_destroy_if_exists(vardecl_data->attribute_list_ast);
   solc_ast_destroy_if_exists(vardecl_data->type_ast);
-  free(var_decl_ast);
+  SOLC_AST_FREE(var_decl_ast);
 }
 
 string_t *solc_ast_var_decl_build_tree(solc_ast_t *var_decl_ast)
@@ -49,7 +50,7 @@ string_t *solc_ast_var_decl_build_tree(solc_ast_t *var_decl_ast)
   string_append_cstr(&header, vardecl_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 2);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(2);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  vardecl_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, vardecl_data->type_ast);
@@ -20,7 +20,8 @@ solc_ast_t *solc_ast_var_def_create(sz pos, const char *name,
   SOLC_ASSUME(name != nullptr);
 
   const sz name_len = strlen(name) + 1;
-  ast_vardef_t *out_vardef = malloc(sizeof(ast_vardef_t) + name_len);
+  ast_vardef_t *out_vardef =
+    SOLC_AST_ALLOC(sizeof(ast_vardef_t) + name_len, SOLC_AST_TYPE_VAR_DEF);
   SOLC_AST_INIT_HEADER(out_vardef, pos, SOLC_AST_TYPE_VAR_DEF);
   out_vardef->attribute_list_ast = attribute_list_ast;
   out_vardef->type_ast = type_ast;
@@ -38,7 +39,7 @@ void solc_ast_var_def_destroy(solc_ast_t *var_def_ast)
   solc_ast_destroy_if_exists(vardef_data->attribute_list_ast);
   solc_ast_destroy_if_exists(vardef_data->type_ast);
   solc_ast_destroy_if_exists(vardef_data->expr_ast);
-  free(vardef_data);
+  SOLC_AST_FREE(vardef_data);
 }
 
 string_t *solc_ast_var_def_build_tree(solc_ast_t *var_def_ast)
@@ -52,7 +53,7 @@ string_t *solc_ast_var_def_build_tree(solc_ast_t *var_def_ast)
   string_append_cstr(&header, vardef_data->name);
   string_append_cstr(&header, "\" }");
 
-  string_t **children_vs_v = vector_reserve(string_t *, 3);
+  string_t **children_vs_v = SOLC_AST_CHILDREN_RESERVE(3);
   solc_ast_add_to_tree_if_exists(children_vs_v,
                                  vardef_data->attribute_list_ast);
   solc_ast_add_to_tree_if_exists(children_vs_v, vardef_data->type_ast);
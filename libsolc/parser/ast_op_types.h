@@ -15,6 +15,9 @@ typedef enum {
   __SOLC_CONCAT(EXPR_OPERATOR_TYPE_,                          \
                 __SOLC_CONCAT(group_name, __SOLC_CONCAT(_, type_name)))
 
+// Operators by group, with their id in the group, how they are printed and
+// their binding power as binary operators. Higher binds tighter, prefix
+// operators bind to their operand before any binary one.
 #define __EXPR_OPERATORS   \
   __EXPR_OPERATORS_BINARY  \
   __EXPR_OPERATORS_COMPARE \
@@ -22,53 +25,54 @@ typedef enum {
   __EXPR_OPERATORS_ASSIGN  \
   __EXPR_OPERATORS_PREFIX
 
-#define __EXPR_OPERATORS_BINARY            \
-  __EXPR_OPERATORS_X(ADD, BINARY, 0, "+")  \
-  __EXPR_OPERATORS_X(SUB, BINARY, 1, "-")  \
-  __EXPR_OPERATORS_X(MUL, BINARY, 2, "*")  \
-  __EXPR_OPERATORS_X(DIV, BINARY, 3, "/")  \
-  __EXPR_OPERATORS_X(MOD, BINARY, 4, "%")  \
-  __EXPR_OPERATORS_X(SHL, BINARY, 5, "<<") \
-  __EXPR_OPERATORS_X(SHR, BINARY, 6, ">>") \
-  __EXPR_OPERATORS_X(AND, BINARY, 7, "&")  \
-  __EXPR_OPERATORS_X(OR, BINARY, 8, "|")   \
-  __EXPR_OPERATORS_X(XOR, BINARY, 9, "^")
+#define __EXPR_OPERATORS_BINARY                \
+  __EXPR_OPERATORS_X(ADD, BINARY, 0, "+", 20)  \
+  __EXPR_OPERATORS_X(SUB, BINARY, 1, "-", 20)  \
+  __EXPR_OPERATORS_X(MUL, BINARY, 2, "*", 30)  \
+  __EXPR_OPERATORS_X(DIV, BINARY, 3, "/", 30)  \
+  __EXPR_OPERATORS_X(MOD, BINARY, 4, "%", 30)  \
+  __EXPR_OPERATORS_X(SHL, BINARY, 5, "<<", 40) \
+  __EXPR_OPERATORS_X(SHR, BINARY, 6, ">>", 40) \
+  __EXPR_OPERATORS_X(AND, BINARY, 7, "&", 50)  \
+  __EXPR_OPERATORS_X(OR, BINARY, 8, "|", 50)   \
+  __EXPR_OPERATORS_X(XOR, BINARY, 9, "^", 50)
 
-#define __EXPR_OPERATORS_COMPARE                \
-  __EXPR_OPERATORS_X(EQ, COMPARE, 0, "==")      \
-  __EXPR_OPERATORS_X(NOTEQ, COMPARE, 1, "!=")   \
-  __EXPR_OPERATORS_X(LTHAN, COMPARE, 2, "<")    \
-  __EXPR_OPERATORS_X(GTHAN, COMPARE, 3, ">")    \
-  __EXPR_OPERATORS_X(LTHANEQ, COMPARE, 4, "<=") \
-  __EXPR_OPERATORS_X(GTHANEQ, COMPARE, 5, ">=")
+#define __EXPR_OPERATORS_COMPARE                    \
+  __EXPR_OPERATORS_X(EQ, COMPARE, 0, "==", 70)      \
+  __EXPR_OPERATORS_X(NOTEQ, COMPARE, 1, "!=", 70)   \
+  __EXPR_OPERATORS_X(LTHAN, COMPARE, 2, "<", 70)    \
+  __EXPR_OPERATORS_X(GTHAN, COMPARE, 3, ">", 70)    \
+  __EXPR_OPERATORS_X(LTHANEQ, COMPARE, 4, "<=", 70) \
+  __EXPR_OPERATORS_X(GTHANEQ, COMPARE, 5, ">=", 70)
 
-#define __EXPR_OPERATORS_BOOLEAN            \
-  __EXPR_OPERATORS_X(AND, BOOLEAN, 0, "&&") \
-  __EXPR_OPERATORS_X(OR, BOOLEAN, 1, "||")
+#define __EXPR_OPERATORS_BOOLEAN                \
+  __EXPR_OPERATORS_X(AND, BOOLEAN, 0, "&&", 60) \
+  __EXPR_OPERATORS_X(OR, BOOLEAN, 1, "||", 60)
 
-#define __EXPR_OPERATORS_ASSIGN               \
-  __EXPR_OPERATORS_X(EQ, ASSIGN, 0, "=")      \
-  __EXPR_OPERATORS_X(ADDEQ, ASSIGN, 1, "+=")  \
-  __EXPR_OPERATORS_X(SUBEQ, ASSIGN, 2, "-=")  \
-  __EXPR_OPERATORS_X(MULEQ, ASSIGN, 3, "*=")  \
-  __EXPR_OPERATORS_X(DIVEQ, ASSIGN, 4, "/=")  \
-  __EXPR_OPERATORS_X(MODEQ, ASSIGN, 5, "%=")  \
-  __EXPR_OPERATORS_X(SHLEQ, ASSIGN, 6, "<<=") \
-  __EXPR_OPERATORS_X(SHREQ, ASSIGN, 7, ">>=") \
-  __EXPR_OPERATORS_X(ANDEQ, ASSIGN, 8, "&=")  \
-  __EXPR_OPERATORS_X(OREQ, ASSIGN, 9, "|=")   \
-  __EXPR_OPERATORS_X(XOREQ, ASSIGN, 10, "^=")
+#define __EXPR_OPERATORS_ASSIGN                   \
+  __EXPR_OPERATORS_X(EQ, ASSIGN, 0, "=", 10)      \
+  __EXPR_OPERATORS_X(ADDEQ, ASSIGN, 1, "+=", 10)  \
+  __EXPR_OPERATORS_X(SUBEQ, ASSIGN, 2, "-=", 10)  \
+  __EXPR_OPERATORS_X(MULEQ, ASSIGN, 3, "*=", 10)  \
+  __EXPR_OPERATORS_X(DIVEQ, ASSIGN, 4, "/=", 10)  \
+  __EXPR_OPERATORS_X(MODEQ, ASSIGN, 5, "%=", 10)  \
+  __EXPR_OPERATORS_X(SHLEQ, ASSIGN, 6, "<<=", 10) \
+  __EXPR_OPERATORS_X(SHREQ, ASSIGN, 7, ">>=", 10) \
+  __EXPR_OPERATORS_X(ANDEQ, ASSIGN, 8, "&=", 10)  \
+  __EXPR_OPERATORS_X(OREQ, ASSIGN, 9, "|=", 10)   \
+  __EXPR_OPERATORS_X(XOREQ, ASSIGN, 10, "^=", 10)
 
-#define __EXPR_OPERATORS_PREFIX             \
-  __EXPR_OPERATORS_X(NOT, PREFIX, 0, "!")   \
-  __EXPR_OPERATORS_X(BNOT, PREFIX, 1, "~")  \
-  __EXPR_OPERATORS_X(NEG, PREFIX, 2, "-")   \
-  __EXPR_OPERATORS_X(DEREF, PREFIX, 3, "*") \
-  __EXPR_OPERATORS_X(ADDRESS, PREFIX, 4, "&")
+#define __EXPR_OPERATORS_PREFIX                \
+  __EXPR_OPERATORS_X(NOT, PREFIX, 0, "!", 0)   \
+  __EXPR_OPERATORS_X(BNOT, PREFIX, 1, "~", 0)  \
+  __EXPR_OPERATORS_X(NEG, PREFIX, 2, "-", 0)   \
+  __EXPR_OPERATORS_X(DEREF, PREFIX, 3, "*", 0) \
+  __EXPR_OPERATORS_X(ADDRESS, PREFIX, 4, "&", 0)
 
 typedef enum {
-#define __EXPR_OPERATORS_X(type_name, group_name, id, display_val) \
-  __EXPR_OPERATOR_TYPE_FULL_NAME(type_name, group_name) =          \
+#define __EXPR_OPERATORS_X(type_name, group_name, id, display_val, \
+                           binding_power)                         \
+  __EXPR_OPERATOR_TYPE_FULL_NAME(type_name, group_name) =         \
     (((u8)(EXPR_OPERATOR_GROUP_##group_name) & 0xFF) << 8) | ((id) & 0xFF),
   __EXPR_OPERATORS
 #undef __EXPR_OPERATORS_X
@@ -1,8 +1,12 @@
 #ifndef __SOLC_AST_PRIVATE_H__
 #define __SOLC_AST_PRIVATE_H__
 
+#include "allocs/alloc_heap.h"
+#include "allocs/alloc_trace.h"
+#include "containers/small_vector.h"
 #include "containers/string.h"
 #include "containers/vector.h"
+#include "global.h"
 #include "parser/ast/ast_group_expr_operand.h"
 #include "parser/ast/ast_group_generic.h"
 #include "parser/ast/ast_group_initlist.h"
@@ -20,19 +24,61 @@
     (_ast_ptr)->header.type = (_type);              \
   }
 #define SOLC_AST_CAST(_name, _rawptr, _type) _type *_name = (_type *)(_rawptr)
+#ifdef SOLC_ALLOC_TRACE
+#define SOLC_AST_ALLOC(_size, _type) \
+  ast_alloc_traced((_size), (_type), __builtin_return_address(0))
+#else
+#define SOLC_AST_ALLOC(_size, _type) \
+  alloc_heap_malloc(SOLC_MEM_TAG_AST, (_size))
+#endif
+#define SOLC_AST_FREE(_ast_ptr) alloc_heap_free((_ast_ptr))
+
+#ifdef SOLC_ALLOC_TRACE
+// Attributes the node to the caller of its `*_create()' function.
+static inline void *ast_alloc_traced(sz size, solc_ast_type_t type, void *site)
+{
+  void *token = alloc_trace_enter(site, type);
+  void *out = alloc_heap_malloc(SOLC_MEM_TAG_AST, size);
+  alloc_trace_leave(&token);
+  return out;
+}
+#endif
 
 typedef string_t *(*solc_ast_build_tree_func_t)(solc_ast_t *ast);
 
 solc_ast_build_tree_func_t ast_get_build_tree_func(solc_ast_type_t ast_type);
 
+// `children_vs_v' has to be created with SOLC_AST_CHILDREN_CREATE() or
+// SOLC_AST_CHILDREN_RESERVE().
 string_t *ast_build_tree(string_t *heading, string_t **children_vs_v);
 
+#define SOLC_AST_CHILDREN_CREATE() \
+  vector_create_in_arena(string_t *, global_tree_arena_alloc())
+#define SOLC_AST_CHILDREN_RESERVE(_n) \
+  vector_reserve_in_arena(string_t *, (_n), global_tree_arena_alloc())
+
 #define solc_ast_destroy_if_exists(_ast) \
   {                                      \
     if SOLC_LIKELY ((_ast) != nullptr)   \
       solc_ast_destroy((_ast));          \
   }
 
+// Child lists of container nodes, one or two children need no allocation.
+#define SOLC_AST_INLINE_CHILDREN 2
+typedef small_vector_t(solc_ast_t *, SOLC_AST_INLINE_CHILDREN) ast_children_t;
+
+#define ast_children_push(_children, _ast) \
+  small_vector_push((_children), (_ast), SOLC_MEM_TAG_AST)
+
+// Destroys every child, then the list itself.
+static inline void ast_children_destroy(ast_children_t *children)
+{
+  solc_ast_t **child_asts = small_vector_data(children);
+  for (sz i = 0; i < children->length; i++)
+    solc_ast_destroy_if_exists(child_asts[i]);
+  small_vector_destroy(children);
+}
+
 #define solc_ast_add_to_tree_if_exists(_vec, _ast)                        \
   {                                                                       \
     if SOLC_LIKELY ((_ast) != nullptr)                                    \
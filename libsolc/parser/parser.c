@@ -1,6 +1,10 @@
 #include "solc/parser/parser.h"
+#include "allocs/alloc_heap.h"
+#include "allocs/mem_budget.h"
+#include "containers/hashtable.h"
 #include "containers/vector.h"
 #include "parser/ast/ast_group_none.h"
+#include "parser/parser_brackets.h"
 #include "parser/parser_context.h"
 #include "solc/defs.h"
 #include "parser/parser_private.h"
@@ -8,40 +12,65 @@
 #include "solc/parser/ast.h"
 #include <string.h>
 
+static solc_parser_t parser_create(solc_token_t *tokens, sz tokens_num,
+                                   sz *bracket_matches);
+static void parser_destroy_state(solc_parser_t *parser);
+
 solc_parser_t solc_parser_create(solc_token_t *tokens, sz tokens_num)
 {
-  return (solc_parser_t){
-    .tokens = tokens,
-    .errors_v = vector_create(solc_parser_error_t),
-    .pos = 0,
-    .tokens_num = tokens_num,
-    .errored = false,
-  };
+  return parser_create(tokens, tokens_num,
+                       parser_brackets_match(tokens, tokens_num));
 }
 
 void solc_parser_destroy(solc_parser_t *parser)
 {
   SOLC_ASSUME(parser != nullptr);
-  vector_destroy(parser->errors_v);
+  parser_destroy_state(parser);
+  alloc_heap_free(parser->bracket_matches);
   memset(parser, 0, sizeof(solc_parser_t));
 }
 
+solc_parser_t solc_parser_fork(const solc_parser_t *parser)
+{
+  SOLC_ASSUME(parser != nullptr);
+  return parser_create(parser->tokens, parser->tokens_num,
+                       parser->bracket_matches);
+}
+
+void solc_parser_destroy_fork(solc_parser_t *fork)
+{
+  SOLC_ASSUME(fork != nullptr);
+  parser_destroy_state(fork);
+  memset(fork, 0, sizeof(solc_parser_t));
+}
+
 solc_ast_t *solc_parser_parse(solc_parser_t *parser)
 {
   SOLC_ASSUME(parser != nullptr);
+  const char *previous_phase = mem_budget_enter_phase("parsing");
   solc_ast_t *root = solc_ast_root_create();
   while (parser->pos < parser->tokens_num) {
-    solc_ast_t *top = solc_parser_parse_top(parser);
-    if (parser->errored) {
-      parser->errored = false;
-      continue;
-    }
-    solc_ast_root_add_top_statement(root, top);
+    solc_ast_t *top;
+    if (solc_parser_parse_next_top(parser, &top))
+      solc_ast_root_add_top_statement(root, top);
   }
 
+  mem_budget_leave_phase(previous_phase);
   return root;
 }
 
+b8 solc_parser_parse_next_top(solc_parser_t *parser, solc_ast_t **out)
+{
+  SOLC_ASSUME(parser != nullptr && out != nullptr);
+  *out = solc_parser_parse_top(parser);
+  solc_parser_reset_speculations(parser);
+  if (parser->errored) {
+    parser->errored = false;
+    return false;
+  }
+  return true;
+}
+
 solc_parser_error_t *solc_parser_get_errors(solc_parser_t *parser,
                                             sz *errors_num)
 {
@@ -50,6 +79,38 @@ solc_parser_error_t *solc_parser_get_errors(solc_parser_t *parser,
   return parser->errors_v;
 }
 
+parser_checkpoint_t solc_parser_checkpoint(const solc_parser_t *parser)
+{
+  SOLC_ASSUME(parser != nullptr);
+  return (parser_checkpoint_t){
+    .pos = parser->pos,
+    .errors_num = vector_get_length(parser->errors_v),
+    .errored = parser->errored,
+  };
+}
+
+b8 solc_parser_failed_since(const solc_parser_t *parser,
+                            parser_checkpoint_t checkpoint)
+{
+  SOLC_ASSUME(parser != nullptr);
+  return vector_get_length(parser->errors_v) != checkpoint.errors_num;
+}
+
+void solc_parser_rollback(solc_parser_t *parser, parser_checkpoint_t checkpoint)
+{
+  SOLC_ASSUME(parser != nullptr);
+  SOLC_ASSERT(vector_get_length(parser->errors_v) >= checkpoint.errors_num);
+  vector_resize(parser->errors_v, checkpoint.errors_num);
+  parser->pos = checkpoint.pos;
+  parser->errored = checkpoint.errored;
+}
+
+sz solc_parser_matching_bracket(const solc_parser_t *parser, sz pos)
+{
+  SOLC_ASSUME(parser != nullptr && pos < parser->tokens_num);
+  return parser->bracket_matches[pos];
+}
+
 void solc_parser_skip_until(solc_parser_t *parser, solc_tokentype_t token_type)
 {
   while (parser->pos < parser->tokens_num) {
@@ -151,9 +212,9 @@ void solc_parser_add_error(solc_parser_t *parser, solc_parser_error_type_t type,
   solc_parser_advance_to_terminator(parser);
 }
 
-b8 solc_parser_is_qualifier(const char *str)
+b8 solc_parser_is_qualifier(const char *str, sz len)
 {
-  return parser_context_is_qualifier(str);
+  return parser_context_is_qualifier(str, len);
 }
 
 b8 solc_parser_is_operator_token(solc_tokentype_t type)
@@ -234,3 +295,28 @@ b8 solc_parser_is_operand_ast(solc_ast_type_t type)
   }
   }
 }
+
+static solc_parser_t parser_create(solc_token_t *tokens, sz tokens_num,
+                                   sz *bracket_matches)
+{
+  hashtable_t *speculations;
+  hashtable_create(speculations, sz, parser_speculation_t);
+
+  return (solc_parser_t){
+    .tokens = tokens,
+    .errors_v =
+      vector_create_tagged(solc_parser_error_t, SOLC_MEM_TAG_DIAGNOSTICS),
+    .speculations = speculations,
+    .bracket_matches = bracket_matches,
+    .pos = 0,
+    .tokens_num = tokens_num,
+    .errored = false,
+  };
+}
+
+static void parser_destroy_state(solc_parser_t *parser)
+{
+  vector_destroy(parser->errors_v);
+  solc_parser_reset_speculations(parser);
+  hashtable_destroy(parser->speculations);
+}
@@ -61,7 +61,8 @@ solc_ast_t *solc_parser_parse_func_arg(solc_parser_t *parser)
   }
 
   case SOLC_TOKENTYPE_ID: {
-    if (solc_parser_is_qualifier(parser->tokens[parser->pos].value)) {
+    if (solc_parser_is_qualifier(parser->tokens[parser->pos].value,
+                                 parser->tokens[parser->pos].len)) {
       sz qualifier_pos = parser->pos++;
       const char *qualifier_name = parser->tokens[parser->pos].value;
       solc_ast_t *arg = solc_parser_parse_func_arg(parser);
@@ -16,7 +16,7 @@ solc_ast_t *solc_parser_parse_decldef(solc_parser_t *parser,
                SOLC_TOKENTYPE_ID);
 
   solc_token_t cur = parser->tokens[parser->pos];
-  if (solc_parser_is_qualifier(cur.value)) {
+  if (solc_parser_is_qualifier(cur.value, cur.len)) {
     sz pos = parser->pos++;
     return solc_ast_qualifier_create(
       pos, cur.value, solc_parser_parse_decldef(parser, attribute_list_ast));
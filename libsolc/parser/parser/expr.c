@@ -14,26 +14,38 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Expressions are parsed by precedence climbing, straight from the tokens.
+// Problems with the operators are only reported once the whole expression is
+// read, so they follow the errors of its operands and the parser ends up after
+// the expression whether it is valid or not.
 typedef struct {
-  union {
-    solc_ast_t *ast;
-    struct {
-      sz operator_pos;
-      expr_operator_type_t operator_type;
-    };
-  };
-  b8 is_operator;
-} ast_op_union_t;
-
-static inline void get_binding_power(expr_operator_type_t operator, s32 *l_bp,
-                                     s32 *r_bp);
-
-static inline ast_op_union_t *parse_expr_data(solc_parser_t *parser);
-static inline b8 validate_expr_data(solc_parser_t *parser, sz start_pos,
-                                    ast_op_union_t *ast_op_unions_v,
-                                    b8 toplevel);
-static solc_ast_t *pratt_parse_expr(ast_op_union_t *ast_op_unions_v, sz *pos,
-                                    s32 min_bp);
+  solc_parser_t *parser;
+  sz start_pos;
+  b8 toplevel;
+  b8 failed;
+  // `SOLC_PARSER_ERROR_TYPE_UNK' when an operand failed, it reported itself.
+  solc_parser_error_type_t error_type;
+  sz error_pos;
+  // Position of the last binary operator read.
+  sz operator_pos;
+  b8 has_assign;
+  b8 has_second_assign;
+  sz second_assign_pos;
+} expr_parser_t;
+
+#define EXPR_ERROR_TYPE_NO_LAST_OPERAND \
+  SOLC_PARSER_ERROR_TYPE_EXPR_LAST_NODE_IS_NOT_AN_OPERAND
+
+static solc_ast_t *expr_parse_binary(expr_parser_t *expr, u8 min_binding_power);
+static solc_ast_t *expr_parse_prefixed_operand(expr_parser_t *expr);
+static b8 expr_peek_operator(solc_parser_t *parser,
+                             expr_operator_type_t *operator_type,
+                             sz *tokens_num);
+static void expr_skip_rest(solc_parser_t *parser);
+static inline void expr_fail(expr_parser_t *expr,
+                             solc_parser_error_type_t error_type, sz pos);
+static inline u8 expr_binding_power(expr_operator_type_t operator_type);
+static inline b8 expr_is_operand_token(solc_tokentype_t type);
 static expr_operator_type_t
 token_to_expr_operator(expr_operator_group_t operator_group,
                        solc_tokentype_t type);
@@ -56,408 +68,301 @@ solc_ast_t *solc_parser_parse_stmt_expr(solc_parser_t *parser)
 solc_ast_t *solc_parser_parse_expr(solc_parser_t *parser, b8 toplevel)
 {
   VERIFY_POS(parser, parser->pos);
-  sz start_pos = parser->pos;
-  ast_op_union_t *ast_op_unions_v = parse_expr_data(parser);
-  solc_ast_t *out = nullptr;
-  out = !validate_expr_data(parser, start_pos, ast_op_unions_v, toplevel) ?
-          nullptr :
-          pratt_parse_expr(ast_op_unions_v, nullptr, 0);
-
-  if (out == nullptr)
-    for (sz i = 0, ast_op_unions_v_size = vector_get_length(ast_op_unions_v);
-         i < ast_op_unions_v_size; i++)
-      if (!ast_op_unions_v[i].is_operator)
-        solc_ast_destroy(ast_op_unions_v[i].ast);
-  vector_destroy(ast_op_unions_v);
-
+  expr_parser_t expr = {
+    .parser = parser,
+    .start_pos = parser->pos,
+    .toplevel = toplevel,
+  };
+  solc_ast_t *out = expr_parse_binary(&expr, 0);
+  if (expr.failed)
+    expr_skip_rest(parser);
+
+  // Both are found at the very end, a second assignment is reported first.
+  if SOLC_UNLIKELY (expr.has_second_assign &&
+                    (!expr.failed ||
+                     expr.error_type == EXPR_ERROR_TYPE_NO_LAST_OPERAND))
+    expr_fail(&expr, SOLC_PARSER_ERROR_TYPE_EXPR_2_ASSIGN_OPERATORS,
+              expr.second_assign_pos);
+
+  if SOLC_UNLIKELY (expr.failed) {
+    if (out != nullptr)
+      solc_ast_destroy(out);
+    if (expr.error_type != SOLC_PARSER_ERROR_TYPE_UNK)
+      solc_parser_add_error(parser, expr.error_type, expr.error_pos, 1,
+                            SOLC_TOKENTYPE_ERR);
+    return nullptr;
+  }
   return out;
 }
 
-static inline ast_op_union_t *parse_expr_data(solc_parser_t *parser)
+static solc_ast_t *expr_parse_binary(expr_parser_t *expr, u8 min_binding_power)
 {
-  ast_op_union_t *out_ast_op_unions_v = vector_create(ast_op_union_t);
+  solc_parser_t *parser = expr->parser;
+  solc_ast_t *lhs = expr_parse_prefixed_operand(expr);
+  if (lhs == nullptr)
+    return nullptr;
 
-  typedef struct {
-    union {
-      solc_ast_type_t ast_type;
-      expr_operator_type_t operator_type;
-    };
-    b8 is_operator;
-  } ast_type_op_union_t;
+  expr_operator_type_t operator_type;
+  sz operator_tokens_num;
+  while (expr_peek_operator(parser, &operator_type, &operator_tokens_num)) {
+    const u8 binding_power = expr_binding_power(operator_type);
+    if (binding_power < min_binding_power)
+      break;
 
-  ast_type_op_union_t prev = {
-    .ast_type = SOLC_AST_TYPE_NONE_ERR,
-    .is_operator = false,
-  };
-  while (parser->pos < parser->tokens_num) {
-    solc_token_t cur_tok = parser->tokens[parser->pos];
-
-    // Prefix operators
-    if ((prev.is_operator || prev.ast_type == SOLC_AST_TYPE_NONE_ERR) &&
-        solc_parser_is_prefix_operator_token(cur_tok.type)) {
-      ast_op_union_t out_op = {
-        .operator_pos = parser->pos,
-        .operator_type =
-          token_to_expr_operator(EXPR_OPERATOR_GROUP_PREFIX, cur_tok.type),
-        .is_operator = true,
-      };
-      vector_push(out_ast_op_unions_v, out_op);
-      parser->pos++;
+    expr->operator_pos = parser->pos;
+    parser->pos += operator_tokens_num;
+    if (expr_operator_type_get_group(operator_type) ==
+        EXPR_OPERATOR_GROUP_ASSIGN) {
+      if SOLC_UNLIKELY (!expr->toplevel) {
+        // TODO: use proper operator length, it can be 1, 2, or 3
+        // (depending on an operator).
+        expr_fail(expr,
+                  SOLC_PARSER_ERROR_TYPE_EXPR_ASSIGN_OPERATOR_IN_NON_TOPLEVEL,
+                  expr->operator_pos);
+        solc_ast_destroy(lhs);
+        return nullptr;
+      }
+      if SOLC_UNLIKELY (expr->has_assign && !expr->has_second_assign) {
+        expr->has_second_assign = true;
+        expr->second_assign_pos = expr->operator_pos;
+      }
+      expr->has_assign = true;
+    }
 
-      prev.is_operator = true;
-      prev.operator_type = out_op.operator_type;
-      continue;
+    // Every binary operator is left associative.
+    solc_ast_t *rhs = expr_parse_binary(expr, binding_power + 1);
+    if (rhs == nullptr) {
+      solc_ast_destroy(lhs);
+      return nullptr;
     }
+    lhs = solc_ast_expr_create(lhs->token_pos, lhs, rhs, operator_type);
+  }
 
-    // Operators
-    else if (!prev.is_operator && prev.ast_type != SOLC_AST_TYPE_NONE_ERR) {
-      if (!cur_tok.has_whitespace_after) {
-        // == != >= <=
-        // += -= *= /= %= &= |= ^=
-        if (solc_parser_peek(parser, parser->pos + 1) == SOLC_TOKENTYPE_EQ) {
-          switch (cur_tok.type) {
-          // Compare operators (except < and >)
-          case SOLC_TOKENTYPE_EXCLMARK: { // !=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_COMPARE_NOTEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_EQ: { // ==
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_COMPARE_EQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_RARROW: { // >=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_COMPARE_GTHANEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_LARROW: { // <=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_COMPARE_LTHANEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-
-          // Assign operators (except =, >>= and <<=)
-          case SOLC_TOKENTYPE_PLUS: { // +=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_ADDEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_MINUS: { // -=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_SUBEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_ASTERISK: { // *=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_MULEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_SLASH: { // /=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_DIVEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_PERCENT: { // %=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_MODEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_AMPERSAND: { // &=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_ANDEQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_PIPE: { // |=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_OREQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_CIRCUMFLEX: { // ^=
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_XOREQ,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-
-          default: // Neither of those
-            break;
-          }
-        }
+  return lhs;
+}
 
-        const solc_token_t *peeked_token =
-          solc_parser_peek_token(parser, parser->pos + 1);
-        if (peeked_token != nullptr && peeked_token->type == cur_tok.type) {
-          if (solc_parser_peek(parser, parser->pos + 2) == SOLC_TOKENTYPE_EQ &&
-              !peeked_token->has_whitespace_after) {
-            // >>= <<=
-            switch (cur_tok.type) {
-            case SOLC_TOKENTYPE_RARROW: { // >>=
-              ast_op_union_t out_op = {
-                .operator_pos = parser->pos,
-                .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_SHREQ,
-                .is_operator = true,
-              };
-              vector_push(out_ast_op_unions_v, out_op);
-              parser->pos += 3;
-              prev.is_operator = true;
-              prev.operator_type = out_op.operator_type;
-              continue;
-            }
-            case SOLC_TOKENTYPE_LARROW: { // <<=
-              ast_op_union_t out_op = {
-                .operator_pos = parser->pos,
-                .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_SHLEQ,
-                .is_operator = true,
-              };
-              vector_push(out_ast_op_unions_v, out_op);
-              parser->pos += 3;
-              prev.is_operator = true;
-              prev.operator_type = out_op.operator_type;
-              continue;
-            }
-
-            default:
-              break;
-            }
-          }
-
-          // && || << >>
-          switch (cur_tok.type) {
-          // Boolean operators (&&, ||)
-          case SOLC_TOKENTYPE_AMPERSAND: { // &&
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_BOOLEAN_AND,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_PIPE: { // ||
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_BOOLEAN_OR,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-
-          // Binary operators (<<, >>)
-          case SOLC_TOKENTYPE_LARROW: { // <<
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_BINARY_SHL,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-          case SOLC_TOKENTYPE_RARROW: { // >>
-            ast_op_union_t out_op = {
-              .operator_pos = parser->pos,
-              .operator_type = EXPR_OPERATOR_TYPE_BINARY_SHR,
-              .is_operator = true,
-            };
-            vector_push(out_ast_op_unions_v, out_op);
-            parser->pos += 2;
-            prev.is_operator = true;
-            prev.operator_type = out_op.operator_type;
-            continue;
-          }
-
-          default:
-            break;
-          }
-        }
-      }
+static solc_ast_t *expr_parse_prefixed_operand(expr_parser_t *expr)
+{
+  solc_parser_t *parser = expr->parser;
+  const sz prefix_pos = parser->pos;
+  while (parser->pos < parser->tokens_num &&
+         solc_parser_is_prefix_operator_token(parser->tokens[parser->pos].type))
+    parser->pos++;
+  const sz prefix_operators_num = parser->pos - prefix_pos;
+
+  if SOLC_UNLIKELY (parser->pos >= parser->tokens_num ||
+                    !expr_is_operand_token(parser->tokens[parser->pos].type)) {
+    if (prefix_operators_num > 0)
+      expr_fail(expr, SOLC_PARSER_ERROR_TYPE_EXPR_NO_OPERAND_AFTER_PREFIX,
+                parser->pos - 1);
+    else if (parser->pos == expr->start_pos)
+      expr_fail(expr, SOLC_PARSER_ERROR_TYPE_EXPR_EMPTY, expr->start_pos);
+    else
+      expr_fail(expr, EXPR_ERROR_TYPE_NO_LAST_OPERAND, expr->operator_pos);
+    return nullptr;
+  }
 
-      switch (cur_tok.type) {
-      // Remaining compare operators (< >)
-      case SOLC_TOKENTYPE_LARROW: { // <
-        ast_op_union_t out_op = {
-          .operator_pos = parser->pos,
-          .operator_type = EXPR_OPERATOR_TYPE_COMPARE_LTHAN,
-          .is_operator = true,
-        };
-        vector_push(out_ast_op_unions_v, out_op);
-        parser->pos++;
-        prev.is_operator = true;
-        prev.operator_type = out_op.operator_type;
-        continue;
-      }
-      case SOLC_TOKENTYPE_RARROW: { // >
-        ast_op_union_t out_op = {
-          .operator_pos = parser->pos,
-          .operator_type = EXPR_OPERATOR_TYPE_COMPARE_GTHAN,
-          .is_operator = true,
-        };
-        vector_push(out_ast_op_unions_v, out_op);
-        parser->pos++;
-        prev.is_operator = true;
-        prev.operator_type = out_op.operator_type;
-        continue;
+  solc_ast_t *operand = solc_parser_parse_expr_operand(parser);
+  if SOLC_UNLIKELY (operand == nullptr) {
+    expr_fail(expr, SOLC_PARSER_ERROR_TYPE_UNK, parser->pos);
+    return nullptr;
+  }
+  if (prefix_operators_num == 0)
+    return operand;
+
+  // Prefix operators are stored in reverse order
+  expr_operator_type_t *prefix_operators_v =
+    vector_reserve(expr_operator_type_t, prefix_operators_num);
+  for (sz i = prefix_operators_num; i > 0; i--)
+    vector_push(prefix_operators_v,
+                token_to_expr_operator(
+                  EXPR_OPERATOR_GROUP_PREFIX,
+                  parser->tokens[prefix_pos + i - 1].type));
+  return solc_ast_prefix_expr_create(prefix_pos, operand, prefix_operators_v);
+}
+
+static b8 expr_peek_operator(solc_parser_t *parser,
+                             expr_operator_type_t *operator_type,
+                             sz *tokens_num)
+{
+  if (parser->pos >= parser->tokens_num)
+    return false;
+
+  // Operators of several tokens have no whitespace between them.
+  const solc_token_t *cur = &parser->tokens[parser->pos];
+  if (!cur->has_whitespace_after) {
+    // == != >= <=
+    // += -= *= /= %= &= |= ^=
+    if (solc_parser_peek(parser, parser->pos + 1) == SOLC_TOKENTYPE_EQ) {
+      *tokens_num = 2;
+      switch (cur->type) {
+      case SOLC_TOKENTYPE_EXCLMARK:
+        *operator_type = EXPR_OPERATOR_TYPE_COMPARE_NOTEQ;
+        return true;
+      case SOLC_TOKENTYPE_EQ:
+        *operator_type = EXPR_OPERATOR_TYPE_COMPARE_EQ;
+        return true;
+      case SOLC_TOKENTYPE_RARROW:
+        *operator_type = EXPR_OPERATOR_TYPE_COMPARE_GTHANEQ;
+        return true;
+      case SOLC_TOKENTYPE_LARROW:
+        *operator_type = EXPR_OPERATOR_TYPE_COMPARE_LTHANEQ;
+        return true;
+      case SOLC_TOKENTYPE_PLUS:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_ADDEQ;
+        return true;
+      case SOLC_TOKENTYPE_MINUS:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_SUBEQ;
+        return true;
+      case SOLC_TOKENTYPE_ASTERISK:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_MULEQ;
+        return true;
+      case SOLC_TOKENTYPE_SLASH:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_DIVEQ;
+        return true;
+      case SOLC_TOKENTYPE_PERCENT:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_MODEQ;
+        return true;
+      case SOLC_TOKENTYPE_AMPERSAND:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_ANDEQ;
+        return true;
+      case SOLC_TOKENTYPE_PIPE:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_OREQ;
+        return true;
+      case SOLC_TOKENTYPE_CIRCUMFLEX:
+        *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_XOREQ;
+        return true;
+
+      default: // Neither of those
+        break;
       }
+    }
 
-      // =
-      case SOLC_TOKENTYPE_EQ: {
-        ast_op_union_t out_op = {
-          .operator_pos = parser->pos,
-          .operator_type = EXPR_OPERATOR_TYPE_ASSIGN_EQ,
-          .is_operator = true,
-        };
-        vector_push(out_ast_op_unions_v, out_op);
-        parser->pos++;
-        prev.is_operator = true;
-        prev.operator_type = out_op.operator_type;
-        continue;
+    const solc_token_t *next = solc_parser_peek_token(parser, parser->pos + 1);
+    if (next != nullptr && next->type == cur->type) {
+      // >>= <<=
+      if (!next->has_whitespace_after &&
+          solc_parser_peek(parser, parser->pos + 2) == SOLC_TOKENTYPE_EQ) {
+        *tokens_num = 3;
+        switch (cur->type) {
+        case SOLC_TOKENTYPE_RARROW:
+          *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_SHREQ;
+          return true;
+        case SOLC_TOKENTYPE_LARROW:
+          *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_SHLEQ;
+          return true;
+
+        default:
+          break;
+        }
       }
 
+      // && || << >>
+      *tokens_num = 2;
+      switch (cur->type) {
+      case SOLC_TOKENTYPE_AMPERSAND:
+        *operator_type = EXPR_OPERATOR_TYPE_BOOLEAN_AND;
+        return true;
+      case SOLC_TOKENTYPE_PIPE:
+        *operator_type = EXPR_OPERATOR_TYPE_BOOLEAN_OR;
+        return true;
+      case SOLC_TOKENTYPE_LARROW:
+        *operator_type = EXPR_OPERATOR_TYPE_BINARY_SHL;
+        return true;
+      case SOLC_TOKENTYPE_RARROW:
+        *operator_type = EXPR_OPERATOR_TYPE_BINARY_SHR;
+        return true;
+
       default:
         break;
       }
+    }
+  }
 
-      // Remaining binary operators
-      if (solc_parser_is_binary_operator_token(cur_tok.type)) {
-        ast_op_union_t out_op = {
-          .operator_pos = parser->pos,
-          .operator_type =
-            token_to_expr_operator(EXPR_OPERATOR_GROUP_BINARY, cur_tok.type),
-          .is_operator = true,
-        };
-        vector_push(out_ast_op_unions_v, out_op);
-        parser->pos++;
-        prev.is_operator = true;
-        prev.operator_type = out_op.operator_type;
-        continue;
-      }
+  *tokens_num = 1;
+  switch (cur->type) {
+  case SOLC_TOKENTYPE_LARROW:
+    *operator_type = EXPR_OPERATOR_TYPE_COMPARE_LTHAN;
+    return true;
+  case SOLC_TOKENTYPE_RARROW:
+    *operator_type = EXPR_OPERATOR_TYPE_COMPARE_GTHAN;
+    return true;
+  case SOLC_TOKENTYPE_EQ:
+    *operator_type = EXPR_OPERATOR_TYPE_ASSIGN_EQ;
+    return true;
+
+  default:
+    if (!solc_parser_is_binary_operator_token(cur->type))
+      return false;
+    *operator_type =
+      token_to_expr_operator(EXPR_OPERATOR_GROUP_BINARY, cur->type);
+    return true;
+  }
+}
+
+// Reads the rest of an expression that failed as far as a valid one would go,
+// which is wherever an operand is not followed by an operator.
+static void expr_skip_rest(solc_parser_t *parser)
+{
+  b8 after_operand = false;
+  while (parser->pos < parser->tokens_num) {
+    if (after_operand) {
+      expr_operator_type_t operator_type;
+      sz operator_tokens_num;
+      if (!expr_peek_operator(parser, &operator_type, &operator_tokens_num))
+        return;
+      parser->pos += operator_tokens_num;
+      after_operand = false;
+      continue;
     }
 
-    else if (prev.is_operator || prev.ast_type == SOLC_AST_TYPE_NONE_ERR) {
-      switch (cur_tok.type) {
-      default:
-        if (!solc_parser_is_numeric_token(cur_tok.type))
-          break;
-        // Numeric token
-
-        /* fallthrough */
-
-      case SOLC_TOKENTYPE_ID: // Identifier
-      case SOLC_TOKENTYPE_LPAREN: // Nested expression
-      case SOLC_TOKENTYPE_STRING: // String
-      case SOLC_TOKENTYPE_SYMBOL: // Symbol
-      {
-        ast_op_union_t out_operand = {
-          .ast = solc_parser_parse_expr_operand(parser),
-          .is_operator = false,
-        };
-        vector_push(out_ast_op_unions_v, out_operand);
-        prev.is_operator = false;
-        prev.ast_type = out_operand.ast != nullptr ? out_operand.ast->type :
-                                                     SOLC_AST_TYPE_NONE_ERR;
-        continue;
-      }
-      }
+    solc_tokentype_t type = parser->tokens[parser->pos].type;
+    if (solc_parser_is_prefix_operator_token(type)) {
+      parser->pos++;
+      continue;
     }
+    if (!expr_is_operand_token(type))
+      return;
 
-    break;
+    solc_ast_t *operand = solc_parser_parse_expr_operand(parser);
+    after_operand = operand != nullptr;
+    if (operand != nullptr)
+      solc_ast_destroy(operand);
   }
+}
+
+static inline void expr_fail(expr_parser_t *expr,
+                             solc_parser_error_type_t error_type, sz pos)
+{
+  expr->failed = true;
+  expr->error_type = error_type;
+  expr->error_pos = pos;
+}
+
+static inline u8 expr_binding_power(expr_operator_type_t operator_type)
+{
+  static const u8 binding_powers[EXPR_OPERATOR_GROUP_PREFIX + 1][0x10] = {
+#define __EXPR_OPERATORS_X(type_name, group_name, id, display_val, \
+                           binding_power)                         \
+  [EXPR_OPERATOR_GROUP_##group_name][id] = (binding_power),
+    __EXPR_OPERATORS
+#undef __EXPR_OPERATORS_X
+  };
+  return binding_powers[expr_operator_type_get_group(operator_type)]
+                       [operator_type & 0xFF];
+}
 
-  return out_ast_op_unions_v;
+static inline b8 expr_is_operand_token(solc_tokentype_t type)
+{
+  switch (type) {
+  case SOLC_TOKENTYPE_ID: // Identifier
+  case SOLC_TOKENTYPE_LPAREN: // Nested expression
+  case SOLC_TOKENTYPE_STRING: // String
+  case SOLC_TOKENTYPE_SYMBOL: // Symbol
+    return true;
+  default:
+    return solc_parser_is_numeric_token(type);
+  }
 }
 
 solc_ast_t *solc_parser_parse_expr_operand(solc_parser_t *parser)
@@ -587,7 +492,7 @@ solc_ast_t *solc_parser_parse_expr_operand(solc_parser_t *parser)
       parser->pos++;
     }
     out_operand =
-      solc_ast_expr_operand_string_create(string_pos, out_string.data);
+      solc_ast_expr_operand_string_create(string_pos, string_cstr(&out_string));
     string_destroy(&out_string);
     can_access_members = false;
     break;
@@ -862,171 +767,6 @@ expr_operand_generic_call_after_loop:
   return generic_call_operand;
 }
 
-static inline b8 validate_expr_data(solc_parser_t *parser, sz start_pos,
-                                    ast_op_union_t *ast_op_unions_v,
-                                    b8 toplevel)
-{
-  sz ast_op_unions_v_size = vector_get_length(ast_op_unions_v);
-  if SOLC_UNLIKELY (ast_op_unions_v_size == 0) {
-    solc_parser_add_error(parser, SOLC_PARSER_ERROR_TYPE_EXPR_EMPTY, start_pos,
-                          1, SOLC_TOKENTYPE_ERR);
-    return false;
-  }
-
-  ast_op_union_t *prev = nullptr, *cur = nullptr;
-  for (sz i = 0; i < ast_op_unions_v_size; i++, prev = cur) {
-    cur = &ast_op_unions_v[i];
-    sz cur_pos = cur->is_operator ? cur->operator_pos : cur->ast->token_pos;
-
-    if ((cur->is_operator && expr_operator_type_get_group(cur->operator_type) ==
-                               EXPR_OPERATOR_GROUP_PREFIX) &&
-        (prev == nullptr || prev->is_operator ||
-         prev->ast->type == SOLC_AST_TYPE_NONE_ERR)) {
-      if SOLC_UNLIKELY (i + 1 >= ast_op_unions_v_size) {
-        solc_parser_add_error(
-          parser, SOLC_PARSER_ERROR_TYPE_EXPR_NO_OPERAND_AFTER_PREFIX, cur_pos,
-          1, SOLC_TOKENTYPE_ERR);
-        return false;
-      }
-
-      ast_op_union_t *next = &ast_op_unions_v[i + 1];
-      if SOLC_LIKELY (!next->is_operator ||
-                      expr_operator_type_get_group(next->operator_type) ==
-                        EXPR_OPERATOR_GROUP_PREFIX)
-        continue;
-
-      solc_parser_add_error(parser,
-                            SOLC_PARSER_ERROR_TYPE_EXPR_PREFIX_AFTER_OPERAND,
-                            cur_pos, 1, SOLC_TOKENTYPE_ERR);
-      return false;
-    } else if (cur->is_operator) {
-      if SOLC_UNLIKELY (expr_operator_type_get_group(cur->operator_type) ==
-                          EXPR_OPERATOR_GROUP_ASSIGN &&
-                        !toplevel) {
-        // TODO: use proper operator length, it can be 1, 2, or 3
-        // (depending on an operator).
-        solc_parser_add_error(
-          parser, SOLC_PARSER_ERROR_TYPE_EXPR_ASSIGN_OPERATOR_IN_NON_TOPLEVEL,
-          cur_pos, 1, SOLC_TOKENTYPE_ERR);
-        return false;
-      } else if SOLC_UNLIKELY (prev == nullptr) {
-        solc_parser_add_error(
-          parser,
-          SOLC_PARSER_ERROR_TYPE_EXPR_NON_PREFIX_OPERATOR_AT_THE_BEGINNING,
-          cur_pos, 1, SOLC_TOKENTYPE_ERR);
-        return false;
-      } else if SOLC_UNLIKELY (prev->is_operator) {
-        solc_parser_add_error(
-          parser, SOLC_PARSER_ERROR_TYPE_EXPR_2_NON_PREFIX_OPERATORS, cur_pos,
-          1, SOLC_TOKENTYPE_ERR);
-        return false;
-      }
-      continue;
-    } else if SOLC_UNLIKELY (!cur->is_operator && prev != nullptr &&
-                             !prev->is_operator) {
-      solc_parser_add_error(parser, SOLC_PARSER_ERROR_TYPE_EXPR_2_OPERANDS,
-                            cur_pos, 1, SOLC_TOKENTYPE_ERR);
-      return false;
-    }
-  }
-
-  b8 has_assign_operator = false;
-  for (sz i = 0; i < ast_op_unions_v_size; i++) {
-    ast_op_union_t *ast_op_union = &ast_op_unions_v[i];
-    if (ast_op_union->is_operator &&
-        expr_operator_type_get_group(ast_op_union->operator_type) ==
-          EXPR_OPERATOR_GROUP_ASSIGN) {
-      if SOLC_UNLIKELY (has_assign_operator) {
-        solc_parser_add_error(parser,
-                              SOLC_PARSER_ERROR_TYPE_EXPR_2_ASSIGN_OPERATORS,
-                              ast_op_union->operator_pos, 1,
-                              SOLC_TOKENTYPE_ERR);
-        return false;
-      }
-      has_assign_operator = true;
-    }
-  }
-
-  if SOLC_UNLIKELY (ast_op_unions_v[ast_op_unions_v_size - 1].is_operator) {
-    solc_parser_add_error(
-      parser, SOLC_PARSER_ERROR_TYPE_EXPR_LAST_NODE_IS_NOT_AN_OPERAND,
-      ast_op_unions_v[ast_op_unions_v_size - 1].operator_pos, 1,
-      SOLC_TOKENTYPE_ERR);
-    return false;
-  }
-
-  return true;
-}
-
-static solc_ast_t *pratt_parse_expr(ast_op_union_t *ast_op_unions_v, sz *pos,
-                                    s32 min_bp)
-{
-  sz ast_op_unions_v_size = vector_get_length(ast_op_unions_v);
-
-  b8 pos_was_null = false;
-  if SOLC_UNLIKELY (pos == nullptr) {
-    pos = calloc(1, sizeof(sz));
-    pos_was_null = true;
-  } else if (*pos >= ast_op_unions_v_size)
-    return nullptr;
-
-  solc_ast_t *lhs = nullptr;
-
-  // Handle prefix operators
-  if (ast_op_unions_v[*pos].is_operator &&
-      expr_operator_type_get_group(ast_op_unions_v[*pos].operator_type) ==
-        EXPR_OPERATOR_GROUP_PREFIX) {
-    ast_op_union_t *cur = &ast_op_unions_v[(*pos)++];
-    expr_operator_type_t *prefix_operators_v =
-      vector_create(expr_operator_type_t);
-
-    sz prefix_start = cur->operator_pos;
-
-    // Obtain all prefix operators
-    while (cur->is_operator &&
-           expr_operator_type_get_group(cur->operator_type) ==
-             EXPR_OPERATOR_GROUP_PREFIX &&
-           (*pos) < ast_op_unions_v_size) {
-      vector_push(prefix_operators_v, cur->operator_type);
-      cur = &ast_op_unions_v[(*pos)++];
-    }
-    solc_ast_t *operand = cur->ast; // Obtain operand
-
-    // Reverse prefix operators list
-    for (sz i = 0, j = vector_get_length(prefix_operators_v) - 1; i < j;
-         i++, j--) {
-      expr_operator_type_t tmp = prefix_operators_v[i];
-      prefix_operators_v[i] = prefix_operators_v[j];
-      prefix_operators_v[j] = tmp;
-    }
-
-    // Create LHS
-    lhs =
-      solc_ast_prefix_expr_create(prefix_start, operand, prefix_operators_v);
-  } else {
-    lhs = ast_op_unions_v[(*pos)++].ast;
-  }
-
-  while (*pos < ast_op_unions_v_size) {
-    expr_operator_type_t op = ast_op_unions_v[*pos].operator_type;
-
-    s32 l_bp, r_bp;
-    get_binding_power(op, &l_bp, &r_bp);
-    if (l_bp < min_bp)
-      break;
-
-    (*pos)++;
-    solc_ast_t *rhs = pratt_parse_expr(ast_op_unions_v, pos, r_bp);
-    solc_ast_t *new_lhs = solc_ast_expr_create(lhs->token_pos, lhs, rhs, op);
-    lhs = new_lhs;
-  }
-
-  if SOLC_UNLIKELY (pos_was_null)
-    free(pos);
-
-  return lhs;
-}
-
 static expr_operator_type_t
 token_to_expr_operator(expr_operator_group_t op_group, solc_tokentype_t type)
 {
@@ -1078,65 +818,6 @@ token_to_expr_operator(expr_operator_group_t op_group, solc_tokentype_t type)
   }
 }
 
-static inline void get_binding_power(expr_operator_type_t op, s32 *l_bp,
-                                     s32 *r_bp)
-{
-  switch (expr_operator_type_get_group(op)) {
-  case EXPR_OPERATOR_GROUP_ASSIGN:
-    *l_bp = 10;
-    *r_bp = 15;
-    return;
-
-  case EXPR_OPERATOR_GROUP_BOOLEAN:
-    *l_bp = 60;
-    *r_bp = 65;
-    return;
-
-  case EXPR_OPERATOR_GROUP_COMPARE:
-    *l_bp = 70;
-    *r_bp = 75;
-    return;
-
-  default:
-    break;
-  }
-
-  switch (op) {
-  case EXPR_OPERATOR_TYPE_BINARY_ADD:
-  case EXPR_OPERATOR_TYPE_BINARY_SUB: {
-    *l_bp = 20;
-    *r_bp = 25;
-    return;
-  }
-
-  case EXPR_OPERATOR_TYPE_BINARY_MUL:
-  case EXPR_OPERATOR_TYPE_BINARY_DIV:
-  case EXPR_OPERATOR_TYPE_BINARY_MOD: {
-    *l_bp = 30;
-    *r_bp = 35;
-    return;
-  }
-
-  case EXPR_OPERATOR_TYPE_BINARY_SHL:
-  case EXPR_OPERATOR_TYPE_BINARY_SHR: {
-    *l_bp = 40;
-    *r_bp = 45;
-    return;
-  }
-
-  case EXPR_OPERATOR_TYPE_BINARY_AND:
-  case EXPR_OPERATOR_TYPE_BINARY_OR:
-  case EXPR_OPERATOR_TYPE_BINARY_XOR: {
-    *l_bp = 50;
-    *r_bp = 55;
-    return;
-  }
-
-  default:
-    SOLC_NOREACH();
-  }
-}
-
 static inline u64 num_tok_to_u64(solc_token_t *token)
 {
   u64 out = 0;
@@ -1,4 +1,4 @@
-#include "containers/vector.h"
+#include "containers/hashtable.h"
 #include "parser/ast/ast_group_generic.h"
 #include "parser/parser_private.h"
 #include "solc/defs.h"
@@ -6,6 +6,10 @@
 #include "solc/parser/ast.h"
 #include "solc/parser/parser.h"
 
+static solc_ast_t *
+solc_parser_parse_generic_types(solc_parser_t *parser,
+                                solc_ast_t *generic_type_list);
+
 solc_ast_t *
 solc_parser_parse_generic_placeholder_type_list(solc_parser_t *parser)
 {
@@ -61,9 +65,34 @@ solc_ast_t *solc_parser_parse_generic_type_list(solc_parser_t *parser)
   VERIFY_TOKEN(parser, parser->pos, parser->tokens[parser->pos].type,
                SOLC_TOKENTYPE_LARROW);
 
+  // A list that was already parsed speculatively is handed over as it is.
+  const sz larrow_pos = parser->pos;
+  const parser_speculation_t *memoized =
+    hashtable_get(parser->speculations, larrow_pos);
+  if (memoized != nullptr && memoized->type_list != nullptr) {
+    parser_speculation_t taken = *memoized;
+    solc_ast_t *type_list = taken.type_list;
+    taken.type_list = nullptr;
+    hashtable_put(parser->speculations, larrow_pos, taken);
+    parser->pos = taken.end_pos;
+    return type_list;
+  }
+
+  // Speculation runs this on plain comparisons, so a list that fails to parse
+  // is not left behind.
   solc_ast_t *generic_type_list =
     solc_ast_generic_type_list_create(parser->pos++);
+  if (solc_parser_parse_generic_types(parser, generic_type_list) == nullptr) {
+    solc_ast_destroy(generic_type_list);
+    return nullptr;
+  }
+  return generic_type_list;
+}
 
+static solc_ast_t *
+solc_parser_parse_generic_types(solc_parser_t *parser,
+                                solc_ast_t *generic_type_list)
+{
   while (parser->pos < parser->tokens_num) {
     if (parser->tokens[parser->pos].type == SOLC_TOKENTYPE_RARROW)
       break;
@@ -101,45 +130,10 @@ b8 solc_parser_is_expr_operand_generic_call(solc_parser_t *parser)
       parser->pos + 2 >= parser->tokens_num)
     return false;
 
-  sz old_pos = parser->pos;
-  b8 maybe_generic = false;
-  b8 errored_prev = parser->errored;
-  sz old_errors_size = vector_get_length(parser->errors_v);
-  solc_parser_error_t *old_errors = vector_copy(parser->errors_v);
-
-  parser->pos += 2;
-  while (parser->pos < parser->tokens_num) {
-    if (parser->tokens[parser->pos].type == SOLC_TOKENTYPE_RARROW) {
-      maybe_generic = true;
-      parser->pos++;
-      break;
-    }
-
-    solc_ast_t *type_ast = solc_parser_parse_type(parser);
-    if (type_ast != nullptr)
-      solc_ast_destroy(type_ast);
-
-    if (vector_get_length(parser->errors_v) != old_errors_size)
-      break;
-
-    solc_tokentype_t next = solc_parser_peek(parser, parser->pos);
-    if (next != SOLC_TOKENTYPE_RARROW) {
-      if (next != SOLC_TOKENTYPE_COMMA)
-        break;
-
-      parser->pos++;
-    }
-  }
-
-  b8 result = maybe_generic &&
-              solc_parser_peek(parser, parser->pos) == SOLC_TOKENTYPE_LPAREN;
-
-  vector_destroy(parser->errors_v);
-  parser->errors_v = old_errors;
-  parser->errored = errored_prev;
-  parser->pos = old_pos;
-
-  return result;
+  const parser_speculation_t speculation =
+    solc_parser_speculate_generic_type_list(parser, parser->pos + 1);
+  return speculation.end_pos != 0 &&
+         solc_parser_peek(parser, speculation.end_pos) == SOLC_TOKENTYPE_LPAREN;
 }
 
 b8 solc_parser_is_generic_namespace(solc_parser_t *parser)
@@ -148,50 +142,56 @@ b8 solc_parser_is_generic_namespace(solc_parser_t *parser)
       parser->pos + 2 >= parser->tokens_num)
     return false;
 
-  sz old_pos = parser->pos;
-  b8 maybe_generic = false;
-  b8 errored_prev = parser->errored;
-  sz old_errors_size = vector_get_length(parser->errors_v);
-  solc_parser_error_t *old_errors = vector_copy(parser->errors_v);
-
-  parser->pos += 2;
-
-  while (parser->pos < parser->tokens_num) {
-    if (parser->tokens[parser->pos].type == SOLC_TOKENTYPE_RARROW) {
-      maybe_generic = true;
-      parser->pos++;
-      break;
-    }
-
-    solc_ast_t *type_ast = solc_parser_parse_type(parser);
-    if (type_ast != nullptr)
-      solc_ast_destroy(type_ast);
-
-    if (vector_get_length(parser->errors_v) != old_errors_size)
-      break;
+  const parser_speculation_t speculation =
+    solc_parser_speculate_generic_type_list(parser, parser->pos + 1);
+  if (speculation.end_pos == 0)
+    return false;
 
-    solc_tokentype_t next = solc_parser_peek(parser, parser->pos);
-    if (next != SOLC_TOKENTYPE_RARROW) {
-      if (next != SOLC_TOKENTYPE_COMMA)
-        break;
+  const sz end_pos = speculation.end_pos;
+  const solc_token_t *peeked = solc_parser_peek_token(parser, end_pos);
+  return peeked != nullptr && peeked->type == SOLC_TOKENTYPE_COLON &&
+         !peeked->has_whitespace_after &&
+         solc_parser_peek(parser, end_pos + 1) == SOLC_TOKENTYPE_COLON &&
+         solc_parser_peek(parser, end_pos + 2) == SOLC_TOKENTYPE_ID;
+}
 
-      parser->pos++;
+parser_speculation_t
+solc_parser_speculate_generic_type_list(solc_parser_t *parser, sz larrow_pos)
+{
+  const parser_speculation_t *memoized =
+    hashtable_get(parser->speculations, larrow_pos);
+  if (memoized != nullptr)
+    return *memoized;
+
+  // A generic type list needs a `>' that closes the `<' before the statement or
+  // a bracket around it ends. Most comparisons have none.
+  parser_speculation_t speculation = { .end_pos = 0, .type_list = nullptr };
+  if (solc_parser_matching_bracket(parser, larrow_pos) != 0) {
+    const parser_checkpoint_t checkpoint = solc_parser_checkpoint(parser);
+    parser->pos = larrow_pos;
+    solc_ast_t *type_list = solc_parser_parse_generic_type_list(parser);
+    if (type_list != nullptr && !solc_parser_failed_since(parser, checkpoint)) {
+      speculation.end_pos = parser->pos;
+      speculation.type_list = type_list;
+    } else if (type_list != nullptr) {
+      solc_ast_destroy(type_list);
     }
+    solc_parser_rollback(parser, checkpoint);
   }
 
-  const solc_token_t *peeked = solc_parser_peek_token(parser, parser->pos);
-  b8 result =
-    maybe_generic && peeked != nullptr &&
-    peeked->type == SOLC_TOKENTYPE_COLON && !peeked->has_whitespace_after &&
-    solc_parser_peek(parser, parser->pos + 1) == SOLC_TOKENTYPE_COLON &&
-    solc_parser_peek(parser, parser->pos + 2) == SOLC_TOKENTYPE_ID;
-
-  vector_destroy(parser->errors_v);
-  parser->errors_v = old_errors;
-  parser->errored = errored_prev;
-  parser->pos = old_pos;
+  hashtable_put(parser->speculations, larrow_pos, speculation);
+  return speculation;
+}
 
-  return result;
+void solc_parser_reset_speculations(solc_parser_t *parser)
+{
+  hashtable_cursor_t cursor = hashtable_cursor_create(parser->speculations);
+  while (hashtable_cursor_next(&cursor)) {
+    const parser_speculation_t *speculation = cursor.value;
+    if (speculation->type_list != nullptr)
+      solc_ast_destroy(speculation->type_list);
+  }
+  hashtable_clear(parser->speculations);
 }
 
 solc_ast_t *solc_parser_parse_generic_namespace(solc_parser_t *parser)
@@ -1,4 +1,3 @@
-#include "containers/vector.h"
 #include "parser/ast/ast_group_generic.h"
 #include "parser/ast/ast_group_none.h"
 #include "parser/ast/ast_group_stmt.h"
@@ -48,12 +47,13 @@ solc_ast_t *solc_parser_parse_stmt(solc_parser_t *parser)
   }
 
   case SOLC_TOKENTYPE_ID: {
+    const solc_token_t *cur = &parser->tokens[parser->pos];
     parser_stmt_func_t func =
-      parser_context_get_stmt_func(parser->tokens[parser->pos].value);
+      parser_context_get_stmt_func(cur->value, cur->len);
 
     if (func != nullptr) {
       return func(parser);
-    } else if (parser_context_is_qualifier(parser->tokens[parser->pos].value)) {
+    } else if (parser_context_is_qualifier(cur->value, cur->len)) {
       return solc_parser_parse_decldef(parser, nullptr);
     }
 
@@ -95,28 +95,22 @@ solc_ast_t *solc_parser_parse_stmt_expr_or_generic_func(solc_parser_t *parser)
 {
   if (parser->tokens[parser->pos].type == SOLC_TOKENTYPE_ID &&
       solc_parser_peek(parser, parser->pos + 1) == SOLC_TOKENTYPE_LARROW) {
-    sz old_pos = parser->pos;
-    b8 old_errored = parser->errored;
-    sz old_errors_v_len = vector_get_length(parser->errors_v);
-    solc_parser_error_t *old_errors_v = vector_copy(parser->errors_v);
+    const parser_checkpoint_t checkpoint = solc_parser_checkpoint(parser);
 
     // Try parse generic function definition
     solc_ast_t *out = solc_parser_parse_def_func_generic(
       parser, nullptr, SOLC_AST_FUNC_TYPE_DEFAULT);
 
-    if (old_errored == parser->errored ||
-        old_errors_v_len == vector_get_length(parser->errors_v)) {
+    if (!solc_parser_failed_since(parser, checkpoint)) {
       // Success
-      vector_destroy(old_errors_v);
       return out;
     }
 
     // Fail
-    // Reset parser to its previous state ...
-    vector_destroy(parser->errors_v);
-    parser->pos = old_pos;
-    parser->errored = old_errored;
-    parser->errors_v = vector_copy(old_errors_v);
+    // Reset parser to its previous state, dropping the new errors ...
+    if (out != nullptr)
+      solc_ast_destroy(out);
+    solc_parser_rollback(parser, checkpoint);
 
     // ... and parse expression statement.
   }
@@ -46,7 +46,8 @@ solc_ast_t *solc_parser_parse_struct(solc_parser_t *parser)
 
     if (parser->tokens[parser->pos].type == SOLC_TOKENTYPE_ID) {
       parser_struct_func_t struct_func =
-        parser_context_get_struct_func(parser->tokens[parser->pos].value);
+        parser_context_get_struct_func(parser->tokens[parser->pos].value,
+                                       parser->tokens[parser->pos].len);
       if (struct_func != nullptr) {
         child_ast = struct_func(parser);
         child_parsed = true;
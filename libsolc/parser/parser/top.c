@@ -16,7 +16,7 @@ solc_ast_t *solc_parser_parse_top(solc_parser_t *parser)
 
   case SOLC_TOKENTYPE_ID: {
     parser_toplevel_func_t toplevel_func =
-      parser_context_get_toplevel_func(cur.value);
+      parser_context_get_toplevel_func(cur.value, cur.len);
     if (toplevel_func != nullptr) {
       return toplevel_func(parser);
     } else if (solc_parser_peek(parser, parser->pos + 1) ==
@@ -35,7 +35,8 @@ solc_ast_t *solc_parser_parse_union(solc_parser_t *parser)
       break;
     else if (parser->tokens[parser->pos].type == SOLC_TOKENTYPE_ID) {
       parser_union_func_t union_func =
-        parser_context_get_union_func(parser->tokens[parser->pos].value);
+        parser_context_get_union_func(parser->tokens[parser->pos].value,
+                                      parser->tokens[parser->pos].len);
       if (union_func != nullptr) {
         child_ast = union_func(parser);
         parsed_child = true;
@@ -0,0 +1,141 @@
+#include "parser/parser_brackets.h"
+#include "allocs/alloc_heap.h"
+#include "solc/defs.h"
+#include "solc/lexer/token.h"
+#include "solc/mem_stats.h"
+#include <string.h>
+
+typedef struct {
+  const solc_token_t *tokens;
+  sz *matches;
+  // Positions of the opening tokens not closed yet, innermost last.
+  sz *stack;
+  sz stack_len;
+  sz larrows_num;
+} brackets_t;
+
+static inline solc_tokentype_t brackets_top_type(const brackets_t *brackets);
+static inline void brackets_pop_larrows(brackets_t *brackets);
+static void brackets_drop_larrows(brackets_t *brackets);
+static void brackets_close(brackets_t *brackets, sz pos,
+                           solc_tokentype_t opening_type);
+static void brackets_close_block(brackets_t *brackets, sz pos);
+
+sz *parser_brackets_match(const solc_token_t *tokens, sz tokens_num)
+{
+  SOLC_ASSUME(tokens != nullptr || tokens_num == 0);
+
+  const sz size = SOLC_MAX(tokens_num, (sz)1) * sizeof(sz);
+  brackets_t brackets = {
+    .tokens = tokens,
+    .matches = alloc_heap_malloc(SOLC_MEM_TAG_TOKENS, size),
+    .stack = alloc_heap_malloc(SOLC_MEM_TAG_TOKENS, size),
+  };
+  memset(brackets.matches, 0, size);
+
+  for (sz pos = 0; pos < tokens_num; pos++) {
+    switch (tokens[pos].type) {
+    case SOLC_TOKENTYPE_LARROW:
+      brackets.larrows_num++;
+      brackets.stack[brackets.stack_len++] = pos;
+      break;
+
+    case SOLC_TOKENTYPE_LCBRACK:
+      brackets_drop_larrows(&brackets);
+      brackets.stack[brackets.stack_len++] = pos;
+      break;
+
+    case SOLC_TOKENTYPE_LPAREN:
+    case SOLC_TOKENTYPE_LBRACK:
+      brackets.stack[brackets.stack_len++] = pos;
+      break;
+
+    case SOLC_TOKENTYPE_RARROW:
+      if (brackets_top_type(&brackets) == SOLC_TOKENTYPE_LARROW) {
+        brackets.matches[brackets.stack[--brackets.stack_len]] = pos;
+        brackets.larrows_num--;
+      }
+      break;
+
+    case SOLC_TOKENTYPE_RPAREN:
+      brackets_close(&brackets, pos, SOLC_TOKENTYPE_LPAREN);
+      break;
+
+    case SOLC_TOKENTYPE_RBRACK:
+      brackets_close(&brackets, pos, SOLC_TOKENTYPE_LBRACK);
+      break;
+
+    case SOLC_TOKENTYPE_RCBRACK:
+      brackets_close_block(&brackets, pos);
+      break;
+
+    case SOLC_TOKENTYPE_SEMI:
+      brackets_drop_larrows(&brackets);
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  alloc_heap_free(brackets.stack);
+  return brackets.matches;
+}
+
+static inline solc_tokentype_t brackets_top_type(const brackets_t *brackets)
+{
+  if (brackets->stack_len == 0)
+    return SOLC_TOKENTYPE_ERR;
+  return brackets->tokens[brackets->stack[brackets->stack_len - 1]].type;
+}
+
+static inline void brackets_pop_larrows(brackets_t *brackets)
+{
+  while (brackets_top_type(brackets) == SOLC_TOKENTYPE_LARROW) {
+    brackets->stack_len--;
+    brackets->larrows_num--;
+  }
+}
+
+// No `<' is closed across the end of a statement or a block, wherever it is
+// on the stack.
+static void brackets_drop_larrows(brackets_t *brackets)
+{
+  if SOLC_LIKELY (brackets->larrows_num == 0)
+    return;
+
+  sz stack_len = 0;
+  for (sz i = 0; i < brackets->stack_len; i++)
+    if (brackets->tokens[brackets->stack[i]].type != SOLC_TOKENTYPE_LARROW)
+      brackets->stack[stack_len++] = brackets->stack[i];
+  brackets->stack_len = stack_len;
+  brackets->larrows_num = 0;
+}
+
+static void brackets_close(brackets_t *brackets, sz pos,
+                           solc_tokentype_t opening_type)
+{
+  brackets_pop_larrows(brackets);
+  const solc_tokentype_t top_type = brackets_top_type(brackets);
+  if (top_type != SOLC_TOKENTYPE_LPAREN && top_type != SOLC_TOKENTYPE_LBRACK)
+    return;
+
+  const sz opening_pos = brackets->stack[--brackets->stack_len];
+  if (top_type == opening_type)
+    brackets->matches[opening_pos] = pos;
+}
+
+// Brackets left open inside the block stay unmatched, a `}' without a `{' is
+// skipped.
+static void brackets_close_block(brackets_t *brackets, sz pos)
+{
+  brackets_drop_larrows(brackets);
+  for (sz i = brackets->stack_len; i > 0; i--) {
+    const sz opening_pos = brackets->stack[i - 1];
+    if (brackets->tokens[opening_pos].type == SOLC_TOKENTYPE_LCBRACK) {
+      brackets->matches[opening_pos] = pos;
+      brackets->stack_len = i - 1;
+      return;
+    }
+  }
+}
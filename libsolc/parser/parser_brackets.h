@@ -0,0 +1,19 @@
+#ifndef __SOLC_PARSER_BRACKETS_H__
+#define __SOLC_PARSER_BRACKETS_H__
+
+#include "solc/defs.h"
+#include "solc/lexer/token.h"
+
+// Matches every `(', `[', `{' and `<' of the tokens with its closing token in
+// one pass. The result holds, per token, the position of the token closing it,
+// or 0 if it closes nothing or is no opening bracket. It is freed with
+// `alloc_heap_free()'.
+//
+// A closing bracket of the wrong kind still closes `(' and `[', so a stray
+// one does not shift every match after it. A `<' is only a candidate: it is
+// closed by a `>' at the same bracket depth before the bracket around it
+// closes or a `;', `{' or `}' comes, comparisons and shifts get their matches
+// as well.
+sz *parser_brackets_match(const solc_token_t *tokens, sz tokens_num);
+
+#endif // __SOLC_PARSER_BRACKETS_H__
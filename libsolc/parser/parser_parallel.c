@@ -0,0 +1,217 @@
+#include "solc/parser/parser.h"
+#include "allocs/mem_budget.h"
+#include "containers/vector.h"
+#include "parser/ast/ast_group_none.h"
+#include "parser/parser_private.h"
+#include "solc/defs.h"
+#include "solc/lexer/token.h"
+#include "solc/parser/ast.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Chunks of fewer tokens are not worth a thread, there are a few chunks per
+// thread so one slow chunk does not hold the others up.
+#define PARALLEL_MIN_CHUNK_TOKENS 4096
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+typedef struct {
+  // The top-level statements starting in [start, end).
+  sz start, end;
+  // Where parsing the chunk stopped, its statements are only the ones the
+  // sequential parse would see if that is `end'.
+  sz end_pos;
+  solc_ast_t **tops_v;
+  // The errors of the chunk are [errors_begin, errors_end) of `fork'.
+  const solc_parser_t *fork;
+  sz errors_begin, errors_end;
+} parallel_chunk_t;
+
+typedef struct {
+  parallel_chunk_t *chunks_v;
+  _Atomic sz next_chunk;
+} parallel_queue_t;
+
+typedef struct {
+  parallel_queue_t *queue;
+  solc_parser_t fork;
+} parallel_worker_t;
+
+static parallel_chunk_t *parallel_split(const solc_parser_t *parser,
+                                        sz chunk_tokens);
+static sz parallel_next_boundary(const solc_parser_t *parser, sz pos);
+static void *parallel_work(void *ctx);
+static void parallel_chunk_take(solc_parser_t *parser, solc_ast_t *root,
+                                parallel_chunk_t *chunk);
+static void parallel_chunk_drop(parallel_chunk_t *chunk);
+
+// Top-level statements are cut into chunks at the `;' or `}' that seem to end
+// them, every chunk is parsed by a fork of `parser' on some thread. The chunks
+// are then joined in order, starting at the position the sequential parse has
+// reached. A chunk that does not start there, or that ran past its end, is
+// dropped and its statements are parsed again, so the tree and the errors are
+// always those of `solc_parser_parse()'.
+solc_ast_t *solc_parser_parse_parallel(solc_parser_t *parser, sz threads_num)
+{
+  SOLC_ASSUME(parser != nullptr);
+
+  const sz tokens_num = parser->tokens_num - parser->pos;
+  if (threads_num <= 1 || tokens_num < 2 * PARALLEL_MIN_CHUNK_TOKENS)
+    return solc_parser_parse(parser);
+
+  const sz chunk_tokens = SOLC_MAX(
+    tokens_num / (threads_num * PARALLEL_CHUNKS_PER_THREAD),
+    (sz)PARALLEL_MIN_CHUNK_TOKENS);
+  parallel_queue_t queue = {
+    .chunks_v = parallel_split(parser, chunk_tokens),
+  };
+  const sz chunks_num = vector_get_length(queue.chunks_v);
+  if (chunks_num <= 1) {
+    vector_destroy(queue.chunks_v);
+    return solc_parser_parse(parser);
+  }
+
+  const char *previous_phase = mem_budget_enter_phase("parsing");
+  threads_num = SOLC_MIN(threads_num, chunks_num);
+  atomic_init(&queue.next_chunk, 0);
+
+  // This thread is the first worker, the others only help if they could be
+  // started.
+  parallel_worker_t *workers_v =
+    vector_reserve(parallel_worker_t, threads_num);
+  pthread_t *threads_v = vector_reserve(pthread_t, threads_num);
+  for (sz i = 0; i < threads_num; i++) {
+    parallel_worker_t worker = { &queue, solc_parser_fork(parser) };
+    vector_push(workers_v, worker);
+  }
+  for (sz i = 1; i < threads_num; i++) {
+    pthread_t thread;
+    if (pthread_create(&thread, nullptr, parallel_work, &workers_v[i]) != 0)
+      break;
+    vector_push(threads_v, thread);
+  }
+  parallel_work(&workers_v[0]);
+  for (sz i = 0; i < vector_get_length(threads_v); i++)
+    pthread_join(threads_v[i], nullptr);
+
+  solc_ast_t *root = solc_ast_root_create();
+  sz next_chunk = 0;
+  while (parser->pos < parser->tokens_num) {
+    while (next_chunk < chunks_num &&
+           queue.chunks_v[next_chunk].start < parser->pos)
+      parallel_chunk_drop(&queue.chunks_v[next_chunk++]);
+
+    parallel_chunk_t *chunk = next_chunk < chunks_num ?
+                                &queue.chunks_v[next_chunk] :
+                                nullptr;
+    if (chunk != nullptr && chunk->start == parser->pos &&
+        chunk->end_pos == chunk->end) {
+      parallel_chunk_take(parser, root, chunk);
+      next_chunk++;
+      continue;
+    }
+
+    solc_ast_t *top;
+    if (solc_parser_parse_next_top(parser, &top))
+      solc_ast_root_add_top_statement(root, top);
+  }
+  while (next_chunk < chunks_num)
+    parallel_chunk_drop(&queue.chunks_v[next_chunk++]);
+
+  for (sz i = 0; i < threads_num; i++)
+    solc_parser_destroy_fork(&workers_v[i].fork);
+  vector_destroy(threads_v);
+  vector_destroy(workers_v);
+  vector_destroy(queue.chunks_v);
+
+  mem_budget_leave_phase(previous_phase);
+  return root;
+}
+
+static parallel_chunk_t *parallel_split(const solc_parser_t *parser,
+                                        sz chunk_tokens)
+{
+  parallel_chunk_t *chunks_v = vector_create(parallel_chunk_t);
+  sz start = parser->pos;
+  for (sz pos = start; pos < parser->tokens_num;) {
+    pos = parallel_next_boundary(parser, pos);
+    if (pos - start < chunk_tokens && pos < parser->tokens_num)
+      continue;
+
+    parallel_chunk_t chunk = { .start = start, .end = pos };
+    vector_push(chunks_v, chunk);
+    start = pos;
+  }
+  return chunks_v;
+}
+
+// Where the top-level statement at `pos' seems to end: after the first `;'
+// outside of brackets, or after the first block unless a `;' follows it.
+static sz parallel_next_boundary(const solc_parser_t *parser, sz pos)
+{
+  while (pos < parser->tokens_num) {
+    const solc_tokentype_t type = parser->tokens[pos].type;
+    if (type == SOLC_TOKENTYPE_SEMI)
+      return pos + 1;
+    if (type != SOLC_TOKENTYPE_LPAREN && type != SOLC_TOKENTYPE_LBRACK &&
+        type != SOLC_TOKENTYPE_LCBRACK) {
+      pos++;
+      continue;
+    }
+
+    const sz closing_pos = solc_parser_matching_bracket(parser, pos);
+    if (closing_pos == 0)
+      return parser->tokens_num;
+    pos = closing_pos + 1;
+    if (type == SOLC_TOKENTYPE_LCBRACK)
+      return pos < parser->tokens_num &&
+                 parser->tokens[pos].type == SOLC_TOKENTYPE_SEMI ?
+               pos + 1 :
+               pos;
+  }
+  return parser->tokens_num;
+}
+
+static void *parallel_work(void *ctx)
+{
+  parallel_worker_t *worker = ctx;
+  solc_parser_t *fork = &worker->fork;
+  parallel_queue_t *queue = worker->queue;
+  const sz chunks_num = vector_get_length(queue->chunks_v);
+
+  for (;;) {
+    const sz i = atomic_fetch_add(&queue->next_chunk, 1);
+    if (i >= chunks_num)
+      return nullptr;
+
+    parallel_chunk_t *chunk = &queue->chunks_v[i];
+    chunk->tops_v = vector_create(solc_ast_t *);
+    chunk->fork = fork;
+    chunk->errors_begin = vector_get_length(fork->errors_v);
+    fork->pos = chunk->start;
+    while (fork->pos < chunk->end) {
+      solc_ast_t *top;
+      if (solc_parser_parse_next_top(fork, &top))
+        vector_push(chunk->tops_v, top);
+    }
+    chunk->end_pos = fork->pos;
+    chunk->errors_end = vector_get_length(fork->errors_v);
+  }
+}
+
+static void parallel_chunk_take(solc_parser_t *parser, solc_ast_t *root,
+                                parallel_chunk_t *chunk)
+{
+  for (sz i = 0; i < vector_get_length(chunk->tops_v); i++)
+    solc_ast_root_add_top_statement(root, chunk->tops_v[i]);
+  vector_extend(parser->errors_v, chunk->fork->errors_v + chunk->errors_begin,
+                chunk->errors_end - chunk->errors_begin);
+  parser->pos = chunk->end;
+  vector_destroy(chunk->tops_v);
+}
+
+static void parallel_chunk_drop(parallel_chunk_t *chunk)
+{
+  for (sz i = 0; i < vector_get_length(chunk->tops_v); i++)
+    solc_ast_destroy(chunk->tops_v[i]);
+  vector_destroy(chunk->tops_v);
+}
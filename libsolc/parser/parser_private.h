@@ -64,6 +64,15 @@
   }
 #endif
 
+// A parser of the same tokens with state of its own, it shares the bracket
+// index of `parser' and has to be destroyed before it.
+solc_parser_t solc_parser_fork(const solc_parser_t *parser);
+void solc_parser_destroy_fork(solc_parser_t *fork);
+
+// Parses the top-level statement at the position and starts over for the next
+// one. Returns false if it failed, its errors are reported then.
+b8 solc_parser_parse_next_top(solc_parser_t *parser, solc_ast_t **out);
+
 solc_ast_t *solc_parser_parse_top(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse_typedef(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse_type(solc_parser_t *parser);
@@ -121,6 +130,19 @@ solc_ast_t *solc_parser_parse_expr_operand_generic_call(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse_generic_namespace(solc_parser_t *parser);
 b8 solc_parser_is_expr_operand_generic_call(solc_parser_t *parser);
 b8 solc_parser_is_generic_namespace(solc_parser_t *parser);
+
+// Whether the `<' at `larrow_pos' opens a generic type list is decided once
+// per parse. A list that parsed is kept until the real parse takes it, the
+// rest are destroyed by `solc_parser_reset_speculations()'.
+typedef struct {
+  // Position after the closing `>', 0 if the tokens are no type list.
+  sz end_pos;
+  solc_ast_t *type_list;
+} parser_speculation_t;
+
+parser_speculation_t
+solc_parser_speculate_generic_type_list(solc_parser_t *parser, sz larrow_pos);
+void solc_parser_reset_speculations(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse_expr_operand_identifier(solc_parser_t *parser,
                                                       b8 accept_namespaces,
                                                       b8 accept_functions);
@@ -131,6 +153,24 @@ solc_ast_t *solc_parser_parse_attribute(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse_attribute_list(solc_parser_t *parser);
 solc_ast_t *solc_parser_parse_attribute_list_optional(solc_parser_t *parser);
 
+// Where a speculative parse started. Errors are only ever appended, so rolling
+// back truncates them to the length they had instead of copying them.
+typedef struct {
+  sz pos;
+  sz errors_num;
+  b8 errored;
+} parser_checkpoint_t;
+
+parser_checkpoint_t solc_parser_checkpoint(const solc_parser_t *parser);
+b8 solc_parser_failed_since(const solc_parser_t *parser,
+                            parser_checkpoint_t checkpoint);
+void solc_parser_rollback(solc_parser_t *parser,
+                          parser_checkpoint_t checkpoint);
+
+// The position of the token closing the bracket at `pos', 0 if there is none.
+// A `<' gets the `>' that would close it as a generic type list.
+sz solc_parser_matching_bracket(const solc_parser_t *parser, sz pos);
+
 void solc_parser_skip_until(solc_parser_t *parser, solc_tokentype_t token_type);
 void solc_parser_advance_to_terminator(solc_parser_t *parser);
 
@@ -149,7 +189,7 @@ const solc_token_t *solc_parser_peek_token(solc_parser_t *parser, sz pos);
 void solc_parser_add_error(solc_parser_t *parser, solc_parser_error_type_t type,
                            sz pos, sz len, solc_tokentype_t expected);
 
-b8 solc_parser_is_qualifier(const char *str);
+b8 solc_parser_is_qualifier(const char *str, sz len);
 
 b8 solc_parser_is_operator_token(solc_tokentype_t type);
 b8 solc_parser_is_binary_operator_token(solc_tokentype_t type);
@@ -1,4 +1,5 @@
 #include "types.h"
+#include "hash.h"
 #include <string.h>
 
 b8 key_compare_function_cstr(const void *key1, const void *key2)
@@ -7,6 +8,13 @@ b8 key_compare_function_cstr(const void *key1, const void *key2)
   return strcmp(key1, key2) == 0;
 }
 
+b8 key_compare_function_string_key(const void *key1, const void *key2)
+{
+  SOLC_ASSUME(key1 != nullptr && key2 != nullptr);
+  return string_key_equals(*(const string_key_t *)key1,
+                           *(const string_key_t *)key2);
+}
+
 sz get_size_function_cstr(const void *x)
 {
   SOLC_ASSUME(x != nullptr);
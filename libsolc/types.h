@@ -1,6 +1,7 @@
 #ifndef __SOLC_TYPES_H__
 #define __SOLC_TYPES_H__
 
+#include "hash.h"
 #include "solc/defs.h"
 
 typedef b8 (*compare_function_t)(const void *a, const void *b);
@@ -12,6 +13,7 @@ typedef enum {
 } size_policy_t;
 
 b8 key_compare_function_cstr(const void *key1, const void *key2);
+b8 key_compare_function_string_key(const void *key1, const void *key2);
 
 sz get_size_function_cstr(const void *x);
 
@@ -21,10 +23,11 @@ sz get_size_function_cstr(const void *x);
     const char *: get_size_function_cstr, \
     default: nullptr)
 
-#define get_default_key_compare_function(_key) \
-  _Generic((_key),                             \
-    char *: key_compare_function_cstr,         \
-    const char *: key_compare_function_cstr,   \
+#define get_default_key_compare_function(_key)     \
+  _Generic((_key),                                 \
+    char *: key_compare_function_cstr,             \
+    const char *: key_compare_function_cstr,       \
+    string_key_t: key_compare_function_string_key, \
     default: nullptr)
 
 #define get_default_size_policy(_X)     \
@@ -56,6 +56,17 @@ void error_handler_report_failed_to_open(const char *filepath, s32 errno_n)
           filepath, strerror(errno_n));
 }
 
+void error_handler_report_memory_budget_exceeded(const char *phase,
+                                                 sz resident, sz limit)
+{
+  fprintf(stderr,
+          ESCGRAPHICS_BOLD "solc: " ESCCOLOR_RED "fatal error: " ESC_RESET
+                           "out of memory while %s (%zu KiB resident, limit "
+                           "%zu KiB)\ncompilation terminated.\n",
+          phase, resident / 1024, limit / 1024);
+  exit(-5);
+}
+
 b8 error_handler_handle_invalid_tokens(error_handler_t *handler)
 {
   b8 result = true;
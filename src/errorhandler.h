@@ -21,6 +21,10 @@ error_handler_t error_handler_create(const char *filename, const char *src,
                                      solc_token_t *tokens, sz n);
 
 void error_handler_report_failed_to_open(const char *filepath, s32 errno_n);
+// Installed as the memory budget exceeded function, does not return.
+_Noreturn void error_handler_report_memory_budget_exceeded(const char *phase,
+                                                           sz resident,
+                                                           sz limit);
 b8 error_handler_handle_invalid_tokens(error_handler_t *handler);
 b8 error_handler_handle_parser_errors(error_handler_t *handler,
                                       solc_parser_error_t *errors, sz n);
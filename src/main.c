@@ -1,19 +1,29 @@
 #include <errno.h>
-#define ARGUMENTS                                                 \
-  BOOLEAN_ARG(show_help, "--help", "-h", "Display this message")  \
-  BOOLEAN_ARG(show_version, "--version", "-v", "Display version") \
-  PREFIX_ARG(link_against, "-l", "Link against", "lib")           \
-  VALUE_ARG(output, "--output", "-o", "Output", "file")
+#define ARGUMENTS                                                             \
+  BOOLEAN_ARG(show_help, "--help", "-h", "Display this message")              \
+  BOOLEAN_ARG(show_version, "--version", "-v", "Display version")             \
+  PREFIX_ARG(link_against, "-l", "Link against", "lib")                       \
+  VALUE_ARG(output, "--output", "-o", "Output", "file")                       \
+  VALUE_ARG(mem_stats, "--mem-stats", "-m", "Print memory statistics",        \
+            "table|json")                                                     \
+  VALUE_ARG(alloc_trace, "--alloc-trace", "-t", "Record allocations", "file") \
+  VALUE_ARG(max_memory, "--max-memory", "-M", "Limit resident memory",        \
+            "size[K|M|G]")                                                    \
+  VALUE_ARG(jobs, "--jobs", "-j", "Parse with this many threads", "n")
 
 #include "args.h"
 #include "errorhandler.h"
+#include <solc/alloc_trace.h>
 #include <solc/init.h>
+#include <solc/mem_budget.h>
+#include <solc/mem_stats.h>
 #include <solc/parser/parser.h>
 #include <solc/lexer/lexer.h>
 #include <solc/lexer/token.h>
 #include <solc/defs.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <solc/parser/ast.h>
 
 #define SOLC_VERSION "0.0.1"
@@ -30,6 +40,9 @@ static const char *_version_message =
                          "warranty; not even for MERCHANTABILITY"
                          " or FITNESS FOR A PARTICULAR PURPOSE.";
 
+static b8 parse_size(const char *str, sz *out);
+static b8 parse_jobs(const char *str, sz *out);
+
 s32 main(s32 argc, char **argv)
 {
   solc_init();
@@ -51,8 +64,55 @@ s32 main(s32 argc, char **argv)
     return -1;
   }
 
+  b8 print_mem_stats = args.mem_stats[0] != 0;
+  solc_mem_stats_format_t mem_stats_format = SOLC_MEM_STATS_FORMAT_TABLE;
+  if (print_mem_stats) {
+    if (strcmp(args.mem_stats, "json") == 0) {
+      mem_stats_format = SOLC_MEM_STATS_FORMAT_JSON;
+    } else if SOLC_UNLIKELY (strcmp(args.mem_stats, "table") != 0) {
+      fprintf(stderr, "Unknown memory statistics format \"%s\".\n",
+              args.mem_stats);
+      return -1;
+    }
+
+    if SOLC_UNLIKELY (!solc_mem_stats_enabled()) {
+      fprintf(stderr, "Memory statistics are not available, rebuild with "
+                      "`-Dmem_stats=true'.\n");
+      print_mem_stats = false;
+    }
+  }
+
+  if (args.alloc_trace[0] != 0) {
+    if SOLC_UNLIKELY (!solc_alloc_trace_enabled()) {
+      fprintf(stderr, "Allocation tracing is not available, rebuild with "
+                      "`-Dalloc_trace=true'.\n");
+    } else if SOLC_UNLIKELY (!solc_alloc_trace_open(args.alloc_trace)) {
+      fprintf(stderr, "Could not open \"%s\": %s\n", args.alloc_trace,
+              strerror(errno));
+      return -1;
+    }
+  }
+
+  if (args.max_memory[0] != 0) {
+    sz max_memory = 0;
+    if SOLC_UNLIKELY (!parse_size(args.max_memory, &max_memory)) {
+      fprintf(stderr, "Invalid memory limit \"%s\".\n", args.max_memory);
+      return -1;
+    }
+    solc_mem_budget_set_exceeded_func(
+      error_handler_report_memory_budget_exceeded);
+    solc_mem_budget_set_limit(max_memory);
+  }
+
+  sz jobs = 1;
+  if SOLC_UNLIKELY (args.jobs[0] != 0 && !parse_jobs(args.jobs, &jobs)) {
+    fprintf(stderr, "Invalid number of threads \"%s\".\n", args.jobs);
+    return -1;
+  }
+
   for (s32 i = 0; i < args.num_dangling; i++) {
     const char *filepath = argv[args.danlings[i]];
+    solc_mem_stats_begin_scope();
 
     FILE *f = fopen(filepath, "r");
     if SOLC_UNLIKELY (f == nullptr) {
@@ -85,7 +145,7 @@ s32 main(s32 argc, char **argv)
       return -3;
 
     solc_parser_t parser = solc_parser_create(tokens, tokens_num);
-    solc_ast_t *root = solc_parser_parse(&parser);
+    solc_ast_t *root = solc_parser_parse_parallel(&parser, jobs);
 
 #ifdef _DEBUG
     solc_ast_print(root);
@@ -105,9 +165,60 @@ s32 main(s32 argc, char **argv)
     solc_lexer_destroy(lexer);
 
     free(src);
+    solc_reset();
+
+    if (print_mem_stats)
+      solc_mem_stats_print(stderr, filepath, true, mem_stats_format);
   }
 
+  if (print_mem_stats)
+    solc_mem_stats_print(stderr, "all files", false, mem_stats_format);
+
+  solc_alloc_trace_close();
   solc_deinit();
 
   return 0;
 }
+
+static b8 parse_size(const char *str, sz *out)
+{
+  char *end = nullptr;
+  errno = 0;
+  const unsigned long long value = strtoull(str, &end, 10);
+  if (end == str || errno != 0)
+    return false;
+
+  sz shift = 0;
+  switch (*end) {
+  case 'G':
+  case 'g':
+    shift += 10;
+    /* fallthrough */
+  case 'M':
+  case 'm':
+    shift += 10;
+    /* fallthrough */
+  case 'K':
+  case 'k':
+    shift += 10;
+    end++;
+    break;
+  }
+  if (*end != 0 || value == 0 || value > (SIZE_MAX >> shift))
+    return false;
+
+  *out = (sz)value << shift;
+  return true;
+}
+
+static b8 parse_jobs(const char *str, sz *out)
+{
+  char *end = nullptr;
+  errno = 0;
+  const unsigned long value = strtoul(str, &end, 10);
+  if (end == str || *end != 0 || errno != 0 || value == 0)
+    return false;
+
+  *out = (sz)value;
+  return true;
+}
@@ -0,0 +1,57 @@
+#include "containers/hashset.h"
+#include "containers/hashtable.h"
+#include "hash.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(_cond)                                                     \
+  do {                                                                   \
+    if (!(_cond)) {                                                      \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+              #_cond);                                                   \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+static int failures;
+
+// `string_key_t' keys are only equal by their text, not by where it lives.
+static void test_string_keys(void)
+{
+  char a[] = "identifier";
+  char b[] = "identifier";
+  char c[] = "identifies";
+  const string_key_t key_a = string_key_from_cstr(a);
+  const string_key_t key_b = string_key_from_cstr(b);
+  const string_key_t key_c = string_key_from_cstr(c);
+
+  hashtable_t *table;
+  hashtable_create(table, string_key_t, u64);
+  const u64 value = 42;
+  hashtable_put(table, key_a, value);
+  const u64 *found = hashtable_get(table, key_b);
+  CHECK(found != nullptr && *found == value);
+  CHECK(hashtable_get(table, key_c) == nullptr);
+  hashtable_put(table, key_b, value);
+  CHECK(hashtable_get_size(table) == 1);
+  hashtable_remove(table, key_b);
+  CHECK(hashtable_get(table, key_a) == nullptr);
+  hashtable_destroy(table);
+
+  hashset_t *set;
+  hashset_create(set, string_key_t);
+  hashset_set(set, key_a);
+  CHECK(hashset_is_set(set, key_b));
+  CHECK(!hashset_is_set(set, key_c));
+  hashset_set(set, key_b);
+  CHECK(hashset_get_size(set) == 1);
+  hashset_unset(set, key_b);
+  CHECK(!hashset_is_set(set, key_a));
+  hashset_destroy(set);
+}
+
+int main(void)
+{
+  test_string_keys();
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
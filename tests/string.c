@@ -0,0 +1,51 @@
+#include "containers/string.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(_cond)                                                     \
+  do {                                                                   \
+    if (!(_cond)) {                                                      \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+              #_cond);                                                   \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+static int failures;
+
+// Appending a string to itself, inline as well as on the heap and whether
+// it has to grow or not.
+static void test_append_self(void)
+{
+  char text[64];
+  char doubled[128];
+  for (sz n = 0; n < sizeof(text); n++) {
+    for (sz i = 0; i < n; i++)
+      text[i] = (char)('a' + i % 26);
+    text[n] = 0;
+    snprintf(doubled, sizeof(doubled), "%s%s", text, text);
+
+    string_t str = string_create_from(text);
+    string_append(&str, &str);
+    CHECK(strcmp(string_cstr(&str), doubled) == 0);
+    string_destroy(&str);
+
+    str = string_create_from(text);
+    string_append_cstr(&str, string_cstr(&str));
+    CHECK(strcmp(string_cstr(&str), doubled) == 0);
+    string_destroy(&str);
+
+    str = string_create_from(text);
+    string_append_fmt(&str, "%s", string_cstr(&str));
+    CHECK(strcmp(string_cstr(&str), doubled) == 0);
+    CHECK(string_length(&str) == 2 * n);
+    string_destroy(&str);
+  }
+}
+
+int main(void)
+{
+  test_append_self();
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
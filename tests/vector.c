@@ -0,0 +1,36 @@
+#include "containers/vector.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(_cond)                                                     \
+  do {                                                                   \
+    if (!(_cond)) {                                                      \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+              #_cond);                                                   \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+static int failures;
+
+// Pushing and inserting elements of the vector itself, across growth.
+static void test_push_own_element(void)
+{
+  u64 *v = vector_reserve(u64, 1);
+  vector_push(v, 1);
+  for (sz i = 1; i < 100; i++)
+    vector_push(v, v[vector_get_length(v) - 1] + 1);
+  CHECK(vector_get_length(v) == 100);
+  for (sz i = 0; i < vector_get_length(v); i++)
+    CHECK(v[i] == i + 1);
+
+  vector_insert(v, 0, v[vector_get_length(v) - 1]);
+  CHECK(vector_get_length(v) == 101 && v[0] == 100 && v[1] == 1);
+  vector_destroy(v);
+}
+
+int main(void)
+{
+  test_push_own_element();
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
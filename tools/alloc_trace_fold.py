@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# Folds a log written by `solc --alloc-trace <file>' (libsolc built with
+# `-Dalloc_trace=true').
+#
+#   alloc_trace_fold.py trace.bin > trace.folded   # flamegraph.pl input
+#   alloc_trace_fold.py --totals trace.bin         # per AST type totals
+#
+# Stacks are `kind;subsystem;call site[;AST type] weight', the weight is the
+# number of bytes unless `--count' is given. Call sites are symbolized with
+# addr2line when it is available.
+
+import argparse
+import shutil
+import struct
+import subprocess
+import sys
+from collections import defaultdict
+
+MAGIC = b"SOLCATR\0"
+VERSION = 1
+RECORD = struct.Struct("<QIHBB")
+NO_AST_TYPE = 0xFFFF
+TERMINATOR_SIZE = 0xFFFFFFFF
+KINDS = ["heap", "arena"]
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, n):
+        if self.pos + n > len(self.data):
+            raise ValueError("truncated trace")
+        out = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return out
+
+    def unpack(self, fmt):
+        s = struct.Struct(fmt)
+        return s.unpack(self.take(s.size))
+
+    def name(self):
+        (n,) = self.unpack("<B")
+        return self.take(n).decode()
+
+
+def read_trace(path):
+    with open(path, "rb") as f:
+        r = Reader(f.read())
+
+    if r.take(len(MAGIC)) != MAGIC:
+        raise ValueError(f"{path}: not an allocation trace")
+    version, record_size = r.unpack("<II")
+    if version != VERSION or record_size != RECORD.size:
+        raise ValueError(f"{path}: unsupported trace version {version}")
+    (base,) = r.unpack("<Q")
+    (lib_len,) = r.unpack("<H")
+    lib = r.take(lib_len).decode()
+
+    records = []
+    while True:
+        record = RECORD.unpack(r.take(RECORD.size))
+        if record[1] == TERMINATOR_SIZE:
+            break
+        records.append(record)
+
+    (tags_num,) = r.unpack("<I")
+    tags = defaultdict(lambda: "[unknown]",
+                       {i: r.name() for i in range(tags_num)})
+    (ast_types_num,) = r.unpack("<I")
+    ast_types = {}
+    for _ in range(ast_types_num):
+        (ast_type,) = r.unpack("<H")
+        ast_types[ast_type] = r.name()
+
+    return base, lib, records, tags, ast_types
+
+
+def symbolize(sites, base, lib):
+    names = {0: "[unknown]"}
+    local = sorted(s for s in sites if s != 0 and s >= base)
+    for site in sites:
+        names.setdefault(site, hex(site))
+    if not local or not lib:
+        return names
+
+    # Return addresses point behind the call, step back into it.
+    offsets = [site - base - 1 for site in local]
+    for site, offset in zip(local, offsets):
+        names[site] = f"{lib.rsplit('/', 1)[-1]}+{offset:#x}"
+    if shutil.which("addr2line") is None:
+        return names
+
+    out = subprocess.run(["addr2line", "-f", "-e", lib],
+                         input="\n".join(hex(o) for o in offsets),
+                         capture_output=True, text=True)
+    lines = out.stdout.splitlines()
+    if out.returncode != 0 or len(lines) != 2 * len(local):
+        return names
+    for i, site in enumerate(local):
+        func = lines[2 * i]
+        if func != "??":
+            names[site] = func
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("trace")
+    parser.add_argument("--totals", action="store_true",
+                        help="print per AST type and subsystem totals")
+    parser.add_argument("--count", action="store_true",
+                        help="weigh stacks by allocations instead of bytes")
+    args = parser.parse_args()
+
+    try:
+        base, lib, records, tags, ast_types = read_trace(args.trace)
+    except (OSError, ValueError) as e:
+        print(e, file=sys.stderr)
+        return 1
+
+    if args.totals:
+        by_ast = defaultdict(lambda: [0, 0])
+        by_tag = defaultdict(lambda: [0, 0])
+        for _, size, ast_type, tag, kind in records:
+            if ast_type != NO_AST_TYPE:
+                by_ast[ast_types.get(ast_type, hex(ast_type))][0] += 1
+                by_ast[ast_types.get(ast_type, hex(ast_type))][1] += size
+            key = f"{KINDS[kind]}/{tags[tag]}"
+            by_tag[key][0] += 1
+            by_tag[key][1] += size
+
+        for title, table in (("AST type", by_ast), ("subsystem", by_tag)):
+            print(f"{title:<32} {'allocs':>12} {'bytes':>14}")
+            for name, (count, size) in sorted(table.items(),
+                                              key=lambda kv: -kv[1][1]):
+                print(f"{name:<32} {count:>12} {size:>14}")
+            print()
+        return 0
+
+    names = symbolize({r[0] for r in records}, base, lib)
+    stacks = defaultdict(int)
+    for site, size, ast_type, tag, kind in records:
+        frames = [KINDS[kind], tags[tag], names[site]]
+        if ast_type != NO_AST_TYPE:
+            frames.append(ast_types.get(ast_type, hex(ast_type)))
+        stacks[";".join(frames)] += 1 if args.count else size
+
+    for stack, weight in sorted(stacks.items()):
+        print(f"{stack} {weight}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# Turns declarative string tables into perfect hash lookups, run by meson.
+#
+#   gen_perfect_hash.py parser_keywords.txt parser_keywords.h
+#
+# The input holds `include <header>' lines and tables:
+#
+#   table <name> <value type> <value when missing>
+#     <key> <value>
+#     ...
+#
+# Every table becomes `<name>(const char *str, sz len)', a minimal perfect hash
+# over the first byte, the last byte and the length of a key:
+#
+#   key    = str[0] | str[len - 1] << 8 | len << 16
+#   bucket = ((u32)(key * a) >> 16) % n
+#   slot   = (((u32)(key * b) >> 16) + displacement[bucket]) % n
+#
+# `n' is the number of keys. The multipliers and the per bucket displacements
+# are searched here so every key gets a slot of its own, a lookup is then two
+# multiplications, a length check and one `memcmp()'.
+
+import argparse
+import os
+import random
+import sys
+
+ATTEMPTS = 10000
+
+
+class Table:
+    def __init__(self, name, value_type, missing):
+        self.name = name
+        self.value_type = value_type
+        self.missing = missing
+        self.entries = []
+
+
+def parse(path):
+    includes = []
+    tables = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+
+            if fields[0] == "include" and len(fields) == 2:
+                includes.append(fields[1])
+            elif fields[0] == "table" and len(fields) == 4:
+                tables.append(Table(*fields[1:]))
+            elif len(fields) == 2 and tables and line[0].isspace():
+                tables[-1].entries.append((fields[0], fields[1]))
+            else:
+                sys.exit(f"{path}:{number}: cannot parse `{line.strip()}'")
+
+    for table in tables:
+        keys = [key for key, _ in table.entries]
+        if not keys:
+            sys.exit(f"{path}: table `{table.name}' is empty")
+        if len(set(keys)) != len(keys):
+            sys.exit(f"{path}: table `{table.name}' has duplicate keys")
+        if max(len(key.encode()) for key in keys) > 0xFF:
+            sys.exit(f"{path}: table `{table.name}' has keys over 255 bytes")
+    return includes, tables
+
+
+def pack(key):
+    data = key.encode()
+    return data[0] | data[-1] << 8 | len(data) << 16
+
+
+def mix(packed, multiplier):
+    return (packed * multiplier & 0xFFFFFFFF) >> 16
+
+
+def find_hash(keys):
+    n = len(keys)
+    if len({pack(key) for key in keys}) != n:
+        sys.exit(f"keys share their first byte, last byte and length: {keys}")
+
+    # Seeded, so the same input always generates the same table.
+    rng = random.Random(0)
+    for _ in range(ATTEMPTS):
+        bucket_multiplier = rng.randrange(1 << 32) | 1
+        slot_multiplier = rng.randrange(1 << 32) | 1
+
+        buckets = [[] for _ in range(n)]
+        for key in keys:
+            buckets[mix(pack(key), bucket_multiplier) % n].append(key)
+
+        # Fullest buckets first, while most slots are still free.
+        displacements = [0] * n
+        taken = set()
+        for bucket in sorted(range(n), key=lambda i: -len(buckets[i])):
+            if not buckets[bucket]:
+                break
+            for displacement in range(n):
+                slots = {(mix(pack(key), slot_multiplier) + displacement) % n
+                         for key in buckets[bucket]}
+                if len(slots) == len(buckets[bucket]) and not slots & taken:
+                    displacements[bucket] = displacement
+                    taken |= slots
+                    break
+            else:
+                break
+
+        if len(taken) == n:
+            return bucket_multiplier, slot_multiplier, displacements
+    sys.exit(f"no perfect hash for {keys}")
+
+
+def displacement_type(n):
+    # Displacements are below `n', the smallest type holding them keeps the
+    # array small for the keyword sized tables.
+    for bits in (8, 16, 32):
+        if n <= 1 << bits:
+            return f"u{bits}"
+    sys.exit(f"tables of {n} keys are too large")
+
+
+def emit_table(out, table):
+    keys = [key for key, _ in table.entries]
+    bucket_multiplier, slot_multiplier, displacements = find_hash(keys)
+    n = len(keys)
+    slots = [None] * n
+    for key, value in table.entries:
+        bucket = mix(pack(key), bucket_multiplier) % n
+        slot = (mix(pack(key), slot_multiplier) + displacements[bucket]) % n
+        slots[slot] = (key, value)
+
+    lengths = [len(key.encode()) for key in keys]
+    out.append(f"static inline {table.value_type}")
+    out.append(f"{table.name}(const char *str, sz len)")
+    out.append("{")
+    out.append(f"  static const {displacement_type(n)} displacements[{n}] = {{")
+    out.append("    " + ", ".join(map(str, displacements)))
+    out.append("  };")
+    out.append("  static const struct {")
+    out.append("    const char *key;")
+    out.append("    sz len;")
+    out.append(f"    {table.value_type} value;")
+    out.append(f"  }} entries[{n}] = {{")
+    for key, value in slots:
+        out.append(f"    {{ \"{key}\", {len(key.encode())}, {value} }},")
+    out.append("  };")
+    out.append("")
+    out.append(f"  if (len < {min(lengths)} || len > {max(lengths)})")
+    out.append(f"    return {table.missing};")
+    out.append("  const u32 key =")
+    out.append("    (u32)(u8)str[0] | (u32)(u8)str[len - 1] << 8 |"
+               " (u32)len << 16;")
+    out.append(f"  const u32 bucket = (key * {bucket_multiplier:#010x}U >> 16)"
+               f" % {n};")
+    out.append(f"  const u32 slot = ((key * {slot_multiplier:#010x}U >> 16) +")
+    out.append(f"                    displacements[bucket]) % {n};")
+    out.append("  if (entries[slot].len != len ||")
+    out.append("      memcmp(entries[slot].key, str, len) != 0)")
+    out.append(f"    return {table.missing};")
+    out.append("  return entries[slot].value;")
+    out.append("}")
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("input")
+    parser.add_argument("output")
+    args = parser.parse_args()
+
+    includes, tables = parse(args.input)
+    guard = "__SOLC_" + os.path.basename(args.output).upper().replace(
+        ".", "_") + "__"
+
+    out = [f"// Generated by `gen_perfect_hash.py' from "
+           f"`{os.path.basename(args.input)}', do not edit.",
+           f"#ifndef {guard}", f"#define {guard}", ""]
+    out += [f"#include \"{include}\"" for include in includes]
+    out += ["#include <string.h>"]
+    for table in tables:
+        out.append("")
+        emit_table(out, table)
+    out += ["", f"#endif // {guard}"]
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()